@@ -0,0 +1,88 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "openvino/genai/tokenizer.hpp"
+#include "openvino/genai/visibility.hpp"
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Describes new tokens of a single sequence within StreamingChunk.
+ */
+struct StreamedSequence {
+    uint64_t request_id;
+    // sequence id within the request, the same as the key of GenerationOutputs
+    uint64_t sequence_id;
+    // span of the sequence's new tokens in StreamingChunk::tokens
+    size_t offset;
+    size_t length;
+    // no more tokens will be streamed for this sequence
+    bool finished;
+};
+
+/**
+ * @brief New tokens of all requests produced by a single ContinuousBatchingPipeline::step().
+ *
+ * Greedy and multinomial sequences (including num_return_sequences > 1) are streamed token by token.
+ * Beam search sequences and sequences with stop strings excluded from the output are streamed at once
+ * when their request finishes, as only then their tokens are final.
+ */
+struct StreamingChunk {
+    std::vector<int64_t> tokens;
+    std::vector<StreamedSequence> sequences;
+};
+
+/**
+ * @brief base class for streamers receiving tokens of all requests at once. In order to use inherit from this class
+ * and pass an instance to ContinuousBatchingPipeline::set_batched_streamer
+ */
+class OPENVINO_GENAI_EXPORTS BatchedStreamerBase {
+public:
+    /// @brief put is called once per step with new tokens of all requests
+    /// @return bool flag to indicate whether generation should be stopped, if return true all running requests are dropped
+    virtual bool put(const StreamingChunk& chunk) = 0;
+
+    virtual ~BatchedStreamerBase();
+};
+
+/**
+ * @brief Text of a sequence decoded since the previous step.
+ */
+struct StreamedText {
+    uint64_t request_id;
+    uint64_t sequence_id;
+    std::string text;
+    bool finished;
+};
+
+/**
+ * @brief Batched streamer which detokenizes new tokens of all sequences with a single Tokenizer::decode call per step.
+ */
+class OPENVINO_GENAI_EXPORTS BatchedTextStreamer : public BatchedStreamerBase {
+public:
+    BatchedTextStreamer(const Tokenizer& tokenizer, std::function<bool(const std::vector<StreamedText>&)> callback);
+
+    bool put(const StreamingChunk& chunk) override;
+
+private:
+    struct SequenceState {
+        std::vector<int64_t> tokens_cache;
+        size_t print_len = 0;
+    };
+
+    Tokenizer m_tokenizer;
+    std::function<bool(const std::vector<StreamedText>&)> m_callback;
+    // (request_id, sequence_id) -> detokenization state
+    std::map<std::pair<uint64_t, uint64_t>, SequenceState> m_states;
+};
+
+}  // namespace genai
+}  // namespace ov
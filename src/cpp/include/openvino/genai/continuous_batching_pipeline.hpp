@@ -14,6 +14,7 @@
 #include "openvino/genai/generation_handle.hpp"
 #include "openvino/genai/llm_pipeline.hpp"
 #include "openvino/genai/streamer_base.hpp"
+#include "openvino/genai/batched_streamer.hpp"
 #include "openvino/genai/visibility.hpp"
 #include "cache_eviction.hpp"
 
@@ -48,6 +49,16 @@ struct PipelineMetrics {
     * Running average of the KV cache usage during the lifetime of the pipeline, with max window size of 1000 steps
     */
     float avg_cache_usage = 0.0;
+
+    /**
+    * Hit rate of the tokenization cache for prompts added as strings, see ov::genai::tokenization_cache_size
+    */
+    float tokenization_cache_hit_rate = 0.0;
+
+    /**
+    * Estimated time in ms saved by the tokenization cache during the lifetime of the pipeline
+    */
+    float tokenization_time_saved = 0.0;
 };
 
 class OPENVINO_GENAI_EXPORTS ContinuousBatchingPipeline {
@@ -56,9 +67,13 @@ protected:
     class ContinuousBatchingImpl;
     class ContinuousBatchingForSpeculativeDecodingImpl;
     class SpeculativeDecodingImpl;
+    class ContinuousBatchingForPromptLookupImpl;
+    class PromptLookupImpl;
 
     friend class ContinuousBatchingForSpeculativeDecodingImpl;
     friend class SpeculativeDecodingImpl;
+    friend class ContinuousBatchingForPromptLookupImpl;
+    friend class PromptLookupImpl;
 
     std::shared_ptr<ImplInterface> m_impl;
 
@@ -103,6 +118,14 @@ public:
 
     void step();
 
+    /**
+    * @brief Sets a streamer which receives new tokens of all requests once per step().
+    * It is used both by step() driven generation and by generate(); pass nullptr to disable it.
+    * It can be replaced while step() is running in another thread, the new streamer is used from the next step.
+    * @param streamer batched streamer, e.g. ov::genai::BatchedTextStreamer
+    */
+    void set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer);
+
     bool has_non_finished_requests();
 
     // more high level interface, which can process multiple prompts in continuous batching manner
@@ -119,5 +142,37 @@ public:
     * @brief finish chat and clear kv cache.
     */
     void finish_chat();
+
+    /**
+    * @brief Opens a chat session. Unlike start_chat(), KV cache blocks of the conversation are kept in the pipeline
+    * between turns, so only tokens of a new turn are processed, and several sessions can be served concurrently.
+    * Blocks of idle sessions are released after SchedulerConfig::session_idle_timeout or when other sequences need them.
+    * @param system_message optional system message.
+    * @return ID of the session.
+    */
+    uint64_t open_chat_session(const std::string& system_message = {});
+
+    /**
+    * @brief Adds the next user turn of a chat session as a request. The previous turn of the session must be finished.
+    * The generated answer is added to the session history once the request is finished.
+    * @param request_id ID of the request.
+    * @param session_id ID of the session returned by open_chat_session().
+    * @param message user message.
+    * @param sampling_params generation config of the request.
+    */
+    GenerationHandle add_session_request(uint64_t request_id, uint64_t session_id, const std::string& message, const ov::genai::GenerationConfig& sampling_params);
+
+    /**
+    * @brief Closes a chat session and releases its KV cache blocks.
+    * @param session_id ID of the session returned by open_chat_session().
+    */
+    void close_chat_session(uint64_t session_id);
 };
+
+/**
+* @brief async_detokenization property makes ContinuousBatchingPipeline::generate() detokenize streamed tokens on a worker
+* thread while the next step is running. The streamer callback gets the text of a token by the next step, so
+* generation is stopped one token later after the callback returns true. Disabled by default.
+*/
+static constexpr ov::Property<bool> async_detokenization{"async_detokenization"};
 }
@@ -25,6 +25,21 @@ namespace genai {
  */
 enum class StopCriteria { EARLY, HEURISTIC, NEVER };
 
+/**
+ * @brief Constrains generated text to a formal specification, exactly one of the following has to be set:
+ * @param json_schema JSON schema the generated JSON value has to satisfy.
+ * @param regex regular expression the whole generated text has to match.
+ * @param grammar EBNF grammar with the "root" rule the whole generated text has to match. Rules are inlined,
+ *        so the grammar has to be regular, i.e. without recursion.
+ *
+ * Generation stops with an EOS token only when the text is complete according to the specification.
+ */
+struct StructuredOutputConfig {
+    std::optional<std::string> json_schema;
+    std::optional<std::string> regex;
+    std::optional<std::string> grammar;
+};
+
 /**
  * @brief Structure to keep generation config parameters. For a selected method of decoding, only parameters from that group
  * and generic parameters are used. For example, if do_sample is set to true, then only generic parameters and random sampling parameters will
@@ -44,6 +59,7 @@ enum class StopCriteria { EARLY, HEURISTIC, NEVER };
  * @param echo if set to true, output will include user prompt (default: false).
  * @param logprobs number of top logprobs computed for each position, if set to 0, logprobs are not computed and value 0.0 is returned.
  *                 Currently only single top logprob can be returned, so any logprobs > 1 is treated as logprobs == 1. (default: 0).
+ * @param structured_output_config if set, generated text is constrained to a JSON schema, regex or grammar. Not supported for beam search.
  *
  * Beam search specific parameters:
  * @param num_beams number of beams for beam search. 1 disables beam search.
@@ -74,6 +90,11 @@ enum class StopCriteria { EARLY, HEURISTIC, NEVER };
  * Speculative decoding parameters:
  * @param assistant_confidence_threshold the lower token probability of candidate to be validated by main model in case of static strategy candidates number update.
  * @param num_assistant_tokens the defined candidates number to be generated by draft model in case of dynamic strategy candidates number update.
+ * @param dynamic_num_assistant_tokens tunes the candidates number of the request after every validation starting from num_assistant_tokens,
+ *        so the expected number of accepted tokens per unit of time is maximal. Measured acceptance rate and draft and main models step durations are used.
+ * @param max_ngram_size the maximum n-gram size matched against prompt and generated tokens to propose candidates in case of prompt lookup decoding.
+ * @param max_candidate_branches the maximum number of alternative candidate sequences validated together in one step in case of prompt lookup decoding.
+ *        Only the branch with the most accepted tokens is kept.
  */
 
 class OPENVINO_GENAI_EXPORTS GenerationConfig {
@@ -117,12 +138,17 @@ public:
     // Speculative decoding
     float assistant_confidence_threshold = 0.f;
     size_t num_assistant_tokens = 0;
+    bool dynamic_num_assistant_tokens = false;
+    size_t max_ngram_size = 0;
+    size_t max_candidate_branches = 1;
 
     // EOS special token
     int64_t eos_token_id = -1;
 
     std::optional<AdapterConfig> adapters;
 
+    std::optional<StructuredOutputConfig> structured_output_config;
+
     /** @brief sets eos_token_id to tokenizer_eos_token_id if eos_token_id is less than 0.
      * Otherwise verifies eos_token_id == tokenizer_eos_token_id.
      */
@@ -133,6 +159,7 @@ public:
     bool is_beam_search() const;
     bool is_multinomial() const;
     bool is_speculative_decoding() const;
+    bool is_prompt_lookup() const;
     void update_generation_config(const ov::AnyMap& config_map);
 
     template <typename... Properties>
@@ -178,6 +205,11 @@ static constexpr ov::Property<size_t> rng_seed{"rng_seed"};
 
 static constexpr ov::Property<float> assistant_confidence_threshold{"assistant_confidence_threshold"};
 static constexpr ov::Property<size_t> num_assistant_tokens{"num_assistant_tokens"};
+static constexpr ov::Property<bool> dynamic_num_assistant_tokens{"dynamic_num_assistant_tokens"};
+static constexpr ov::Property<size_t> max_ngram_size{"max_ngram_size"};
+static constexpr ov::Property<size_t> max_candidate_branches{"max_candidate_branches"};
+
+static constexpr ov::Property<StructuredOutputConfig> structured_output_config{"structured_output_config"};
 
 // Predefined Configs
 OPENVINO_GENAI_EXPORTS GenerationConfig beam_search();
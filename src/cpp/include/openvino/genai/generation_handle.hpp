@@ -14,7 +14,7 @@ enum class GenerationStatus {
     RUNNING = 0, // Default status for ongoing generation
     FINISHED = 1, // Status set when generation has been finished
     IGNORED = 2, // Status set when generation run into out-of-memory condition and could not be continued
-    DROPPED_BY_PIPELINE = 3, // Currently not used, TODO: implement abort functionality
+    DROPPED_BY_PIPELINE = 3, // Status set when generation is stopped by the pipeline, e.g. by a batched streamer
     DROPPED_BY_HANDLE = 4 // Status set when generation handle is dropped
 };
 
@@ -86,6 +86,7 @@ public:
 
     void drop();
 
+    // Reading methods can be called from different threads, the calls are serialized, so every output is read once
     GenerationOutputs back();
     // Reads result of a generation for single iteration
     GenerationOutputs read();
@@ -7,6 +7,7 @@
 #include <variant>
 #include <chrono>
 #include <filesystem>
+#include <iostream>
 
 #include "openvino/core/any.hpp"
 #include "openvino/genai/generation_config.hpp"
@@ -267,6 +268,23 @@ public:
     * Turns off keeping KV cache between generate calls.
     */
     void finish_chat();
+
+    /**
+    * @brief saves KV cache and history of the current chat, so the chat can be resumed by load_chat_state
+    * without processing the history again, including in another process with the same model and device.
+    *
+    * @param stream binary output stream
+    */
+    void save_chat_state(std::ostream& stream);
+    void save_chat_state(const std::filesystem::path& path);
+
+    /**
+    * @brief restores KV cache and history of a chat saved by save_chat_state and continues the chat.
+    *
+    * @param stream binary input stream
+    */
+    void load_chat_state(std::istream& stream);
+    void load_chat_state(const std::filesystem::path& path);
 private:
     std::unique_ptr<LLMPipelineImplBase> m_pimpl;
 };
@@ -303,5 +321,50 @@ inline std::pair<std::string, Any> draft_model(
 */
 static constexpr ov::Property<SchedulerConfig> scheduler_config{"scheduler_config"};
 
+/**
+* @brief prompt_lookup property enables prompt lookup decoding in continuous batching pipeline:
+* candidates are copied from prompt and generated tokens instead of being generated by a draft model.
+* Requests have to set GenerationConfig::max_ngram_size and GenerationConfig::num_assistant_tokens.
+*/
+static constexpr ov::Property<bool> prompt_lookup{"prompt_lookup"};
+
+/**
+* @brief pipelined_speculative_decoding property enables overlapping of draft and main models in speculative decoding:
+* requests are split into two halves, and the draft model generates candidates for one half while the main model
+* validates candidates of the other half. Use ov::inference_num_threads in properties of the main and draft models
+* to split CPU cores between them.
+*/
+static constexpr ov::Property<bool> pipelined_speculative_decoding{"pipelined_speculative_decoding"};
+
+/**
+* @brief early_exit_draft_layers property enables self-speculative decoding in continuous batching pipeline:
+* the draft model is built from the first N decoder layers of the main model followed by its final norm and LM head,
+* so no separate draft model is loaded and weights are shared between the models.
+*/
+static constexpr ov::Property<size_t> early_exit_draft_layers{"early_exit_draft_layers"};
+
+/**
+* @brief max_chat_history_tokens property enables chat history compaction in the stateful LLM pipeline:
+* when KV cache together with a new prompt exceeds the limit, the oldest chat turns are evicted from KV cache.
+* The system prompt and the first attention_sink_tokens tokens are always kept. 0 (default) disables the compaction.
+* Tokens generated for the current prompt are not evicted, so KV cache can exceed the limit by max_new_tokens.
+* Keys of the kept tokens are re-rotated to their positions in the compacted KV cache, so position ids don't grow beyond
+* the limit. It requires rotary position embeddings described by rope_theta in config.json, other models are rejected.
+*/
+static constexpr ov::Property<size_t> max_chat_history_tokens{"max_chat_history_tokens"};
+
+/**
+* @brief attention_sink_tokens property sets the number of the first tokens which are never evicted from KV cache
+* by chat history compaction, because attention scores concentrate on them. The default value is 4.
+*/
+static constexpr ov::Property<size_t> attention_sink_tokens{"attention_sink_tokens"};
+
+/**
+* @brief max_padding_ratio property enables length bucketing of batched prompts in the stateful LLM pipeline:
+* prompts are sorted by length and split into buckets generated one after another, so padding tokens don't exceed
+* the given ratio of tokens in a bucket. 1.0 (default) disables the bucketing. Streaming disables it as well.
+*/
+static constexpr ov::Property<float> max_padding_ratio{"max_padding_ratio"};
+
 }  // namespace genai
 }  // namespace ov
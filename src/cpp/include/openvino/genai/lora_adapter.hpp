@@ -50,7 +50,8 @@ struct OPENVINO_GENAI_EXPORTS AdapterConfig {
         MODE_DYNAMIC,       // A, B, alpha are fully variable
         MODE_STATIC_RANK,   // A and B have static shape, alpha is variable // FIXME: WA to unlock experiments, gives a unique perf level
         MODE_STATIC,        // A, B and alpha are constants
-        MODE_FUSE           // A, B and alpha are constants, fused to main matrix W
+        MODE_FUSE,          // A, B and alpha are constants, fused to main matrix W
+        MODE_DYNAMIC_PER_TOKEN  // A, B are fully variable, alpha is selected per token to apply different adapters to requests in one batch
     };
 
     Mode get_mode() const { return mode; }
@@ -66,6 +67,13 @@ struct OPENVINO_GENAI_EXPORTS AdapterConfig {
     const std::optional<std::string>& get_tensor_name_prefix() const { return tensor_name_prefix; }
     void set_tensor_name_prefix(const std::optional<std::string>& _tensor_name_prefix) { tensor_name_prefix = _tensor_name_prefix; }
 
+    // Methods to get and set memory budget in bytes for LoRA state tensors prepared by AdapterController in dynamic modes.
+    // Tensors prepared for recently applied sets of adapters and alphas are kept to switch back to them without preparing them again,
+    // least recently used sets are evicted when the budget is exceeded. Tensors of the last applied set are always kept.
+    // Caching is opt-in: nullopt (the default) and 0 keep tensors of the last applied set only.
+    const std::optional<size_t>& get_cache_size() const { return cache_size; }
+    void set_cache_size(const std::optional<size_t>& _cache_size) { cache_size = _cache_size; }
+
     AdapterConfig (Mode mode = MODE_AUTO);
 
     AdapterConfig (const Adapter& adapter, float alpha, Mode mode = MODE_AUTO) : AdapterConfig(std::vector<std::pair<Adapter, float>>{{adapter, alpha}}, mode) {}
@@ -88,7 +96,7 @@ struct OPENVINO_GENAI_EXPORTS AdapterConfig {
     AdapterConfig& remove(const Adapter&);
     const std::vector<Adapter>& get_adapters() const { return adapters; }
 
-    // Update adapters and alphas from other config. Mode and tensor_name_prefix are updated if they are set not to default values in other config.
+    // Update adapters and alphas from other config. Mode, tensor_name_prefix and cache_size are updated if they are set not to default values in other config.
     // It means that if other.get_mode() == MODE_AUTO, it will not override value in this config. If tensor_name_prefix is not set (== nullopt) then it won't be updated either.
     void update (const AdapterConfig& other);
 
@@ -103,6 +111,7 @@ private:
     std::vector<Adapter> adapters;
     std::vector<float> alphas;
     std::optional<std::string> tensor_name_prefix;
+    std::optional<size_t> cache_size;
 
 };
 
@@ -190,6 +199,10 @@ public:
     // Apply adapters configured in the current config set last time, or set and use new config given as optional `config` argument
     void apply(ov::InferRequest& request, const std::optional<AdapterConfig>& config = std::nullopt);
 
+    // Apply different adapter configs to tokens of a batch in a single inference, requires AdapterConfig::MODE_DYNAMIC_PER_TOKEN.
+    // `token_config_ids` is i32 tensor of the number of tokens in a batch that holds an index in `configs` for every token.
+    void apply(ov::InferRequest& request, const std::vector<AdapterConfig>& configs, const ov::Tensor& token_config_ids);
+
     // Returns true if a given name is one of the state names created by this adapter controller for dynamic LoRA
     // Helps to distinguish LoRA states from other states (e.g. KV cache state) in the model for a partial state reset.
     bool has_state_name(const std::string& name);
@@ -51,11 +51,17 @@ struct SchedulerConfig {
     // when a sequence has finished genegartion its cache is released.
     bool enable_prefix_caching = false;
 
+    // Chat sessions of ContinuousBatchingPipeline keep KV cache blocks of the conversation between turns.
+    // Blocks of a session which was idle for this number of seconds are released. 0 means blocks are kept
+    // until they are required by other sequences, which release the least recently used sessions first.
+    std::size_t session_idle_timeout = 0;
+
     bool operator==(const SchedulerConfig& other) const {
         return max_num_batched_tokens == other.max_num_batched_tokens && num_kv_blocks == other.num_kv_blocks &&
                cache_size == other.cache_size &&
                dynamic_split_fuse == other.dynamic_split_fuse && use_cache_eviction == other.use_cache_eviction &&
-               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching;
+               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching &&
+               session_idle_timeout == other.session_idle_timeout;
     }
 };
 }
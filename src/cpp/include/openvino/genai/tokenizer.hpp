@@ -22,6 +22,29 @@ struct TokenizedInputs {
     ov::Tensor attention_mask;
 };
 
+/**
+* @brief Token ids of prompts encoded by Tokenizer::encode_bulk without padding and throughput of the encoding.
+*/
+struct BulkTokenizedInputs {
+    std::vector<std::vector<int64_t>> input_ids;  // input_ids[i] are token ids of the i-th prompt
+    size_t num_tokens = 0;
+    float tokens_per_second = 0.0f;
+};
+
+/**
+* @brief Statistics of the tokenization cache enabled by ov::genai::tokenization_cache_size.
+*/
+struct TokenizationCacheMetrics {
+    size_t hits = 0;
+    size_t misses = 0;
+    // Estimated as the mean duration of tokenization on misses multiplied by the number of hits
+    float time_saved_ms = 0.0f;
+
+    float get_hit_rate() const {
+        return hits + misses > 0 ? static_cast<float>(hits) / (hits + misses) : 0.0f;
+    }
+};
+
 /**
 * @brief class is used to encode prompts and decode resulting tokens
 */
@@ -29,6 +52,10 @@ class OPENVINO_GENAI_EXPORTS Tokenizer {
 public:
     /**
     * @brief ov::genai::Tokenizer constructor.
+    * If a tokenizer loaded from the same path with the same properties is still alive, its compiled models and infer requests
+    * are reused. The chat template, the add_special_tokens/skip_special_tokens defaults and the tokenization cache are
+    * not shared, unlike between copies of a Tokenizer.
+    * Pass ov::cache_dir to cache compiled tokenizer models on disk.
     * @param tokenizer_path openvino_tokenizer.xml and openvino_detokenizer.xml should be located in the tokenizer_path
     * @param properties Properties passed to ov::Core::compile_model
     */
@@ -62,6 +89,18 @@ public:
     TokenizedInputs encode(std::vector<std::string>&& prompts, const ov::AnyMap& tokenization_params = {});
     TokenizedInputs encode(std::initializer_list<std::string>& prompts, const ov::AnyMap& tokenization_params = {});
 
+    /**
+    * @brief encode a large number of prompts, e.g. a dataset for benchmarking or offline processing.
+    * Prompts are sorted by length and split into batches of similar length which are tokenized by parallel infer requests.
+    * The number of parallel requests is ov::optimal_number_of_infer_requests of the tokenizer model compiled with properties
+    * passed to the constructor, e.g. ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT) increases it.
+    * @param prompts vector storing prompts
+    * @param batch_size max number of prompts tokenized by one infer request at once
+    * @param tokenization_params AnyMap with tokenization parameters, e.g. {"add_special_tokens", false}
+    * @return token ids of every prompt in the original order without padding, and the number of tokens per second
+    */
+    BulkTokenizedInputs encode_bulk(const std::vector<std::string>& prompts, size_t batch_size = 64, const ov::AnyMap& tokenization_params = {});
+
     /**
     * @brief encode a single prompt
     * @param prompt std::string with input prompt
@@ -161,6 +200,21 @@ public:
     /// @param chat_template The new template to override with.
     void set_chat_template(const std::string& chat_template);
 
+    /**
+     * @brief Returns bytes which each token contributes to a decoded text, e.g. to map text-level constraints to tokens.
+     * Special tokens and tokens which cannot be represented are empty.
+     * @param at_text_start whether to return bytes of tokens at the beginning of a text, which may differ,
+     *        e.g. SentencePiece-based tokenizers strip the leading space.
+     * @return A vector indexed by token id.
+     * @throws Exception if the detokenizer model doesn't allow to read token bytes.
+     */
+    std::vector<std::string> get_decoded_vocab(bool at_text_start = false) const;
+
+    /**
+     * @brief Returns statistics of the tokenization cache, all values are zero if the cache is disabled.
+     */
+    TokenizationCacheMetrics get_cache_metrics() const;
+
     // information about <bos>, <eos> tokens should be public,
     // they are used at least in StreamerBase descendants
     int64_t get_bos_token_id() const;
@@ -181,5 +235,12 @@ private:
 static constexpr ov::Property<bool> add_special_tokens{"add_special_tokens"};
 static constexpr ov::Property<bool> skip_special_tokens{"skip_special_tokens"};
 
+/**
+ * @brief Max number of prompts whose tokenization results are kept by Tokenizer in a LRU cache,
+ * so identical prompts (e.g. system prompts or few-shot blocks) are encoded once. Only single prompts are cached.
+ * It's passed to the Tokenizer constructor, 0 (default) disables the cache.
+ */
+static constexpr ov::Property<size_t> tokenization_cache_size{"tokenization_cache_size"};
+
 }  // namespace genai
 }  // namespace ov
@@ -169,6 +169,20 @@ public:
     }
     WhisperDecodedResults generate(const RawSpeechInput& raw_speech_input, const ov::AnyMap& config_map);
 
+    /**
+     * @brief Transcribes multiple short-form audio inputs (< 30 seconds each) at once. The encoder processes all inputs
+     * in one batch and each decoding step generates the next token of all of them in one batched inference,
+     * which gives higher throughput than sequential generate() calls for many concurrent inputs.
+     * Streaming is not supported.
+     *
+     * @param raw_speech_inputs raw speech inputs. Required to be normalized to near [-1, 1] range and have 16k Hz
+     * sampling rate.
+     * @param generation_config optional GenerationConfig applied to all inputs
+     * @return WhisperDecodedResults decoded resulting text transcription of each input
+     */
+    std::vector<WhisperDecodedResults> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                OptionalWhisperGenerationConfig generation_config = std::nullopt);
+
     ov::genai::Tokenizer get_tokenizer();
     WhisperGenerationConfig get_generation_config() const;
     void set_generation_config(const WhisperGenerationConfig& config);
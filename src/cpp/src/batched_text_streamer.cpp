@@ -0,0 +1,75 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "openvino/genai/batched_streamer.hpp"
+
+namespace ov {
+namespace genai {
+
+BatchedTextStreamer::BatchedTextStreamer(const Tokenizer& tokenizer, std::function<bool(const std::vector<StreamedText>&)> callback)
+    : m_tokenizer{tokenizer}, m_callback{std::move(callback)} {}
+
+bool BatchedTextStreamer::put(const StreamingChunk& chunk) {
+    if (chunk.sequences.empty())
+        return false;
+
+    std::vector<SequenceState*> states;
+    std::vector<std::vector<int64_t>> lines;
+    std::vector<size_t> line_to_sequence;
+    states.reserve(chunk.sequences.size());
+    for (size_t i = 0; i < chunk.sequences.size(); ++i) {
+        const StreamedSequence& sequence = chunk.sequences[i];
+        SequenceState& state = m_states[{sequence.request_id, sequence.sequence_id}];
+        auto begin = chunk.tokens.begin() + sequence.offset;
+        state.tokens_cache.insert(state.tokens_cache.end(), begin, begin + sequence.length);
+        states.push_back(&state);
+        if (!state.tokens_cache.empty()) {
+            lines.push_back(state.tokens_cache);
+            line_to_sequence.push_back(i);
+        }
+    }
+
+    // single detokenizer call for all sequences
+    std::vector<std::string> decoded(chunk.sequences.size());
+    if (!lines.empty()) {
+        std::vector<std::string> decoded_lines = m_tokenizer.decode(lines);
+        for (size_t line = 0; line < decoded_lines.size(); ++line)
+            decoded[line_to_sequence[line]] = std::move(decoded_lines[line]);
+    }
+
+    constexpr char replacement[] = "\xef\xbf\xbd";  // MSVC with /utf-8 fails to compile � directly with newline in string literal error.
+    std::vector<StreamedText> texts;
+    for (size_t i = 0; i < chunk.sequences.size(); ++i) {
+        const StreamedSequence& sequence = chunk.sequences[i];
+        SequenceState& state = *states[i];
+        const std::string& text = decoded[i];
+
+        StreamedText streamed{sequence.request_id, sequence.sequence_id, {}, sequence.finished};
+        if (text.size() > state.print_len) {
+            bool incomplete = text.size() >= 3 && text.compare(text.size() - 3, 3, replacement) == 0;
+            // Don't print incomplete text unless the sequence has finished
+            if (!incomplete || sequence.finished) {
+                streamed.text = text.substr(state.print_len);
+                state.print_len = text.size();
+            }
+        }
+
+        if (sequence.finished) {
+            m_states.erase({sequence.request_id, sequence.sequence_id});
+        } else if (!text.empty() && '\n' == text.back() && state.print_len == text.size()) {
+            // Flush the cache after the new line symbol
+            state.tokens_cache.clear();
+            state.print_len = 0;
+        }
+
+        if (!streamed.text.empty() || streamed.finished)
+            texts.push_back(std::move(streamed));
+    }
+
+    return texts.empty() ? false : m_callback(texts);
+}
+
+BatchedStreamerBase::~BatchedStreamerBase() = default;
+
+}  // namespace genai
+}  // namespace ov
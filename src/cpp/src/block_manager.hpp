@@ -480,7 +480,32 @@ class BlockManager {
     // the same block can be seen in multiple block_tables for different sequences
     std::map<uint64_t, std::vector<BlocksPerLayer>> m_block_table;
 
+    // KV cache blocks of a chat session kept between turns of the conversation
+    struct PinnedSession {
+        std::vector<BlocksPerLayer> block_table;
+        // tokens whose KV cache is stored in the blocks
+        TokenIds token_ids;
+        std::chrono::time_point<std::chrono::steady_clock> last_access;
+    };
+    std::map<uint64_t, PinnedSession> m_pinned_sessions;
+
     std::mutex m_cached_blocks_map_mutex;
+
+    // releases the blocks of the block table starting from the given logical block index
+    void _free_block_table_tail(std::vector<BlocksPerLayer>& block_table, size_t num_blocks_to_keep) {
+        size_t num_allocated_blocks = block_table.empty() ? 0 : block_table[0].size();
+        for (size_t i = num_blocks_to_keep; i < num_allocated_blocks; i++) {
+            BlocksPerLayer blocks_to_free;
+            blocks_to_free.reserve(block_table.size());
+            for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
+                blocks_to_free.push_back(block_table[layer_idx][i]);
+            }
+            m_allocator.free(blocks_to_free);
+        }
+        for (auto& layer_block_table : block_table) {
+            layer_block_table.resize(std::min(layer_block_table.size(), num_blocks_to_keep));
+        }
+    }
 public:
     /**
      * Constructs the BlockManager.
@@ -1083,6 +1108,101 @@ public:
             }
         }
     }
+
+    /**
+     * Moves KV cache blocks of a finished sequence to a chat session, so they are kept until the next turn of the session.
+     * @param session_id Identifier of the chat session.
+     * @param seq_id Identifier of the finished sequence which is removed from this BlockManager.
+     * @param token_ids Tokens whose KV cache is computed, blocks beyond them are freed.
+     */
+    void pin_session(uint64_t session_id, uint64_t seq_id, TokenIds token_ids) {
+        OPENVINO_ASSERT(has_block_table(seq_id), "sequence with id ", seq_id, " not found in BlockManager, but requested to pin");
+        release_session(session_id);
+
+        PinnedSession& session = m_pinned_sessions[session_id];
+        session.block_table = std::move(m_block_table[seq_id]);
+        m_block_table.erase(seq_id);
+        _free_block_table_tail(session.block_table, (token_ids.size() + m_block_size - 1) / m_block_size);
+        session.token_ids = std::move(token_ids);
+        session.last_access = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Restores KV cache blocks of a chat session for the prompt of the next turn. Only blocks of the longest common
+     * prefix of the session tokens and the prompt are reused, while the rest blocks are freed.
+     * @param session_id Identifier of the chat session.
+     * @param group Sequence group of the next turn which has no blocks allocated yet.
+     */
+    void restore_session(uint64_t session_id, SequenceGroup::Ptr group) {
+        auto session_it = m_pinned_sessions.find(session_id);
+        if (session_it == m_pinned_sessions.end()) {
+            return;
+        }
+        PinnedSession& session = session_it->second;
+        auto sequences = group->get_not_finished_sequences();
+        OPENVINO_ASSERT(sequences.size() == 1);
+        auto seq_id = sequences[0]->get_id();
+        OPENVINO_ASSERT(!has_block_table(seq_id));
+
+        // the last prompt token is always processed to get logits for sampling
+        const auto& prompt_ids = group->get_prompt_ids();
+        size_t max_reused_tokens = std::min(session.token_ids.size(), prompt_ids.size() - 1), num_reused_tokens = 0;
+        while (num_reused_tokens < max_reused_tokens && session.token_ids[num_reused_tokens] == prompt_ids[num_reused_tokens]) {
+            ++num_reused_tokens;
+        }
+        // KV cache of the rest tokens of the last reused block is overwritten by the prompt
+        _free_block_table_tail(session.block_table, (num_reused_tokens + m_block_size - 1) / m_block_size);
+
+        m_block_table[seq_id] = std::move(session.block_table);
+        m_pinned_sessions.erase(session_it);
+        group->update_processed_tokens_num(num_reused_tokens);
+    }
+
+    /**
+     * Frees KV cache blocks of a chat session.
+     * @param session_id Identifier of the chat session.
+     */
+    void release_session(uint64_t session_id) {
+        auto session_it = m_pinned_sessions.find(session_id);
+        if (session_it != m_pinned_sessions.end()) {
+            _free_block_table_tail(session_it->second.block_table, 0);
+            m_pinned_sessions.erase(session_it);
+        }
+    }
+
+    /**
+     * Frees KV cache blocks of chat sessions which were not used during a given time.
+     * @param idle_timeout Time in seconds.
+     */
+    void release_idle_sessions(size_t idle_timeout) {
+        auto now = std::chrono::steady_clock::now();
+        for (auto session_it = m_pinned_sessions.begin(); session_it != m_pinned_sessions.end();) {
+            auto& [session_id, session] = *session_it;
+            ++session_it;
+            if (now - session.last_access >= std::chrono::seconds(idle_timeout)) {
+                release_session(session_id);
+            }
+        }
+    }
+
+    /**
+     * Frees KV cache blocks of the least recently used chat session to free space for running sequences.
+     * @return Whether any session was released.
+     */
+    bool release_lru_session() {
+        if (m_pinned_sessions.empty()) {
+            return false;
+        }
+        auto lru_session = std::min_element(m_pinned_sessions.begin(), m_pinned_sessions.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.last_access < rhs.second.last_access;
+        });
+        release_session(lru_session->first);
+        return true;
+    }
+
+    bool has_pinned_session(uint64_t session_id) const {
+        return m_pinned_sessions.count(session_id) != 0;
+    }
 };
 
 
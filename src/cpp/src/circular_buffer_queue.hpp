@@ -8,6 +8,8 @@
 #include <future>
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <optional>
 
 namespace ov::genai {
 
@@ -20,7 +22,10 @@ class CircularBufferQueue
     std::atomic<int> m_back_idx;
     std::vector<int> m_values;
     std::queue<std::promise<int>> m_promises;
-    std::vector<T> m_data;
+    // Elements are created on the first use, so a queue longer than the actual concurrency doesn't cost anything.
+    // An element is only accessed by the owner of its index, so it's created without a lock.
+    std::vector<std::optional<T>> m_data;
+    std::function<T()> m_create_fn;
     std::mutex m_front_mut;
     std::mutex m_queue_mutex;
 
@@ -28,13 +33,11 @@ public:
 
     CircularBufferQueue(size_t length, const std::function<T()>& create_fn) :
         m_values(length),
+        m_data(length),
+        m_create_fn(create_fn),
         m_front_idx{0},
         m_back_idx{0} {
         std::iota(m_values.begin(), m_values.end(), 0);
-        m_data.reserve(length);
-        for (size_t i = 0; i < length; i++) {
-            m_data.emplace_back(std::move(create_fn()));
-        }
     }
 
     CircularBufferQueue(const CircularBufferQueue&) = delete;
@@ -42,7 +45,10 @@ public:
     CircularBufferQueue& operator=(const CircularBufferQueue&) = delete;
 
     T& get(int value) {
-        return m_data[value];
+        if (!m_data[value]) {
+            m_data[value].emplace(m_create_fn());
+        }
+        return *m_data[value];
     }
 
     std::future<int> get_idle() {
@@ -5,6 +5,7 @@
 #include "continuous_batching_impl.hpp"
 #include "utils.hpp"
 #include "utils/paged_attention_transformations.hpp"
+#include "lora_helper.hpp"
 
 namespace ov::genai {
 template<class... Ts> struct overloaded : Ts... {using Ts::operator()...;};
@@ -21,7 +22,11 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
 
     ov::Core core;
 
-    auto [core_properties, compile_properties] = utils::split_core_compile_config(properties);
+    std::optional<AdapterConfig> adapter_config;
+    ov::AnyMap filtered_properties = extract_adapters_from_properties(properties, &adapter_config).value_or(properties);
+    utils::read_anymap_param(filtered_properties, ov::genai::async_detokenization.name(), m_async_detokenization);
+    filtered_properties.erase(ov::genai::async_detokenization.name());
+    auto [core_properties, compile_properties] = utils::split_core_compile_config(filtered_properties);
     core.set_property(core_properties);
 
     // The model can be compiled for GPU as well
@@ -32,11 +37,49 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
     bool is_need_per_layer_cache_control = scheduler_config.use_cache_eviction;
     utils::apply_paged_attention_transformations(model, device_config, is_need_per_layer_cache_control);
 
+    // requests in one batch can use different adapters, LoRA alphas are selected per token
+    std::optional<AdapterController> adapter_controller;
+    if (adapter_config) {
+        OPENVINO_ASSERT(!scheduler_config.enable_prefix_caching, "Prefix caching can't be used with LoRA adapters, because KV cache of a prefix depends on adapters");
+        OPENVINO_ASSERT(adapter_config->get_mode() == AdapterConfig::MODE_AUTO || adapter_config->get_mode() == AdapterConfig::MODE_DYNAMIC_PER_TOKEN,
+                        "Continuous batching pipeline supports AdapterConfig::MODE_DYNAMIC_PER_TOKEN only");
+        adapter_config->set_mode(AdapterConfig::MODE_DYNAMIC_PER_TOKEN);
+        if (!adapter_config->get_tensor_name_prefix()) {
+            adapter_config->set_tensor_name_prefix("base_model.model.model.");
+        }
+        adapter_controller = AdapterController(model, *adapter_config, device);
+        m_generation_config.adapters = adapter_config;
+    }
+
     init(model, scheduler_config, compile_properties, device_config, core);
+    if (adapter_controller) {
+        m_model_runner->set_adapter_controller(*adapter_controller);
+    }
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_pull_awaiting_requests() {
     std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    // cached blocks are restored on the step thread, as requests are created by tokenization workers concurrently with step()
+    if (m_scheduler->get_config().enable_prefix_caching) {
+        for (const auto& request : m_awaiting_requests) {
+            m_scheduler->restore_cached_blocks(request);
+        }
+    }
+    {
+        // sessions are updated here rather than in add_session_request() / close_chat_session(),
+        // as the scheduler is not protected against concurrent access
+        std::lock_guard<std::mutex> sessions_lock{m_chat_sessions_mutex};
+        for (uint64_t session_id : m_closed_sessions) {
+            m_scheduler->release_session(session_id);
+        }
+        m_closed_sessions.clear();
+        for (const auto& request : m_awaiting_requests) {
+            auto session_it = m_session_requests.find(request->get_request_id());
+            if (session_it != m_session_requests.end()) {
+                m_scheduler->restore_session(session_it->second, request);
+            }
+        }
+    }
     m_requests.insert(m_requests.end(), m_awaiting_requests.begin(), m_awaiting_requests.end());
     m_awaiting_requests.clear();
 }
@@ -91,19 +134,12 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
         sampling_params.set_eos_token_id(m_generation_config.eos_token_id);
     sampling_params.validate();
 
-    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id, input_ids,
-                                                                        sampling_params,
-                                                                        m_scheduler->get_block_size(),
-                                                                        m_scheduler->get_config().enable_prefix_caching);
-    sequence_group->set_sequence_group_ptr(sequence_group);
-    if (m_scheduler->get_config().enable_prefix_caching) {
-        m_scheduler->restore_cached_blocks(sequence_group);
-    }
-
+    SequenceGroup::Ptr sequence_group = _create_sequence_group(request_id, input_ids, sampling_params);
     {
         std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
         m_awaiting_requests.push_back(sequence_group);
     }
+    m_awaiting_requests_cv.notify_all();
     return std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), sampling_params);
 };
 
@@ -111,29 +147,91 @@ GenerationHandle
 ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request_id,
                                                                 const std::string& prompt,
                                                                 ov::genai::GenerationConfig sampling_params) {
-    static ManualTimer timer("tokenize");
-    timer.start();
-    ov::Tensor input_ids = m_tokenizer.encode(prompt).input_ids;
-    timer.end();
-    return add_request(request_id, input_ids, sampling_params);
+    // If eos_token_id was not provided, take value from default m_generation_config
+    if (sampling_params.eos_token_id == -1)
+        sampling_params.set_eos_token_id(m_generation_config.eos_token_id);
+    // invalid parameters are reported to the caller, while the prompt is tokenized asynchronously
+    sampling_params.validate();
+
+    GenerationStream::Ptr generation_stream = GenerationStream::create();
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        ++m_num_pending_prompts;
+    }
+    m_tokenization_workers.submit([this, request_id, prompt, sampling_params, generation_stream] {
+        _tokenize_prompt(request_id, prompt, sampling_params, generation_stream);
+    });
+    return std::make_shared<GenerationHandleImpl>(generation_stream, sampling_params);
+}
+
+SequenceGroup::Ptr
+ContinuousBatchingPipeline::ContinuousBatchingImpl::_create_sequence_group(uint64_t request_id,
+                                                                           const ov::Tensor& input_ids,
+                                                                           const GenerationConfig& sampling_params) {
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id, input_ids,
+                                                                        sampling_params,
+                                                                        m_scheduler->get_block_size(),
+                                                                        m_scheduler->get_config().enable_prefix_caching);
+    sequence_group->set_sequence_group_ptr(sequence_group);
+    return sequence_group;
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_tokenize_prompt(uint64_t request_id,
+                                                                     const std::string& prompt,
+                                                                     const GenerationConfig& sampling_params,
+                                                                     GenerationStream::Ptr generation_stream) {
+    SequenceGroup::Ptr sequence_group;
+    try {
+        static thread_local ManualTimer timer("tokenize");
+        timer.start();
+        ov::Tensor input_ids = m_tokenizer.encode(prompt).input_ids;
+        timer.end();
+        sequence_group = _create_sequence_group(request_id, input_ids, sampling_params);
+        sequence_group->set_generation_stream(generation_stream);
+    } catch (...) {
+        _discard_session_request(request_id);
+        // the error is rethrown to the caller when the handle is read
+        generation_stream->set_error(std::current_exception());
+        generation_stream->push({});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        if (sequence_group) {
+            m_awaiting_requests.push_back(sequence_group);
+        }
+        --m_num_pending_prompts;
+    }
+    m_awaiting_requests_cv.notify_all();
 }
 
 bool ContinuousBatchingPipeline::ContinuousBatchingImpl::has_non_finished_requests() {
     std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
-    return !m_awaiting_requests.empty() || !m_requests.empty();
+    return !m_awaiting_requests.empty() || !m_requests.empty() || m_num_pending_prompts > 0;
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
-    static ManualTimer step_timer("step()");
+    static thread_local ManualTimer step_timer("step()");
     step_timer.start();
 
+    {
+        // nothing can be scheduled until at least one of the requests being tokenized is ready
+        std::unique_lock<std::mutex> lock{m_awaiting_requests_mutex};
+        m_awaiting_requests_cv.wait(lock, [this] {
+            return !m_requests.empty() || !m_awaiting_requests.empty() || m_num_pending_prompts == 0;
+        });
+    }
+
     _pull_awaiting_requests();
 
     m_pipeline_metrics.requests = m_requests.size();
+    const TokenizationCacheMetrics tokenization_cache_metrics = m_tokenizer.get_cache_metrics();
+    m_pipeline_metrics.tokenization_cache_hit_rate = tokenization_cache_metrics.get_hit_rate();
+    m_pipeline_metrics.tokenization_time_saved = tokenization_cache_metrics.time_saved_ms;
 
     Scheduler::Output scheduler_output;
     {
-        static ManualTimer timer("scheduling");
+        static thread_local ManualTimer timer("scheduling");
         timer.start();
         m_scheduler->clean_empty_blocks(m_requests);
         scheduler_output = m_scheduler->schedule(m_requests);
@@ -162,7 +260,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     ov::Tensor logits;
     {
-        static ManualTimer timer("forward");
+        static thread_local ManualTimer timer("forward");
         timer.start();
         logits = m_model_runner->forward(m_requests, scheduler_output);
         timer.end();
@@ -190,7 +288,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     SamplerOutput sampler_output;
     {
-        static ManualTimer timer("sample");
+        static thread_local ManualTimer timer("sample");
         timer.start();
         sampler_output = m_sampler->sample(m_requests, logits, m_is_validation_mode_enabled);
         timer.end();
@@ -198,7 +296,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     // process sampler_output (e.g. fork or drop sequences from BlockScheduler)
     {
-        static ManualTimer timer("fork / free sequence");
+        static thread_local ManualTimer timer("fork / free sequence");
         timer.start();
 
         for (const auto& pair : sampler_output.m_forked_sequences) {
@@ -214,9 +312,18 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
         timer.end();
     }
 
+    // pass new tokens of all requests to the batched streamer at once
+    if (std::shared_ptr<BatchedStreamerBase> batched_streamer = get_batched_streamer()) {
+        static thread_local ManualTimer timer("batched streaming");
+        timer.start();
+        if (_stream_step_outputs(*batched_streamer))
+            _drop_requests_by_pipeline();
+        timer.end();
+    }
+
     // notify requests dropped by handle
     {
-        static ManualTimer timer("notify requests dropped by handle");
+        static thread_local ManualTimer timer("notify requests dropped by handle");
         timer.start();
         _notify_requests_dropped_by_handle();
         timer.end();
@@ -225,7 +332,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     // free non running requests for current step
 
     {
-        static ManualTimer timer("free non running requests");
+        static thread_local ManualTimer timer("free non running requests");
         timer.start();
         _free_non_running_requests();
         timer.end();
@@ -248,12 +355,13 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::generate(const std::vector<o
             return streamer;
         },
         [this](const std::function<bool(std::string)>& streamer) -> std::shared_ptr<StreamerBase> {
-            return std::make_unique<TextCallbackStreamer>(m_tokenizer, streamer);
+            return std::make_unique<TextCallbackStreamer>(m_tokenizer, streamer, m_async_detokenization);
         }
     }, streamer);
 
     OPENVINO_ASSERT(streamer_ptr == nullptr || input_ids.size() == 1 && (sampling_params[0].is_greedy_decoding() || sampling_params[0].is_multinomial()),
-        "Currently streaming is possible only with batch size=1 and only for greedy or multinomial decoding");
+        "Currently streaming is possible only with batch size=1 and only for greedy or multinomial decoding. "
+        "Use ContinuousBatchingPipeline::set_batched_streamer to stream multiple requests");
 
     std::vector<GenerationHandle> generations;
     for (size_t request_id = 0; request_id < input_ids.size(); ++request_id) {
@@ -266,10 +374,12 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::generate(const std::vector<o
 
     auto drop_requests = [&] () {
         for (const std::shared_ptr<ov::genai::SequenceGroup> request : m_requests) {
+            _discard_session_request(request->get_request_id());
             for (const auto& sequence: request->get_sequences()) {
                 if (m_scheduler->has_block_table(sequence->get_id())) {
                     m_scheduler->free_sequence(sequence->get_id());
                 }
+                m_streaming_states.erase(sequence->get_id());
             }
             m_sampler->clear_request_info(request->get_request_id());
         }
@@ -324,10 +434,12 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_free_non_running_reque
     while (requests_iterator != m_requests.end()) {
         const auto& request = *requests_iterator;
         if(request->has_finished() || request->out_of_memory() || request->handle_dropped()) {
+            _finish_session_request(request);
             for (const auto& sequence: request->get_sequences()) {
                 if (m_scheduler->has_block_table(sequence->get_id())) {
                     m_scheduler->free_sequence(sequence->get_id());
                 }
+                m_streaming_states.erase(sequence->get_id());
             }
             m_sampler->clear_request_info(request->get_request_id());
             requests_iterator = m_requests.erase(requests_iterator);
@@ -337,6 +449,115 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_free_non_running_reque
     }
 }
 
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_discard_session_request(uint64_t request_id) {
+    std::lock_guard<std::mutex> lock{m_chat_sessions_mutex};
+    auto request_it = m_session_requests.find(request_id);
+    if (request_it == m_session_requests.end()) {
+        return;
+    }
+    auto session_it = m_chat_sessions.find(request_it->second);
+    m_session_requests.erase(request_it);
+    if (session_it == m_chat_sessions.end()) {
+        return;
+    }
+    // the session can be continued by another message
+    ChatSession& session = session_it->second;
+    session.has_active_request = false;
+    session.active_message.clear();
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_finish_session_request(const SequenceGroup::Ptr& request) {
+    if (!request->has_finished() || request->out_of_memory() || request->handle_dropped()) {
+        _discard_session_request(request->get_request_id());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{m_chat_sessions_mutex};
+    auto request_it = m_session_requests.find(request->get_request_id());
+    if (request_it == m_session_requests.end()) {
+        return;
+    }
+    uint64_t session_id = request_it->second;
+    m_session_requests.erase(request_it);
+    auto session_it = m_chat_sessions.find(session_id);
+    if (session_it == m_chat_sessions.end()) {
+        return;
+    }
+    ChatSession& session = session_it->second;
+    session.has_active_request = false;
+
+    // the best sequence continues the conversation as generate() returns it first
+    Sequence::CPtr sequence = request->get_finished_sequences().at(0);
+    session.history.push_back({{"role", "user"}, {"content", std::move(session.active_message)}});
+    session.active_message.clear();
+    session.history.push_back({{"role", "assistant"}, {"content", m_tokenizer.decode(sequence->get_generated_ids())}});
+
+    // prefix caching restores the blocks by itself, while evicted blocks don't correspond to the tokens anymore
+    if (m_scheduler->get_config().enable_prefix_caching || request->get_num_evicted_tokens() > 0 ||
+        !m_scheduler->has_block_table(sequence->get_id())) {
+        return;
+    }
+    TokenIds token_ids = request->get_prompt_ids();
+    const TokenIds& generated_ids = sequence->get_generated_ids();
+    token_ids.insert(token_ids.end(), generated_ids.begin(), generated_ids.end());
+    // KV cache of the last generated token is not computed
+    token_ids.resize(std::min(token_ids.size(), request->get_num_processed_tokens()));
+    m_scheduler->pin_session(session_id, sequence->get_id(), std::move(token_ids));
+    m_streaming_states.erase(sequence->get_id());
+}
+
+uint64_t ContinuousBatchingPipeline::ContinuousBatchingImpl::open_chat_session(const std::string& system_message) {
+    std::lock_guard<std::mutex> lock{m_chat_sessions_mutex};
+    uint64_t session_id = m_next_session_id++;
+    ChatSession& session = m_chat_sessions[session_id];
+    if (!system_message.empty()) {
+        session.history.push_back({{"role", "system"}, {"content", system_message}});
+    }
+    return session_id;
+}
+
+GenerationHandle
+ContinuousBatchingPipeline::ContinuousBatchingImpl::add_session_request(uint64_t request_id,
+                                                                       uint64_t session_id,
+                                                                       const std::string& message,
+                                                                       ov::genai::GenerationConfig sampling_params) {
+    ChatHistory history;
+    {
+        std::lock_guard<std::mutex> lock{m_chat_sessions_mutex};
+        auto session_it = m_chat_sessions.find(session_id);
+        OPENVINO_ASSERT(session_it != m_chat_sessions.end(), "Chat session ", session_id, " is not opened");
+        ChatSession& session = session_it->second;
+        OPENVINO_ASSERT(!session.has_active_request, "The previous turn of chat session ", session_id, " is not finished");
+        // reserves the turn, so the session can't get another message or be closed while the prompt is tokenized
+        session.has_active_request = true;
+        session.active_message = message;
+        m_session_requests[request_id] = session_id;
+        history = session.history;
+    }
+
+    // tokenization doesn't hold the lock, as step() takes it to restore and finish session requests
+    try {
+        history.push_back({{"role", "user"}, {"content", message}});
+        constexpr bool add_generation_prompt = true;
+        std::string templated_history = m_tokenizer.apply_chat_template(history, add_generation_prompt);
+        // ov::genai::add_special_tokens(false) is aligned with stateful pipeline
+        ov::Tensor input_ids = m_tokenizer.encode(templated_history, ov::genai::add_special_tokens(false)).input_ids;
+        return add_request(request_id, input_ids, sampling_params);
+    } catch (...) {
+        _discard_session_request(request_id);
+        throw;
+    }
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::close_chat_session(uint64_t session_id) {
+    std::lock_guard<std::mutex> lock{m_chat_sessions_mutex};
+    auto session_it = m_chat_sessions.find(session_id);
+    OPENVINO_ASSERT(session_it != m_chat_sessions.end(), "Chat session ", session_id, " is not opened");
+    OPENVINO_ASSERT(!session_it->second.has_active_request, "The last turn of chat session ", session_id, " is not finished");
+    m_chat_sessions.erase(session_it);
+    m_closed_sessions.push_back(session_id);
+}
+
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_notify_requests_dropped_by_handle() {
     // Notify the last time by pushing empty output
     // This causes read() to unblock by adding anything to the queue
@@ -346,6 +567,65 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_notify_requests_droppe
     }
 }
 
+bool ContinuousBatchingPipeline::ContinuousBatchingImpl::_stream_step_outputs(BatchedStreamerBase& batched_streamer) {
+    StreamingChunk chunk;
+    for (const SequenceGroup::Ptr& request : m_requests) {
+        const auto& sampling_params = request->get_sampling_parameters();
+        const bool request_finished = request->has_finished() || request->out_of_memory() || request->handle_dropped();
+        // beam search hypotheses and tokens which may turn out to be a part of an excluded stop string
+        // become final only when the request finishes
+        const bool stream_on_finish = sampling_params.is_beam_search() ||
+            (!sampling_params.stop_strings.empty() && !sampling_params.include_stop_str_in_output);
+        if (stream_on_finish && !request_finished)
+            continue;
+
+        std::vector<Sequence::CPtr> sequences;
+        if (sampling_params.is_beam_search()) {
+            sequences = request->get_finished_sequences();
+            sequences.resize(std::min(sequences.size(), sampling_params.num_return_sequences));
+        } else {
+            sequences.assign(request->get_sequences().begin(), request->get_sequences().end());
+        }
+
+        for (const Sequence::CPtr& sequence : sequences) {
+            StreamingState& state = m_streaming_states[sequence->get_id()];
+            if (state.finished)
+                continue;
+
+            const TokenIds& generated_ids = sequence->get_generated_ids();
+            const bool finished = request_finished || sequence->has_finished() || sequence->out_of_memory();
+            const size_t num_new_tokens = generated_ids.size() > state.num_streamed_tokens ? generated_ids.size() - state.num_streamed_tokens : 0;
+            if (num_new_tokens == 0 && !finished)
+                continue;
+
+            chunk.sequences.push_back({request->get_request_id(), sequence->get_grouped_id(), chunk.tokens.size(), num_new_tokens, finished});
+            chunk.tokens.insert(chunk.tokens.end(), generated_ids.end() - num_new_tokens, generated_ids.end());
+            state.num_streamed_tokens = generated_ids.size();
+            state.finished = finished;
+        }
+    }
+    return !chunk.sequences.empty() && batched_streamer.put(chunk);
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_drop_requests_by_pipeline() {
+    for (const SequenceGroup::Ptr& request : m_requests) {
+        _discard_session_request(request->get_request_id());
+        for (const auto& sequence: request->get_sequences()) {
+            if (m_scheduler->has_block_table(sequence->get_id())) {
+                m_scheduler->free_sequence(sequence->get_id());
+            }
+            m_streaming_states.erase(sequence->get_id());
+        }
+        m_sampler->clear_request_info(request->get_request_id());
+        if (!request->has_finished()) {
+            request->set_generation_status(GenerationStatus::DROPPED_BY_PIPELINE);
+            // unblock readers waiting for outputs
+            request->push_empty_outputs();
+        }
+    }
+    m_requests.clear();
+}
+
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_register_step_cache_usage(float step_cache_usage) {
     if (m_previous_step_cache_usages.size() >= AVG_CACHE_USAGE_WINDOW_SIZE_IN_STEPS) {
         m_previous_step_cache_usages.pop_front();
@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+
 #include "continuous_batching_impl_interface.hpp"
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "cache_eviction.hpp"
+#include "worker_pool.hpp"
 
 namespace ov::genai {
 class ContinuousBatchingPipeline::ContinuousBatchingImpl : public ContinuousBatchingPipeline::ImplInterface {
@@ -21,15 +25,49 @@ protected:
     std::vector<SequenceGroup::Ptr> m_awaiting_requests;
     // Mutex protecting access to m_awaiting_requests, so add_request and step methods can be called from different threads
     std::mutex m_awaiting_requests_mutex;
+    // notifies step() waiting for requests which are being tokenized
+    std::condition_variable m_awaiting_requests_cv;
+    // number of prompts added by add_request() which are not tokenized yet, protected by m_awaiting_requests_mutex
+    size_t m_num_pending_prompts = 0;
+
+    // prompts are tokenized by a fixed pool of workers, so add_request() doesn't block the caller
+    // and a request enters the scheduler as soon as its tokens are ready
+    static const size_t NUM_TOKENIZATION_WORKERS = 4;
+
+    // see ov::genai::async_detokenization
+    bool m_async_detokenization = false;
 
     std::map<size_t, CacheEvictionAlgorithm> m_seq_group_id_to_cache_eviction_algo_map;
 
+    struct StreamingState {
+        size_t num_streamed_tokens = 0;
+        bool finished = false;
+    };
+    // sequence id -> how much of the sequence was already passed to m_batched_streamer
+    std::unordered_map<uint64_t, StreamingState> m_streaming_states;
+
     static const size_t AVG_CACHE_USAGE_WINDOW_SIZE_IN_STEPS = 1000;
     std::deque<float> m_previous_step_cache_usages;
     
     // flag to enable validation mode for sampler
     bool m_is_validation_mode_enabled = false;
 
+    struct ChatSession {
+        // finished turns only, the turn of the active request is added once the request is finished
+        ChatHistory history;
+        // a new turn can be added only when the previous one is finished
+        bool has_active_request = false;
+        std::string active_message;
+    };
+    std::map<uint64_t, ChatSession> m_chat_sessions;
+    // request ID => session ID for requests added by add_session_request()
+    std::map<uint64_t, uint64_t> m_session_requests;
+    // KV cache blocks of closed sessions are released by the next step
+    std::vector<uint64_t> m_closed_sessions;
+    uint64_t m_next_session_id = 0;
+    // Mutex protecting chat sessions, so sessions can be used from different threads while step() is running
+    std::mutex m_chat_sessions_mutex;
+
 #ifdef DEBUG_CACHE_STATE_DUMP
     size_t step_count = 0;
 #endif
@@ -37,8 +75,16 @@ protected:
     // used by tests only
     ContinuousBatchingImpl() = default;
 
+    SequenceGroup::Ptr _create_sequence_group(uint64_t request_id, const ov::Tensor& input_ids, const GenerationConfig& sampling_params);
+    void _tokenize_prompt(uint64_t request_id, const std::string& prompt, const GenerationConfig& sampling_params, GenerationStream::Ptr generation_stream);
     void _free_non_running_requests();
+    void _finish_session_request(const SequenceGroup::Ptr& request);
+    // discards the turn of a session request which is not finished successfully
+    void _discard_session_request(uint64_t request_id);
     void _notify_requests_dropped_by_handle();
+    // returns true if the batched streamer requested to stop generation
+    bool _stream_step_outputs(BatchedStreamerBase& batched_streamer);
+    void _drop_requests_by_pipeline();
     void _register_step_cache_usage(float step_cache_usage);
     float _get_current_running_average_cache_usage() const;
     void maybe_evict_cache_blocks(const SchedulerConfig& sched_config);
@@ -81,9 +127,20 @@ public:
 
     void step() override;
 
+    uint64_t open_chat_session(const std::string& system_message) override;
+    GenerationHandle add_session_request(uint64_t request_id,
+                                         uint64_t session_id,
+                                         const std::string& message,
+                                         ov::genai::GenerationConfig sampling_params) override;
+    void close_chat_session(uint64_t session_id) override;
+
     std::vector<EncodedGenerationResult>
     generate(const std::vector<ov::Tensor>& input_ids,
              const std::vector<GenerationConfig>& sampling_params,
              const StreamerVariant& streamer) override;
+
+private:
+    // declared last, so tokenization workers are joined before the members they use are destroyed
+    WorkerPool m_tokenization_workers{NUM_TOKENIZATION_WORKERS};
 };
 }
\ No newline at end of file
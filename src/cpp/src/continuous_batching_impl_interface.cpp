@@ -17,6 +17,16 @@ Tokenizer ContinuousBatchingPipeline::ImplInterface::get_tokenizer() {
     return m_tokenizer;
 }
 
+void ContinuousBatchingPipeline::ImplInterface::set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) {
+    std::lock_guard<std::mutex> lock{m_batched_streamer_mutex};
+    m_batched_streamer = std::move(streamer);
+}
+
+std::shared_ptr<BatchedStreamerBase> ContinuousBatchingPipeline::ImplInterface::get_batched_streamer() {
+    std::lock_guard<std::mutex> lock{m_batched_streamer_mutex};
+    return m_batched_streamer;
+}
+
 void ContinuousBatchingPipeline::ImplInterface::start_chat(const std::string& system_message) {
     if (!system_message.empty()) {
         m_history.push_back({{"role", "system"}, {"content", system_message}});
@@ -29,6 +39,21 @@ void ContinuousBatchingPipeline::ImplInterface::finish_chat() {
     m_history.clear();
 };
 
+uint64_t ContinuousBatchingPipeline::ImplInterface::open_chat_session(const std::string& system_message) {
+    OPENVINO_THROW("Chat sessions are not supported by this pipeline");
+}
+
+GenerationHandle ContinuousBatchingPipeline::ImplInterface::add_session_request(uint64_t request_id,
+                                                                               uint64_t session_id,
+                                                                               const std::string& message,
+                                                                               ov::genai::GenerationConfig sampling_params) {
+    OPENVINO_THROW("Chat sessions are not supported by this pipeline");
+}
+
+void ContinuousBatchingPipeline::ImplInterface::close_chat_session(uint64_t session_id) {
+    OPENVINO_THROW("Chat sessions are not supported by this pipeline");
+}
+
 std::vector<GenerationResult>
 ContinuousBatchingPipeline::ImplInterface::generate(
     const std::vector<std::string>& prompts,
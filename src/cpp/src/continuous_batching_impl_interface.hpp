@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "cache_manager.hpp"
@@ -38,6 +40,12 @@ protected:
     bool m_is_chat_conversation = false;
     ChatHistory m_history;
 
+    // set_batched_streamer() can be called while step() is running, so step() works with a copy of the pointer
+    std::shared_ptr<BatchedStreamerBase> m_batched_streamer = nullptr;
+    std::mutex m_batched_streamer_mutex;
+
+    std::shared_ptr<BatchedStreamerBase> get_batched_streamer();
+
 public:
     ov::genai::GenerationConfig get_config() const;
     PipelineMetrics get_metrics() const;
@@ -52,6 +60,8 @@ public:
     
     virtual bool has_non_finished_requests() = 0;
 
+    virtual void set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer);
+
     virtual void step() = 0;
 
     virtual std::vector<EncodedGenerationResult>
@@ -65,5 +75,12 @@ public:
 
     void start_chat(const std::string& system_message);
     void finish_chat();
+
+    virtual uint64_t open_chat_session(const std::string& system_message);
+    virtual GenerationHandle add_session_request(uint64_t request_id,
+                                                 uint64_t session_id,
+                                                 const std::string& message,
+                                                 ov::genai::GenerationConfig sampling_params);
+    virtual void close_chat_session(uint64_t session_id);
 };
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "openvino/genai/tokenizer.hpp"
 #include "continuous_batching_impl.hpp"
 #include "speculative_decoding/speculative_decoding_impl.hpp"
+#include "prompt_lookup/prompt_lookup_impl.hpp"
 #include "timer.hpp"
 #include "utils.hpp"
 #include "debug_utils.hpp"
@@ -28,6 +29,16 @@ extract_draft_model_from_config(ov::AnyMap& config) {
     return draft_model;
 }
 
+inline bool
+extract_prompt_lookup_from_config(ov::AnyMap& config) {
+    bool is_prompt_lookup = false;
+    if (config.find(ov::genai::prompt_lookup.name()) != config.end()) {
+        is_prompt_lookup = config.at(ov::genai::prompt_lookup.name()).as<bool>();
+        config.erase(ov::genai::prompt_lookup.name());
+    }
+    return is_prompt_lookup;
+}
+
 ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::path& models_path,
                                                         const SchedulerConfig& scheduler_config,
                                                         const std::string& device,
@@ -35,8 +46,14 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::p
                                                         const ov::AnyMap& tokenizer_properties) {
     auto properties_without_draft_model = properties;
     auto draft_model = extract_draft_model_from_config(properties_without_draft_model);
-    if (draft_model.models_path.empty()) {
-        m_impl = std::make_shared<ContinuousBatchingImpl>(models_path, scheduler_config, device, properties, tokenizer_properties);
+    auto is_prompt_lookup = extract_prompt_lookup_from_config(properties_without_draft_model);
+    // early exit draft layers are extracted by SpeculativeDecodingImpl
+    auto is_self_speculative = properties_without_draft_model.count(ov::genai::early_exit_draft_layers.name()) != 0;
+    if (is_prompt_lookup) {
+        OPENVINO_ASSERT(draft_model.models_path.empty() && !is_self_speculative, "Speculative decoding and prompt lookup decoding are mutually excluded");
+        m_impl = std::make_shared<PromptLookupImpl>(models_path, scheduler_config, device, properties_without_draft_model, tokenizer_properties);
+    } else if (draft_model.models_path.empty() && !is_self_speculative) {
+        m_impl = std::make_shared<ContinuousBatchingImpl>(models_path, scheduler_config, device, properties_without_draft_model, tokenizer_properties);
     } else {
         m_impl = std::make_shared<SpeculativeDecodingImpl>(models_path, scheduler_config, device, properties_without_draft_model, draft_model, tokenizer_properties);
     }
@@ -50,8 +67,14 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     const ov::AnyMap& properties) {
     auto properties_without_draft_model = properties;
     auto draft_model = extract_draft_model_from_config(properties_without_draft_model);
-    if (draft_model.models_path.empty()) {
-        m_impl = std::make_shared<ContinuousBatchingImpl>(models_path, tokenizer, scheduler_config, device, properties);
+    auto is_prompt_lookup = extract_prompt_lookup_from_config(properties_without_draft_model);
+    // early exit draft layers are extracted by SpeculativeDecodingImpl
+    auto is_self_speculative = properties_without_draft_model.count(ov::genai::early_exit_draft_layers.name()) != 0;
+    if (is_prompt_lookup) {
+        OPENVINO_ASSERT(draft_model.models_path.empty() && !is_self_speculative, "Speculative decoding and prompt lookup decoding are mutually excluded");
+        m_impl = std::make_shared<PromptLookupImpl>(models_path, tokenizer, scheduler_config, device, properties_without_draft_model);
+    } else if (draft_model.models_path.empty() && !is_self_speculative) {
+        m_impl = std::make_shared<ContinuousBatchingImpl>(models_path, tokenizer, scheduler_config, device, properties_without_draft_model);
     } else {
         m_impl = std::make_shared<SpeculativeDecodingImpl>(models_path, scheduler_config, device, properties_without_draft_model, draft_model);
     }
@@ -81,6 +104,10 @@ void ContinuousBatchingPipeline::step() {
     m_impl->step();
 }
 
+void ContinuousBatchingPipeline::set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) {
+    m_impl->set_batched_streamer(std::move(streamer));
+}
+
 bool ContinuousBatchingPipeline::has_non_finished_requests() {
     return m_impl->has_non_finished_requests();
 }
@@ -99,4 +126,16 @@ void ContinuousBatchingPipeline::start_chat(const std::string& system_message) {
 
 void ContinuousBatchingPipeline::finish_chat() {
     m_impl->finish_chat();
+}
+
+uint64_t ContinuousBatchingPipeline::open_chat_session(const std::string& system_message) {
+    return m_impl->open_chat_session(system_message);
+}
+
+GenerationHandle ContinuousBatchingPipeline::add_session_request(uint64_t request_id, uint64_t session_id, const std::string& message, const ov::genai::GenerationConfig& sampling_params) {
+    return m_impl->add_session_request(request_id, session_id, message, sampling_params);
+}
+
+void ContinuousBatchingPipeline::close_chat_session(uint64_t session_id) {
+    m_impl->close_chat_session(session_id);
 };
@@ -102,7 +102,13 @@ void GenerationConfig::update_generation_config(const ov::AnyMap& config_map) {
     read_anymap_param(config_map, "eos_token_id", eos_token_id);
     read_anymap_param(config_map, "echo", echo);
     read_anymap_param(config_map, "logprobs", logprobs);
+    read_anymap_param(config_map, "assistant_confidence_threshold", assistant_confidence_threshold);
+    read_anymap_param(config_map, "num_assistant_tokens", num_assistant_tokens);
+    read_anymap_param(config_map, "dynamic_num_assistant_tokens", dynamic_num_assistant_tokens);
+    read_anymap_param(config_map, "max_ngram_size", max_ngram_size);
+    read_anymap_param(config_map, "max_candidate_branches", max_candidate_branches);
     read_anymap_param(config_map, "adapters", adapters);
+    read_anymap_param(config_map, "structured_output_config", structured_output_config);
 }
 
 size_t GenerationConfig::get_max_new_tokens(size_t prompt_length) const {
@@ -130,6 +136,10 @@ bool GenerationConfig::is_speculative_decoding() const {
     return (assistant_confidence_threshold > 0 || num_assistant_tokens > 0);
 }
 
+bool GenerationConfig::is_prompt_lookup() const {
+    return max_ngram_size > 0 && num_assistant_tokens > 0;
+}
+
 void GenerationConfig::validate() const {
     OPENVINO_ASSERT(!do_sample || num_beams == 1, 
                     "Beam search with sampling is not supported yet. "
@@ -173,6 +183,12 @@ void GenerationConfig::validate() const {
         OPENVINO_ASSERT(frequency_penalty >= -2.0f && frequency_penalty <= 2.0f, "frequence_penalty penalty must be a [-2; +2]");
         OPENVINO_ASSERT(presence_penalty >= -2.0f && presence_penalty <= 2.0f, "presence_penalty penalty must be a [-2; +2]");
     }
+    if (structured_output_config.has_value()) {
+        const auto& config = *structured_output_config;
+        OPENVINO_ASSERT(config.json_schema.has_value() + config.regex.has_value() + config.grammar.has_value() == 1,
+                        "Exactly one of 'json_schema', 'regex' or 'grammar' must be set in 'structured_output_config'");
+        OPENVINO_ASSERT(!is_beam_search(), "Structured output is not supported for beam search");
+    }
     if (is_speculative_decoding()) {
         if (assistant_confidence_threshold != 0.f) {
             OPENVINO_ASSERT(num_assistant_tokens == 0, "Parameters `assistant_confidence_threshold` and `num_assistant_tokens` are mutually exclusive in `GenerationConfig`");
@@ -180,6 +196,15 @@ void GenerationConfig::validate() const {
             OPENVINO_ASSERT(num_assistant_tokens > 0, "Parameters `assistant_confidence_threshold` and `num_assistant_tokens` are mutually exclusive in `GenerationConfig`");
         };
     }
+    if (dynamic_num_assistant_tokens) {
+        OPENVINO_ASSERT(num_assistant_tokens > 0, "`dynamic_num_assistant_tokens` requires `num_assistant_tokens` to be set in `GenerationConfig`");
+    }
+    if (max_ngram_size > 0) {
+        OPENVINO_ASSERT(num_assistant_tokens > 0 && assistant_confidence_threshold == 0.f,
+                        "Prompt lookup decoding requires `num_assistant_tokens` to be set in `GenerationConfig`");
+    }
+    OPENVINO_ASSERT(max_candidate_branches > 0, "'max_candidate_branches' must be greater than 0");
+    OPENVINO_ASSERT(max_candidate_branches == 1 || max_ngram_size > 0, "Several candidate branches are supported by prompt lookup decoding only");
 }
 
 GenerationConfig beam_search() {
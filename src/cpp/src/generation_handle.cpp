@@ -30,12 +30,17 @@ void GenerationHandleImpl::drop() {
 
 std::unordered_map<uint64_t, GenerationOutput> GenerationHandleImpl::back() {
     OPENVINO_ASSERT(!is_dropped(), "GenerationHandle cannot be used after it is dropped.");
+    m_generation_stream->rethrow_if_failed();
     return m_generation_stream->back();
 }
 
 std::unordered_map<uint64_t, GenerationOutput> GenerationHandleImpl::read() {
     OPENVINO_ASSERT(!is_dropped(), "GenerationHandle cannot be used after it is dropped.");
-    return m_generation_stream->read();
+    m_generation_stream->rethrow_if_failed();
+    GenerationOutputs outputs = m_generation_stream->read();
+    // read() could be unblocked by a failure of the request
+    m_generation_stream->rethrow_if_failed();
+    return outputs;
 }
 
 void add_partial_result(std::unordered_map<uint64_t, GenerationOutput>& partial_results, std::unordered_map<uint64_t, GenerationOutput>& iteration_results) {
@@ -0,0 +1,274 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "openvino/core/except.hpp"
+#include "openvino/genai/generation_handle.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Single-producer single-consumer channel carrying GenerationOutputs from a pipeline to a GenerationHandle.
+ *
+ * Pushed outputs are flattened into fixed-size token records stored in a ring of fixed-size segments. Segments are
+ * recycled once the consumer has read them, so the producer neither locks nor allocates per step. The ring starts
+ * with NUM_INITIAL_SEGMENTS segments and gets a new segment only when all of them hold unread records, as the
+ * producer is a pipeline step which must not be blocked by a slow reader: the capacity stays at the largest backlog
+ * of unread records and is reused afterwards.
+ * All records of a push are published by a single release store and read() assembles them back into GenerationOutputs.
+ * The mutex is touched only when the consumer has run out of data and parks on the condition variable.
+ *
+ * Full results of a finished request are not copied by the producer: push_final() publishes a builder
+ * which is invoked on the consumer side when the results are read.
+ *
+ * Consumer methods are serialized by a consumer-side mutex, which is uncontended unless copies of a GenerationHandle
+ * are read from several threads at once.
+ */
+class GenerationOutputChannel {
+    enum RecordFlags : uint8_t {
+        HAS_SEQUENCE = 1,       // record belongs to a sequence output
+        HAS_TOKEN = 2,          // record carries a token, otherwise only sequence's score and finish reason
+        END_OF_PUSH = 4,        // the last record of a push
+        FINAL_OUTPUTS = 8       // record carries a builder of the full outputs
+    };
+
+    struct TokenRecord {
+        uint64_t sequence_id;
+        int64_t token_id;
+        float log_prob;
+        float score;
+        GenerationFinishReason finish_reason;
+        uint8_t flags;
+        std::function<GenerationOutputs()>* final_outputs;
+    };
+
+    static constexpr size_t SEGMENT_SIZE = 64;
+    static constexpr size_t NUM_INITIAL_SEGMENTS = 4;
+    static constexpr size_t SPIN_COUNT = 64;
+
+    struct Segment {
+        TokenRecord records[SEGMENT_SIZE];
+        Segment* next = nullptr;
+    };
+
+    // producer side
+    Segment* m_tail;
+    uint64_t m_tail_begin = 0;
+    uint64_t m_write_pos = 0;
+    uint64_t m_push_begin = 0;
+    // number of records the ring can hold
+    uint64_t m_capacity = NUM_INITIAL_SEGMENTS * SEGMENT_SIZE;
+
+    // consumer side
+    std::mutex m_consumer_mutex;
+    Segment* m_head;
+    uint64_t m_head_begin = 0;
+    uint64_t m_read_pos = 0;
+
+    // number of records visible to the consumer
+    std::atomic<uint64_t> m_committed{0};
+    // number of records read by the consumer, their segments can be reused by the producer
+    std::atomic<uint64_t> m_consumed{0};
+    // position of the first record of the latest committed push, used by back()
+    std::atomic<uint64_t> m_last_push_begin{0};
+
+    std::atomic<bool> m_consumer_waiting{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    TokenRecord& next_record() {
+        if (m_write_pos == m_tail_begin + SEGMENT_SIZE) {
+            // the next segment of the ring last held records [m_write_pos - m_capacity, m_write_pos - m_capacity + SEGMENT_SIZE)
+            if (m_consumed.load(std::memory_order_acquire) + m_capacity < m_write_pos + SEGMENT_SIZE) {
+                // the consumer hasn't read them yet, so the ring grows by a segment inserted before the unread one
+                Segment* segment = new Segment();
+                segment->next = m_tail->next;
+                m_tail->next = segment;
+                m_capacity += SEGMENT_SIZE;
+            }
+            m_tail = m_tail->next;
+            m_tail_begin = m_write_pos;
+        }
+        return m_tail->records[m_write_pos++ - m_tail_begin];
+    }
+
+    // consumer only
+    const TokenRecord& record_to_read() {
+        while (m_read_pos >= m_head_begin + SEGMENT_SIZE) {
+            m_head = m_head->next;
+            m_head_begin += SEGMENT_SIZE;
+        }
+        return m_head->records[m_read_pos - m_head_begin];
+    }
+
+    bool has_data() const {
+        return m_committed.load(std::memory_order_seq_cst) > m_read_pos;
+    }
+
+    void wait_for_data() {
+        for (size_t spin = 0; spin < SPIN_COUNT; ++spin) {
+            if (has_data())
+                return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_consumer_waiting.store(true, std::memory_order_seq_cst);
+        m_cv.wait(lock, [this] { return has_data(); });
+        m_consumer_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    static void add_record(GenerationOutputs& outputs, const TokenRecord& record, bool take_ownership) {
+        if (record.flags & FINAL_OUTPUTS) {
+            std::unique_ptr<std::function<GenerationOutputs()>> owned(take_ownership ? record.final_outputs : nullptr);
+            outputs = (*record.final_outputs)();
+        } else if (record.flags & HAS_SEQUENCE) {
+            GenerationOutput& output = outputs[record.sequence_id];
+            if (record.flags & HAS_TOKEN) {
+                output.generated_ids.push_back(record.token_id);
+                output.generated_log_probs.push_back(record.log_prob);
+            }
+            output.score = record.score;
+            output.finish_reason = record.finish_reason;
+        }
+    }
+
+public:
+    GenerationOutputChannel() : m_tail(new Segment()) {
+        m_tail->next = m_tail;
+        for (size_t i = 1; i < NUM_INITIAL_SEGMENTS; ++i) {
+            Segment* segment = new Segment();
+            segment->next = m_tail->next;
+            m_tail->next = segment;
+        }
+        m_head = m_tail;
+    }
+
+    GenerationOutputChannel(const GenerationOutputChannel&) = delete;
+    GenerationOutputChannel& operator=(const GenerationOutputChannel&) = delete;
+
+    ~GenerationOutputChannel() {
+        // release builders which were never read
+        for (; m_read_pos < m_committed.load(); ++m_read_pos) {
+            const TokenRecord& record = record_to_read();
+            if (record.flags & FINAL_OUTPUTS)
+                delete record.final_outputs;
+        }
+        Segment* segment = m_head->next;
+        while (segment != m_head) {
+            Segment* next = segment->next;
+            delete segment;
+            segment = next;
+        }
+        delete m_head;
+    }
+
+    // Producer: appends tokens of a single sequence to the current push, which becomes visible on commit()
+    void append(uint64_t sequence_id, const int64_t* token_ids, const float* log_probs, size_t num_tokens,
+                float score, GenerationFinishReason finish_reason) {
+        for (size_t i = 0; i < std::max<size_t>(num_tokens, 1); ++i) {
+            TokenRecord& record = next_record();
+            record.sequence_id = sequence_id;
+            record.token_id = i < num_tokens ? token_ids[i] : 0;
+            record.log_prob = i < num_tokens ? log_probs[i] : 0.0f;
+            record.score = score;
+            record.finish_reason = finish_reason;
+            record.flags = HAS_SEQUENCE | (i < num_tokens ? HAS_TOKEN : 0);
+            record.final_outputs = nullptr;
+        }
+    }
+
+    // Producer: publishes all records appended since the previous commit as a single GenerationOutputs
+    void commit() {
+        if (m_write_pos == m_push_begin) {
+            // empty outputs are still delivered to unblock the consumer
+            TokenRecord& record = next_record();
+            record.flags = 0;
+            record.final_outputs = nullptr;
+        }
+        TokenRecord& last = m_tail->records[m_write_pos - 1 - m_tail_begin];
+        last.flags |= END_OF_PUSH;
+
+        m_last_push_begin.store(m_push_begin, std::memory_order_release);
+        m_committed.store(m_write_pos, std::memory_order_seq_cst);
+        m_push_begin = m_write_pos;
+
+        if (m_consumer_waiting.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_one();
+        }
+    }
+
+    void push(const GenerationOutputs& outputs) {
+        for (const auto& [sequence_id, output] : outputs) {
+            OPENVINO_ASSERT(output.generated_ids.size() == output.generated_log_probs.size());
+            append(sequence_id, output.generated_ids.data(), output.generated_log_probs.data(),
+                   output.generated_ids.size(), output.score, output.finish_reason);
+        }
+        commit();
+    }
+
+    // Producer: publishes outputs which are built by the consumer when read
+    void push_final(std::function<GenerationOutputs()> build_outputs) {
+        OPENVINO_ASSERT(m_write_pos == m_push_begin, "push_final() cannot be mixed with uncommitted records");
+        TokenRecord& record = next_record();
+        record.flags = FINAL_OUTPUTS;
+        record.final_outputs = new std::function<GenerationOutputs()>(std::move(build_outputs));
+        commit();
+    }
+
+    // Consumer: blocks until outputs are available and pops them
+    GenerationOutputs read() {
+        std::lock_guard<std::mutex> lock(m_consumer_mutex);
+        wait_for_data();
+        GenerationOutputs outputs;
+        bool end_of_push = false;
+        while (!end_of_push) {
+            const TokenRecord& record = record_to_read();
+            ++m_read_pos;
+            add_record(outputs, record, true);
+            end_of_push = record.flags & END_OF_PUSH;
+        }
+        // the records are copied, so their segments can be reused
+        m_consumed.store(m_read_pos, std::memory_order_release);
+        return outputs;
+    }
+
+    // Consumer: blocks until outputs are available and returns the latest ones without popping
+    GenerationOutputs back() {
+        std::lock_guard<std::mutex> lock(m_consumer_mutex);
+        wait_for_data();
+        // begin of the latest push is stored before its commit, so it is never behind an unread commit
+        uint64_t position = m_last_push_begin.load(std::memory_order_acquire);
+        OPENVINO_ASSERT(position >= m_read_pos);
+
+        Segment* segment = m_head;
+        uint64_t segment_begin = m_head_begin;
+        GenerationOutputs outputs;
+        bool end_of_push = false;
+        for (; !end_of_push; ++position) {
+            while (position >= segment_begin + SEGMENT_SIZE) {
+                segment = segment->next;
+                segment_begin += SEGMENT_SIZE;
+            }
+            const TokenRecord& record = segment->records[position - segment_begin];
+            add_record(outputs, record, false);
+            end_of_push = record.flags & END_OF_PUSH;
+        }
+        return outputs;
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(m_consumer_mutex);
+        return !has_data();
+    }
+};
+
+}  // namespace ov::genai
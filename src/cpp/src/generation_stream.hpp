@@ -4,15 +4,17 @@
 #pragma once
 #include <mutex>
 #include <atomic>
+#include <exception>
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "openvino/genai/generation_handle.hpp"
-#include "synchronized_queue.hpp"
+#include "generation_output_channel.hpp"
 
 namespace ov::genai {
 class GenerationStream {
     std::mutex m_mutex;
     GenerationStatus m_status = GenerationStatus::RUNNING;
-    SynchronizedQueue<GenerationOutputs> m_output_queue;
+    std::exception_ptr m_error = nullptr;
+    GenerationOutputChannel m_output_channel;
 
     std::vector<uint64_t> last_sequence_ids;
 
@@ -27,19 +29,35 @@ public:
     }
 
     void push(GenerationOutputs outputs) {
-        m_output_queue.push(std::move(outputs));
+        m_output_channel.push(outputs);
+    }
+
+    // Appends tokens of a single sequence without building GenerationOutputs, see commit()
+    void append(uint64_t sequence_id, const int64_t* token_ids, const float* log_probs, size_t num_tokens,
+                float score, GenerationFinishReason finish_reason) {
+        m_output_channel.append(sequence_id, token_ids, log_probs, num_tokens, score, finish_reason);
+    }
+
+    // Publishes tokens appended since the previous commit as a single GenerationOutputs
+    void commit() {
+        m_output_channel.commit();
+    }
+
+    // Publishes full results which are copied only when they are read
+    void push_final(std::function<GenerationOutputs()> build_outputs) {
+        m_output_channel.push_final(std::move(build_outputs));
     }
 
     // Retrieving vector of pairs <sequence_id, token_id> as we can generate multiple outputs for a single prompt
     GenerationOutputs back() {
-        return m_output_queue.back();
+        return m_output_channel.back();
     }
     GenerationOutputs read() {
-        return m_output_queue.pull();
+        return m_output_channel.read();
     }
 
     bool can_read() {
-        return !m_output_queue.empty();
+        return !m_output_channel.empty();
     }
 
     void set_generation_status(GenerationStatus status) {
@@ -56,5 +74,22 @@ public:
         std::lock_guard<std::mutex> lock(m_mutex);
         m_status = GenerationStatus::DROPPED_BY_HANDLE;
     }
+
+    // Fails a request which could not be added to the pipeline, e.g. if its prompt could not be tokenized
+    void set_error(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = error;
+        m_status = GenerationStatus::DROPPED_BY_PIPELINE;
+    }
+
+    void rethrow_if_failed() {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            error = m_error;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
 };
 }
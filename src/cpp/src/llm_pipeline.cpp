@@ -5,6 +5,8 @@
 #include <fstream>
 #include <variant>
 #include <algorithm>
+#include <numeric>
+#include <cmath>
 #include <nlohmann/json.hpp>
 #include <openvino/openvino.hpp>
 #include "openvino/genai/continuous_batching_pipeline.hpp"
@@ -14,6 +16,7 @@
 #include "llm_pipeline_base.hpp"
 #include "llm_pipeline_static.hpp"
 #include "utils.hpp"
+#include "json_utils.hpp"
 #include "text_callback_streamer.hpp"
 #include "openvino/genai/lora_adapter.hpp"
 #include "lora_helper.hpp"
@@ -33,6 +36,63 @@ std::pair<EncodedResults, int32_t> beam_search(
     std::optional<int32_t> selected_beam_idx
 );
 
+namespace {
+
+// Binary format of chat state: version followed by chat history, tokenized history and KV cache states
+constexpr char CHAT_STATE_MAGIC[] = "OVGENAI_CHAT_STATE";
+constexpr uint32_t CHAT_STATE_VERSION = 1;
+
+template <typename T>
+void write_value(std::ostream& stream, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(std::istream& stream) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    OPENVINO_ASSERT(stream.good(), "Unexpected end of chat state");
+    return value;
+}
+
+void write_string(std::ostream& stream, const std::string& value) {
+    write_value<uint64_t>(stream, value.size());
+    stream.write(value.data(), value.size());
+}
+
+std::string read_string(std::istream& stream) {
+    std::string value(read_value<uint64_t>(stream), '\0');
+    stream.read(value.data(), value.size());
+    OPENVINO_ASSERT(stream.good(), "Unexpected end of chat state");
+    return value;
+}
+
+void write_tensor(std::ostream& stream, const ov::Tensor& tensor) {
+    write_string(stream, tensor.get_element_type().to_string());
+    const ov::Shape& shape = tensor.get_shape();
+    write_value<uint64_t>(stream, shape.size());
+    for (size_t dim : shape) {
+        write_value<uint64_t>(stream, dim);
+    }
+    stream.write(static_cast<const char*>(tensor.data()), tensor.get_byte_size());
+}
+
+ov::Tensor read_tensor(std::istream& stream) {
+    ov::element::Type element_type(read_string(stream));
+    ov::Shape shape(read_value<uint64_t>(stream));
+    for (size_t& dim : shape) {
+        dim = read_value<uint64_t>(stream);
+    }
+    ov::Tensor tensor(element_type, shape);
+    stream.read(static_cast<char*>(tensor.data()), tensor.get_byte_size());
+    OPENVINO_ASSERT(stream.good(), "Unexpected end of chat state");
+    return tensor;
+}
+
+}  // namespace
+
 class StatefulLLMPipeline final : public LLMPipelineImplBase {
 public:
     ov::InferRequest m_model_runner;
@@ -43,6 +103,30 @@ public:
     ChatHistory m_history;
     std::string m_templated_chat_history = {};
     TokenizedInputs m_tokenized_chat_history;
+    // Whether the chat template only appends text for a new message to the already templated history.
+    // If so, only the new message is templated and tokenized. It's verified on the second turn of every chat.
+    std::optional<bool> m_is_chat_template_incremental = std::nullopt;
+    // Chat history compaction evicts the oldest chat turns to keep KV cache within m_max_chat_history_tokens.
+    size_t m_max_chat_history_tokens = 0;
+    size_t m_attention_sink_tokens = 4;
+    size_t m_num_system_prompt_tokens = 0;
+    // KV cache lengths at the beginning of chat turns, turns are evicted as a whole if possible
+    std::vector<size_t> m_chat_turn_starts;
+    // Number of tokens evicted from the beginning of the chat, they are removed from the re-tokenized history as well
+    size_t m_num_evicted_tokens = 0;
+    // Keys in KV cache are stored with rotary embeddings applied, so keys kept by compaction are re-rotated
+    // to their positions in the compacted KV cache and position ids of new tokens continue from its length.
+    struct RotaryEmbeddingConfig {
+        size_t head_size = 0;
+        // rotary embeddings are applied to the first rotary_dims elements of a head
+        size_t rotary_dims = 0;
+        float theta = 10000.0f;
+        // linear scaling divides positions by the factor
+        float scaling_factor = 1.0f;
+    };
+    RotaryEmbeddingConfig m_rotary_embedding_config;
+    // Batched prompts are split into buckets of similar lengths if padding exceeds the ratio
+    float m_max_padding_ratio = 1.0f;
 
     StatefulLLMPipeline(
         const ov::InferRequest& request,
@@ -62,7 +146,24 @@ public:
     ) : LLMPipelineImplBase(tokenizer, utils::from_config_json_if_exists(models_path))
     {
         ov::Core core;
-        if (auto filtered_plugin_config = extract_adapters_from_properties(plugin_config, &m_generation_config.adapters)) {
+        ov::AnyMap properties = plugin_config;
+        if (properties.find(ov::genai::max_chat_history_tokens.name()) != properties.end()) {
+            m_max_chat_history_tokens = properties.at(ov::genai::max_chat_history_tokens.name()).as<size_t>();
+            properties.erase(ov::genai::max_chat_history_tokens.name());
+        }
+        if (m_max_chat_history_tokens > 0) {
+            m_rotary_embedding_config = read_rotary_embedding_config(models_path / "config.json");
+        }
+        if (properties.find(ov::genai::attention_sink_tokens.name()) != properties.end()) {
+            m_attention_sink_tokens = properties.at(ov::genai::attention_sink_tokens.name()).as<size_t>();
+            properties.erase(ov::genai::attention_sink_tokens.name());
+        }
+        if (properties.find(ov::genai::max_padding_ratio.name()) != properties.end()) {
+            m_max_padding_ratio = properties.at(ov::genai::max_padding_ratio.name()).as<float>();
+            properties.erase(ov::genai::max_padding_ratio.name());
+        }
+
+        if (auto filtered_plugin_config = extract_adapters_from_properties(properties, &m_generation_config.adapters)) {
             auto [core_plugin_config, compile_plugin_config] = ov::genai::utils::split_core_compile_config(*filtered_plugin_config);
             core.set_property(core_plugin_config);
             auto model = core.read_model(models_path / "openvino_model.xml");
@@ -71,7 +172,7 @@ public:
             utils::slice_matmul_statefull_model(model);
             m_model_runner = core.compile_model(model, device, compile_plugin_config).create_infer_request();
         } else {
-            auto [core_plugin_config, compile_plugin_config] = ov::genai::utils::split_core_compile_config(plugin_config);
+            auto [core_plugin_config, compile_plugin_config] = ov::genai::utils::split_core_compile_config(properties);
             core.set_property(core_plugin_config);
             auto model = core.read_model(models_path / "openvino_model.xml");
             utils::slice_matmul_statefull_model(model);
@@ -87,7 +188,8 @@ public:
         const std::filesystem::path& models_path,
         const std::string& device,
         const ov::AnyMap& plugin_config
-    ) : StatefulLLMPipeline{models_path, Tokenizer(models_path.string()), device, plugin_config} {}
+    ) : StatefulLLMPipeline{models_path, Tokenizer(models_path.string(), utils::get_tokenizer_properties(plugin_config)), device,
+                            utils::remove_tokenizer_only_properties(plugin_config)} {}
 
     DecodedResults generate(
         StringInputs inputs,
@@ -114,19 +216,46 @@ public:
                 // The chat history cannot be saved as already encoded tokens because generate call doesn't return <eos> token, but
                 // KV cache contains it. So we have to add it manually or get it by tokenization all chat history.
 
+                // If the chat template is incremental, the difference is obtained directly by templating and tokenizing only
+                // the new message, and the cost of a chat turn doesn't grow with the history length.
+
                 m_history.push_back({{"role", "user"}, {"content", prompt}});
-                constexpr bool add_generation_prompt = true;
-                auto new_templated_chat_history  = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
-                // Do not add special tokens in chat scenario to be aligned with HF.
-                auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
-                if (m_is_cache_empty) {
-                    encoded_input = new_chat_tokens;
+                std::optional<std::string> new_message_template;
+                if (!m_is_cache_empty && m_is_chat_template_incremental != false) {
+                    new_message_template = apply_chat_template_to_new_message(prompt);
+                }
+
+                if (new_message_template && m_is_chat_template_incremental == true) {
+                    // Do not add special tokens in chat scenario to be aligned with HF.
+                    encoded_input = m_tokenizer.encode(*new_message_template, ov::genai::add_special_tokens(false));
+                    const int64_t* new_tokens_data = encoded_input.input_ids.data<const int64_t>();
+                    m_templated_chat_history.append(*new_message_template);
+                    m_tokenized_chat_history = utils::concatenate_chat_tokenized_inputs(m_tokenized_chat_history,
+                        std::vector<int64_t>(new_tokens_data, new_tokens_data + encoded_input.input_ids.get_size()));
                 } else {
-                    auto prev_chat_tokens = m_tokenizer.encode(m_templated_chat_history, ov::genai::add_special_tokens(false));
-                    encoded_input = utils::subtract_chat_tokenized_inputs(new_chat_tokens, prev_chat_tokens);
+                    constexpr bool add_generation_prompt = true;
+                    auto new_templated_chat_history  = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
+                    // Do not add special tokens in chat scenario to be aligned with HF.
+                    auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+                    if (m_is_cache_empty) {
+                        encoded_input = new_chat_tokens;
+                    } else {
+                        auto prev_chat_tokens = m_tokenizer.encode(m_templated_chat_history, ov::genai::add_special_tokens(false));
+                        encoded_input = utils::subtract_chat_tokenized_inputs(new_chat_tokens, prev_chat_tokens);
+                    }
+
+                    if (!m_is_cache_empty) {
+                        // Both templated text and tokens have to match, because tokenization of the new message alone
+                        // may differ from tokenization of the whole history at the boundary between them.
+                        m_is_chat_template_incremental = new_message_template &&
+                            new_templated_chat_history == m_templated_chat_history + *new_message_template &&
+                            are_tokens_equal(m_tokenizer.encode(*new_message_template, ov::genai::add_special_tokens(false)).input_ids, encoded_input.input_ids);
+                    }
+                    m_templated_chat_history = new_templated_chat_history;
+                    // the whole history is re-tokenized, so tokens already evicted from KV cache are removed again
+                    m_tokenized_chat_history = remove_chat_history_range(new_chat_tokens, get_num_kept_first_tokens(),
+                        get_num_kept_first_tokens() + m_num_evicted_tokens);
                 }
-                m_templated_chat_history = new_templated_chat_history;
-                m_tokenized_chat_history = new_chat_tokens;
                 // TODO: Forbid LoRA config change if we are in the chat mode, because it requires regenerating the history with LoRA applied
             } else {
                 encoded_input = m_tokenizer.encode(prompt);
@@ -145,6 +274,10 @@ public:
             auto answer = decoded_results.texts[0];
             m_templated_chat_history.append(answer);
             m_history.push_back({{"role", "assistant"}, {"content", answer}});
+            if (m_is_chat_template_incremental == true) {
+                // Tokenized history is not re-encoded on the next turn, so the answer is appended as generated
+                m_tokenized_chat_history = utils::concatenate_chat_tokenized_inputs(m_tokenized_chat_history, encoded_results.tokens[0]);
+            }
         }
 
         // generate_durations
@@ -163,7 +296,329 @@ public:
         return decoded_results;
     }
 
+    // Renders the text which the chat template appends to the history ending with an assistant answer for a new user message.
+    // A short probe conversation is rendered instead of the whole history, so the cost doesn't depend on the chat length.
+    // Returns std::nullopt if the probe conversation is not rendered incrementally.
+    std::optional<std::string> apply_chat_template_to_new_message(const std::string& message) {
+        const std::string probe_answer = "Hi!";
+        ChatHistory probe_history;
+        if (!m_history.empty() && m_history.front()["role"] == "system") {
+            probe_history.push_back(m_history.front());
+        }
+        probe_history.push_back({{"role", "user"}, {"content", "Hello!"}});
+        constexpr bool add_generation_prompt = true;
+        std::string probe_prefix = m_tokenizer.apply_chat_template(probe_history, add_generation_prompt) + probe_answer;
+
+        probe_history.push_back({{"role", "assistant"}, {"content", probe_answer}});
+        probe_history.push_back({{"role", "user"}, {"content", message}});
+        std::string probe_templated = m_tokenizer.apply_chat_template(probe_history, add_generation_prompt);
+        if (probe_templated.compare(0, probe_prefix.size(), probe_prefix) != 0) {
+            return std::nullopt;
+        }
+        return probe_templated.substr(probe_prefix.size());
+    }
+
+    static bool are_tokens_equal(const ov::Tensor& lhs, const ov::Tensor& rhs) {
+        return lhs.get_size() == rhs.get_size() &&
+               std::equal(lhs.data<const int64_t>(), lhs.data<const int64_t>() + lhs.get_size(), rhs.data<const int64_t>());
+    }
+
+    // Removes the range [begin, end) along the sequence axis of KV cache or attention mask tensor
+    static ov::Tensor remove_sequence_range(const ov::Tensor& tensor, size_t sequence_length, size_t begin, size_t end) {
+        ov::Shape shape = tensor.get_shape();
+        // [batch, num_heads, sequence_length, head_size] is the most common layout of KV cache
+        size_t axis = shape.size() > 2 && shape[2] == sequence_length ? 2 :
+            std::distance(shape.begin(), std::find(shape.begin(), shape.end(), sequence_length));
+        OPENVINO_ASSERT(axis < shape.size(), "Failed to find sequence axis of size ", sequence_length, " in tensor of shape ", shape);
+        OPENVINO_ASSERT(tensor.get_element_type().bitwidth() % 8 == 0, "Compaction of ", tensor.get_element_type(), " tensors is not supported");
+
+        size_t num_outer = 1, row_byte_size = tensor.get_element_type().size();
+        for (size_t i = 0; i < shape.size(); ++i) {
+            if (i < axis) {
+                num_outer *= shape[i];
+            } else if (i > axis) {
+                row_byte_size *= shape[i];
+            }
+        }
+
+        shape[axis] -= end - begin;
+        ov::Tensor compacted(tensor.get_element_type(), shape);
+        const uint8_t* src = static_cast<const uint8_t*>(tensor.data());
+        uint8_t* dst = static_cast<uint8_t*>(compacted.data());
+        for (size_t outer = 0; outer < num_outer; ++outer, src += sequence_length * row_byte_size) {
+            dst = std::copy_n(src, begin * row_byte_size, dst);
+            dst = std::copy(src + end * row_byte_size, src + sequence_length * row_byte_size, dst);
+        }
+        return compacted;
+    }
+
+    static RotaryEmbeddingConfig read_rotary_embedding_config(const std::filesystem::path& config_path) {
+        OPENVINO_ASSERT(std::filesystem::exists(config_path), "max_chat_history_tokens requires ", config_path,
+                        " to re-rotate keys kept in KV cache");
+        std::ifstream file(config_path);
+        nlohmann::json data = nlohmann::json::parse(file);
+        // models with rotary embeddings of other layouts or without them are not supported
+        OPENVINO_ASSERT(data.contains("rope_theta"), "max_chat_history_tokens is supported only for models with rotary position embeddings, "
+                        "rope_theta is not found in ", config_path);
+
+        RotaryEmbeddingConfig config;
+        utils::read_json_param(data, "rope_theta", config.theta);
+        size_t hidden_size = 0, num_attention_heads = 0;
+        utils::read_json_param(data, "hidden_size", hidden_size);
+        utils::read_json_param(data, "num_attention_heads", num_attention_heads);
+        if (num_attention_heads > 0) {
+            config.head_size = hidden_size / num_attention_heads;
+        }
+        utils::read_json_param(data, "head_dim", config.head_size);
+        OPENVINO_ASSERT(config.head_size > 0, "Failed to get head size from ", config_path);
+        float partial_rotary_factor = 1.0f;
+        utils::read_json_param(data, "partial_rotary_factor", partial_rotary_factor);
+        config.rotary_dims = static_cast<size_t>(config.head_size * partial_rotary_factor);
+
+        if (data.contains("rope_scaling") && !data["rope_scaling"].is_null()) {
+            std::string rope_type;
+            utils::read_json_param(data["rope_scaling"], "type", rope_type);
+            utils::read_json_param(data["rope_scaling"], "rope_type", rope_type);
+            OPENVINO_ASSERT(rope_type == "linear", "max_chat_history_tokens doesn't support '", rope_type, "' rotary embedding scaling");
+            utils::read_json_param(data["rope_scaling"], "factor", config.scaling_factor);
+        }
+        return config;
+    }
+
+    // Rotates keys of tokens [begin, sequence_length) by -shift positions, so they match keys computed shift positions earlier.
+    // Rotary embeddings are applied to pairs (x[i], x[i + rotary_dims / 2]) of the first rotary_dims elements of a head.
+    template <typename T>
+    void rotate_keys(ov::Tensor& keys, size_t sequence_length, size_t begin, size_t shift) const {
+        const ov::Shape& shape = keys.get_shape();
+        size_t axis = shape.size() > 2 && shape[2] == sequence_length ? 2 :
+            std::distance(shape.begin(), std::find(shape.begin(), shape.end(), sequence_length));
+        OPENVINO_ASSERT(axis + 1 < shape.size() && shape.back() == m_rotary_embedding_config.head_size,
+                        "Unexpected shape of KV cache keys ", shape, " for head size ", m_rotary_embedding_config.head_size);
+
+        const size_t head_size = m_rotary_embedding_config.head_size, half_rotary_dims = m_rotary_embedding_config.rotary_dims / 2;
+        std::vector<float> cos(half_rotary_dims), sin(half_rotary_dims);
+        for (size_t i = 0; i < half_rotary_dims; ++i) {
+            float inv_freq = std::pow(m_rotary_embedding_config.theta, -2.0f * i / m_rotary_embedding_config.rotary_dims);
+            float angle = -static_cast<float>(shift) * inv_freq / m_rotary_embedding_config.scaling_factor;
+            cos[i] = std::cos(angle);
+            sin[i] = std::sin(angle);
+        }
+
+        size_t num_outer = 1, num_heads_per_token = 1;
+        for (size_t i = 0; i + 1 < shape.size(); ++i) {
+            if (i < axis) {
+                num_outer *= shape[i];
+            } else if (i > axis) {
+                num_heads_per_token *= shape[i];
+            }
+        }
+        T* data = keys.data<T>();
+        for (size_t outer = 0; outer < num_outer; ++outer) {
+            T* head = data + (outer * sequence_length + begin) * num_heads_per_token * head_size;
+            for (size_t token_head = 0; token_head < (sequence_length - begin) * num_heads_per_token; ++token_head, head += head_size) {
+                for (size_t i = 0; i < half_rotary_dims; ++i) {
+                    float x1 = static_cast<float>(head[i]), x2 = static_cast<float>(head[i + half_rotary_dims]);
+                    head[i] = static_cast<T>(x1 * cos[i] - x2 * sin[i]);
+                    head[i + half_rotary_dims] = static_cast<T>(x2 * cos[i] + x1 * sin[i]);
+                }
+            }
+        }
+    }
+
+    void rotate_keys(ov::Tensor& keys, size_t sequence_length, size_t begin, size_t shift) const {
+        switch (keys.get_element_type()) {
+        case ov::element::f32:
+            return rotate_keys<float>(keys, sequence_length, begin, shift);
+        case ov::element::f16:
+            return rotate_keys<ov::float16>(keys, sequence_length, begin, shift);
+        case ov::element::bf16:
+            return rotate_keys<ov::bfloat16>(keys, sequence_length, begin, shift);
+        default:
+            OPENVINO_THROW("Rotation of ", keys.get_element_type(), " KV cache keys is not supported");
+        }
+    }
+
+    size_t get_num_kept_first_tokens() const {
+        return std::max(m_attention_sink_tokens, m_num_system_prompt_tokens);
+    }
+
+    // Removes the range [begin, end) of tokens from the tokenized chat history, the range is clamped to the history length
+    static TokenizedInputs remove_chat_history_range(const TokenizedInputs& history, size_t begin, size_t end) {
+        const size_t history_len = history.input_ids.get_shape().at(1);
+        begin = std::min(begin, history_len);
+        end = std::min(end, history_len);
+        if (begin == end) {
+            return history;
+        }
+        return {remove_sequence_range(history.input_ids, history_len, begin, end),
+                remove_sequence_range(history.attention_mask, history_len, begin, end)};
+    }
+
+    // Evicts the oldest chat turns from KV cache to fit a new prompt of prompt_len tokens into m_max_chat_history_tokens.
+    // The system prompt and attention sink tokens are kept. The same tokens are evicted from the tokenized chat history,
+    // which already contains the new prompt.
+    void compact_chat_history(size_t prompt_len) {
+        ov::Tensor attention_mask_history = m_model_runner.get_tensor("attention_mask");
+        const size_t kv_cache_len = attention_mask_history.get_shape().at(1);
+        if (kv_cache_len + prompt_len <= m_max_chat_history_tokens) {
+            return;
+        }
+
+        const size_t num_kept_first_tokens = std::min(kv_cache_len, get_num_kept_first_tokens());
+        size_t evict_end = std::min(kv_cache_len, num_kept_first_tokens + kv_cache_len + prompt_len - m_max_chat_history_tokens);
+        // prefer evicting whole turns, so the model doesn't see a partial message
+        auto turn_start = std::lower_bound(m_chat_turn_starts.begin(), m_chat_turn_starts.end(), evict_end);
+        if (turn_start != m_chat_turn_starts.end()) {
+            evict_end = *turn_start;
+        }
+        if (evict_end <= num_kept_first_tokens) {
+            return;
+        }
+
+        const size_t num_evicted_tokens = evict_end - num_kept_first_tokens;
+        const size_t compacted_kv_cache_len = kv_cache_len - num_evicted_tokens;
+        for (auto& state : m_model_runner.query_state()) {
+            if (!m_adapter_controller || !m_adapter_controller->has_state_name(state.get_name())) {
+                ov::Tensor compacted = remove_sequence_range(state.get_state(), kv_cache_len, num_kept_first_tokens, evict_end);
+                // variables of keys are named like past_key_values.0.keypresent.0.key
+                if (state.get_name().find(".key") != std::string::npos) {
+                    rotate_keys(compacted, compacted_kv_cache_len, num_kept_first_tokens, num_evicted_tokens);
+                }
+                state.set_state(compacted);
+            }
+        }
+        m_model_runner.set_tensor("attention_mask", remove_sequence_range(attention_mask_history, kv_cache_len, num_kept_first_tokens, evict_end));
+        m_tokenized_chat_history = remove_chat_history_range(m_tokenized_chat_history, num_kept_first_tokens, evict_end);
+
+        std::vector<size_t> chat_turn_starts;
+        for (size_t start : m_chat_turn_starts) {
+            if (start <= num_kept_first_tokens) {
+                chat_turn_starts.push_back(start);
+            } else if (start >= evict_end) {
+                chat_turn_starts.push_back(start - num_evicted_tokens);
+            }
+        }
+        m_chat_turn_starts = std::move(chat_turn_starts);
+        m_num_evicted_tokens += num_evicted_tokens;
+    }
+
+    // Splits prompts sorted by length into buckets, where padding tokens don't exceed m_max_padding_ratio of bucket tokens.
+    // Splitting a bucket again returns the bucket itself, because padding ratio only grows with shorter prompts added.
+    std::vector<std::vector<size_t>> get_prompt_buckets(const ov::Tensor& attention_mask) const {
+        const size_t batch_size = attention_mask.get_shape().at(0), sequence_length = attention_mask.get_shape().at(1);
+        const int64_t* attention_mask_data = attention_mask.data<const int64_t>();
+        std::vector<size_t> prompt_lens(batch_size);
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            const int64_t* row = attention_mask_data + batch * sequence_length;
+            prompt_lens[batch] = std::count(row, row + sequence_length, 1);
+        }
+
+        std::vector<size_t> order(batch_size);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&prompt_lens](size_t lhs, size_t rhs) {
+            return prompt_lens[lhs] > prompt_lens[rhs];
+        });
+
+        std::vector<std::vector<size_t>> buckets;
+        size_t max_len = 0, total_len = 0;
+        for (size_t batch : order) {
+            if (!buckets.empty()) {
+                size_t num_padded_tokens = (buckets.back().size() + 1) * max_len;
+                float padding_ratio = num_padded_tokens == 0 ? 0.0f : 1.0f - static_cast<float>(total_len + prompt_lens[batch]) / num_padded_tokens;
+                if (padding_ratio <= m_max_padding_ratio) {
+                    buckets.back().push_back(batch);
+                    total_len += prompt_lens[batch];
+                    continue;
+                }
+            }
+            buckets.push_back({batch});
+            max_len = total_len = prompt_lens[batch];
+        }
+        return buckets;
+    }
+
+    // Generates buckets of prompts one after another and gathers results in the original order of prompts
+    EncodedResults generate_buckets(
+        const ov::Tensor& input_ids,
+        const ov::Tensor& attention_mask,
+        const std::vector<std::vector<size_t>>& buckets,
+        OptionalGenerationConfig generation_config,
+        std::chrono::steady_clock::time_point start_time
+    ) {
+        const size_t batch_size = input_ids.get_shape().at(0), sequence_length = input_ids.get_shape().at(1);
+        const int64_t* input_ids_data = input_ids.data<const int64_t>();
+        const int64_t* attention_mask_data = attention_mask.data<const int64_t>();
+        const int64_t pad_token_id = m_tokenizer.get_pad_token_id();
+
+        std::vector<std::vector<std::vector<int64_t>>> prompt_tokens(batch_size);
+        std::vector<std::vector<float>> prompt_scores(batch_size);
+        EncodedResults results;
+        for (size_t bucket_id = 0; bucket_id < buckets.size(); ++bucket_id) {
+            const auto& bucket = buckets[bucket_id];
+            std::vector<std::vector<int64_t>> bucket_prompts;
+            size_t max_len = 0;
+            for (size_t batch : bucket) {
+                std::vector<int64_t>& prompt = bucket_prompts.emplace_back();
+                for (size_t i = batch * sequence_length; i < (batch + 1) * sequence_length; ++i) {
+                    if (attention_mask_data[i] == 1) {
+                        prompt.push_back(input_ids_data[i]);
+                    }
+                }
+                max_len = std::max(max_len, prompt.size());
+            }
+
+            // prompts are padded from the left as tokenizer does
+            ov::Tensor bucket_input_ids(ov::element::i64, {bucket.size(), max_len});
+            ov::Tensor bucket_attention_mask(ov::element::i64, {bucket.size(), max_len});
+            for (size_t row = 0; row < bucket.size(); ++row) {
+                const size_t num_pad_tokens = max_len - bucket_prompts[row].size();
+                int64_t* row_input_ids = bucket_input_ids.data<int64_t>() + row * max_len;
+                int64_t* row_attention_mask = bucket_attention_mask.data<int64_t>() + row * max_len;
+                std::fill_n(row_input_ids, num_pad_tokens, pad_token_id);
+                std::copy(bucket_prompts[row].begin(), bucket_prompts[row].end(), row_input_ids + num_pad_tokens);
+                std::fill_n(row_attention_mask, num_pad_tokens, 0);
+                std::fill_n(row_attention_mask + num_pad_tokens, max_len - num_pad_tokens, 1);
+            }
+
+            EncodedResults bucket_results = generate(TokenizedInputs{bucket_input_ids, bucket_attention_mask}, generation_config, std::monostate{});
+            OPENVINO_ASSERT(bucket_results.tokens.size() % bucket.size() == 0, "Expected the same number of results for every prompt");
+            const size_t num_results_per_prompt = bucket_results.tokens.size() / bucket.size();
+            for (size_t row = 0; row < bucket.size(); ++row) {
+                for (size_t i = row * num_results_per_prompt; i < (row + 1) * num_results_per_prompt; ++i) {
+                    prompt_tokens[bucket[row]].push_back(std::move(bucket_results.tokens[i]));
+                    prompt_scores[bucket[row]].push_back(bucket_results.scores[i]);
+                }
+            }
+
+            if (bucket_id == 0) {
+                results.perf_metrics = bucket_results.perf_metrics;
+            } else {
+                auto& raw_metrics = results.perf_metrics.raw_metrics;
+                const auto& bucket_raw_metrics = bucket_results.perf_metrics.raw_metrics;
+                raw_metrics.m_new_token_times.insert(raw_metrics.m_new_token_times.end(), bucket_raw_metrics.m_new_token_times.begin(), bucket_raw_metrics.m_new_token_times.end());
+                raw_metrics.m_batch_sizes.insert(raw_metrics.m_batch_sizes.end(), bucket_raw_metrics.m_batch_sizes.begin(), bucket_raw_metrics.m_batch_sizes.end());
+                raw_metrics.m_token_infer_durations.insert(raw_metrics.m_token_infer_durations.end(), bucket_raw_metrics.m_token_infer_durations.begin(), bucket_raw_metrics.m_token_infer_durations.end());
+                raw_metrics.m_inference_durations[0] += bucket_raw_metrics.m_inference_durations[0];
+                results.perf_metrics.num_input_tokens += bucket_results.perf_metrics.num_input_tokens;
+            }
+        }
+
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            std::move(prompt_tokens[batch].begin(), prompt_tokens[batch].end(), std::back_inserter(results.tokens));
+            results.scores.insert(results.scores.end(), prompt_scores[batch].begin(), prompt_scores[batch].end());
+        }
+
+        auto& raw_metrics = results.perf_metrics.raw_metrics;
+        raw_metrics.m_durations.clear();
+        raw_metrics.generate_durations = {MicroSeconds(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - start_time))};
+        results.perf_metrics.m_evaluated = false;
+        results.perf_metrics.evaluate_statistics(start_time);
+        return results;
+    }
+
     void reset_kv_state() {
+        m_chat_turn_starts.clear();
+        m_num_evicted_tokens = 0;
         if(m_adapter_controller) {
             for(auto& state: m_model_runner.query_state()) {
                 if(!m_adapter_controller->has_state_name(state.get_name())) {
@@ -191,6 +646,13 @@ public:
             attention_mask = data->attention_mask;
         }
 
+        if (!is_chat_conversation && m_max_padding_ratio < 1.0f && input_ids.get_shape().at(0) > 1 && std::holds_alternative<std::monostate>(streamer)) {
+            auto buckets = get_prompt_buckets(attention_mask);
+            if (buckets.size() > 1) {
+                return generate_buckets(input_ids, attention_mask, buckets, generation_config, start_time);
+            }
+        }
+
         GenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
 
         // If eos_token_id was not provided, take value from default m_generation_config
@@ -227,6 +689,10 @@ public:
         ov::Tensor concatenated_attention_mask;
         if (is_chat_conversation && !m_is_cache_empty) {
             OPENVINO_ASSERT(batch_size == 1, "continuation of generation is possible only for batch 1");
+            if (m_max_chat_history_tokens > 0) {
+                compact_chat_history(attention_mask.get_shape()[1]);
+                m_chat_turn_starts.push_back(m_model_runner.get_tensor("attention_mask").get_shape()[1]);
+            }
             // If history is saved in KV cache, concatenate new attention_mask with the already existing.
             // Between subsequent runs attention_mask should not be modified.
             auto atten_mask_history = m_model_runner.get_tensor("attention_mask");
@@ -306,6 +772,8 @@ public:
     void start_chat(const std::string& system_message) override {
         is_chat_conversation = true;
         m_selected_beam  = std::nullopt;
+        m_is_chat_template_incremental = std::nullopt;
+        m_num_system_prompt_tokens = 0;
         if (!m_is_cache_empty) {
             reset_kv_state();
             m_is_cache_empty = true;
@@ -319,11 +787,110 @@ public:
         constexpr bool add_generation_prompt = false;
 
         m_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
+        if (m_max_chat_history_tokens > 0) {
+            m_num_system_prompt_tokens = m_tokenizer.encode(m_templated_chat_history, ov::genai::add_special_tokens(false)).input_ids.get_size();
+        }
+    }
+
+    void save_chat_state(std::ostream& stream) override {
+        OPENVINO_ASSERT(is_chat_conversation, "Chat state can be saved only between start_chat and finish_chat");
+
+        stream.write(CHAT_STATE_MAGIC, sizeof(CHAT_STATE_MAGIC));
+        write_value(stream, CHAT_STATE_VERSION);
+
+        write_value<uint64_t>(stream, m_history.size());
+        for (const auto& message : m_history) {
+            write_value<uint64_t>(stream, message.size());
+            for (const auto& [key, value] : message) {
+                write_string(stream, key);
+                write_string(stream, value);
+            }
+        }
+        write_string(stream, m_templated_chat_history);
+        write_value<int8_t>(stream, m_is_chat_template_incremental ? *m_is_chat_template_incremental : -1);
+        write_value<uint64_t>(stream, m_num_system_prompt_tokens);
+
+        write_value<uint8_t>(stream, m_is_cache_empty);
+        if (!m_is_cache_empty) {
+            write_value<int32_t>(stream, m_selected_beam.value_or(0));
+            write_tensor(stream, m_tokenized_chat_history.input_ids);
+            write_tensor(stream, m_model_runner.get_tensor("attention_mask"));
+            write_value<uint64_t>(stream, m_num_evicted_tokens);
+            write_value<uint64_t>(stream, m_chat_turn_starts.size());
+            for (size_t start : m_chat_turn_starts) {
+                write_value<uint64_t>(stream, start);
+            }
+
+            std::vector<ov::VariableState> states;
+            for (auto& state : m_model_runner.query_state()) {
+                // adapters are applied on every generate call
+                if (!m_adapter_controller || !m_adapter_controller->has_state_name(state.get_name())) {
+                    states.push_back(state);
+                }
+            }
+            write_value<uint64_t>(stream, states.size());
+            for (auto& state : states) {
+                write_string(stream, state.get_name());
+                write_tensor(stream, state.get_state());
+            }
+        }
+        OPENVINO_ASSERT(stream.good(), "Failed to write chat state");
+    }
+
+    void load_chat_state(std::istream& stream) override {
+        char magic[sizeof(CHAT_STATE_MAGIC)];
+        stream.read(magic, sizeof(magic));
+        OPENVINO_ASSERT(stream.good() && std::equal(magic, magic + sizeof(magic), CHAT_STATE_MAGIC), "Stream doesn't contain chat state");
+        uint32_t version = read_value<uint32_t>(stream);
+        OPENVINO_ASSERT(version == CHAT_STATE_VERSION, "Unsupported chat state version ", version);
+
+        start_chat({});
+        m_history = ChatHistory(read_value<uint64_t>(stream));
+        for (auto& message : m_history) {
+            for (size_t num_fields = read_value<uint64_t>(stream); num_fields > 0; --num_fields) {
+                std::string key = read_string(stream);
+                message[key] = read_string(stream);
+            }
+        }
+        m_templated_chat_history = read_string(stream);
+        int8_t is_chat_template_incremental = read_value<int8_t>(stream);
+        if (is_chat_template_incremental >= 0) {
+            m_is_chat_template_incremental = is_chat_template_incremental == 1;
+        }
+        m_num_system_prompt_tokens = read_value<uint64_t>(stream);
+
+        if (read_value<uint8_t>(stream) == 0) {
+            m_selected_beam = read_value<int32_t>(stream);
+            ov::Tensor input_ids = read_tensor(stream);
+            m_tokenized_chat_history = {input_ids, ov::genai::utils::init_attention_mask(input_ids)};
+            m_model_runner.set_tensor("attention_mask", read_tensor(stream));
+            m_num_evicted_tokens = read_value<uint64_t>(stream);
+            m_chat_turn_starts.resize(read_value<uint64_t>(stream));
+            for (size_t& start : m_chat_turn_starts) {
+                start = read_value<uint64_t>(stream);
+            }
+
+            std::map<std::string, ov::Tensor> saved_states;
+            for (size_t num_states = read_value<uint64_t>(stream); num_states > 0; --num_states) {
+                std::string name = read_string(stream);
+                saved_states[name] = read_tensor(stream);
+            }
+            for (auto& state : m_model_runner.query_state()) {
+                if (m_adapter_controller && m_adapter_controller->has_state_name(state.get_name())) {
+                    continue;
+                }
+                auto saved_state = saved_states.find(state.get_name());
+                OPENVINO_ASSERT(saved_state != saved_states.end(), "Chat state doesn't contain state ", state.get_name(), " of the model");
+                state.set_state(saved_state->second);
+            }
+            m_is_cache_empty = false;
+        }
     }
 
     void finish_chat() override {
         is_chat_conversation = false;
         m_selected_beam = std::nullopt;
+        m_is_chat_template_incremental = std::nullopt;
         if (!m_is_cache_empty) {
             reset_kv_state();
             m_is_cache_empty = true;
@@ -436,12 +1003,12 @@ public:
         const SchedulerConfig& scheduler_config,
         const std::string& device,
         const ov::AnyMap& plugin_config
-    ): LLMPipelineImplBase{Tokenizer(models_path.string())}, m_impl{
+    ): LLMPipelineImplBase{Tokenizer(models_path.string(), utils::get_tokenizer_properties(plugin_config))}, m_impl{
         models_path.string(),
         m_tokenizer,
         scheduler_config,
         device,
-        plugin_config} {
+        utils::remove_tokenizer_only_properties(plugin_config)} {
         m_generation_config = m_impl.get_config();
     }
 
@@ -613,6 +1180,26 @@ void ov::genai::LLMPipeline::finish_chat() {
     m_pimpl->finish_chat();
 }
 
+void ov::genai::LLMPipeline::save_chat_state(std::ostream& stream) {
+    m_pimpl->save_chat_state(stream);
+}
+
+void ov::genai::LLMPipeline::save_chat_state(const std::filesystem::path& path) {
+    std::ofstream stream(path, std::ios::binary);
+    OPENVINO_ASSERT(stream.is_open(), "Failed to open ", path, " for writing");
+    m_pimpl->save_chat_state(stream);
+}
+
+void ov::genai::LLMPipeline::load_chat_state(std::istream& stream) {
+    m_pimpl->load_chat_state(stream);
+}
+
+void ov::genai::LLMPipeline::load_chat_state(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    OPENVINO_ASSERT(stream.is_open(), "Failed to open ", path, " for reading");
+    m_pimpl->load_chat_state(stream);
+}
+
 void ov::genai::LLMPipeline::set_generation_config(const GenerationConfig& config) {
     int64_t default_eos_token_id = m_pimpl->m_generation_config.eos_token_id;
     m_pimpl->m_generation_config = config;
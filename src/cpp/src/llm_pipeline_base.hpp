@@ -32,6 +32,14 @@ public:
     virtual void start_chat(const std::string& system_message) = 0;
     virtual void finish_chat() = 0;
 
+    virtual void save_chat_state(std::ostream& stream) {
+        OPENVINO_THROW("Saving of chat state is not supported by this pipeline");
+    }
+
+    virtual void load_chat_state(std::istream& stream) {
+        OPENVINO_THROW("Loading of chat state is not supported by this pipeline");
+    }
+
     virtual ~LLMPipelineImplBase() = default;
 
     Tokenizer m_tokenizer;
@@ -681,7 +681,8 @@ StaticLLMPipeline::StaticLLMPipeline(
     const std::filesystem::path& models_path,
     const std::string& device,
     const ov::AnyMap& properties
-) : StaticLLMPipeline(models_path, Tokenizer(models_path), device, properties) {
+) : StaticLLMPipeline(models_path, Tokenizer(models_path, utils::get_tokenizer_properties(properties)), device,
+                        utils::remove_tokenizer_only_properties(properties)) {
 }
 
 void StaticLLMPipeline::setupAndCompileModels(
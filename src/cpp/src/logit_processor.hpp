@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "openvino/genai/generation_config.hpp"
+#include "structured_output/token_automaton.hpp"
 
 struct Token {
     float m_log_prob = 0.;
@@ -305,11 +306,85 @@ public:
 };
 
 
+class StructuredOutputTransform : public ILogitTransformer {
+public:
+    StructuredOutputTransform(const std::shared_ptr<ov::genai::TokenAutomaton>& automaton, const std::set<int64_t>& stop_token_ids) :
+        m_automaton(automaton), m_stop_token_ids(stop_token_ids) {}
+
+    // Moves the automaton to the state after the first `num_tokens` generated tokens of a sequence
+    void set_sequence(uint64_t sequence_id, const TokenIds& generated_ids, size_t num_tokens) {
+        SequenceState& sequence = m_sequences[sequence_id];
+        if (sequence.states.empty())
+            sequence.states.push_back(m_automaton->get_initial_state());
+
+        // tokens may be removed or replaced by speculative decoding or stop strings
+        size_t num_matched = 0;
+        while (num_matched < num_tokens && num_matched < sequence.token_ids.size() && sequence.token_ids[num_matched] == generated_ids[num_matched])
+            ++num_matched;
+        sequence.token_ids.resize(num_matched);
+        sequence.states.resize(num_matched + 1);
+
+        for (size_t i = num_matched; i < num_tokens; ++i) {
+            sequence.token_ids.push_back(generated_ids[i]);
+            sequence.states.push_back(m_automaton->advance(sequence.states.back(), generated_ids[i]));
+        }
+        m_current_state = sequence.states.back();
+    }
+
+    void apply(Logits& logits) override {
+        // stop tokens are decided per request, as automatons are shared
+        std::vector<float> stop_token_logits;
+        for (int64_t stop_token_id : m_stop_token_ids)
+            stop_token_logits.push_back(logits.m_data[stop_token_id]);
+
+        const TokenAutomaton::Mask& mask = m_automaton->get_allowed_tokens(m_current_state);
+        const float min_logit = -std::numeric_limits<float>::infinity();
+        bool any_allowed = false;
+        // logits may be padded beyond the tokenizer's vocab, such tokens are never allowed
+        for (size_t word_idx = 0; word_idx * 64 < logits.m_size; ++word_idx) {
+            const uint64_t word = word_idx < mask.size() ? mask[word_idx] : 0;
+            float* data = logits.m_data + word_idx * 64;
+            const size_t word_size = std::min<size_t>(64, logits.m_size - word_idx * 64);
+            any_allowed |= word != 0;
+            if (word == ~uint64_t(0) && word_size == 64)
+                continue;
+            if (word == 0) {
+                std::fill(data, data + word_size, min_logit);
+                continue;
+            }
+            for (size_t bit = 0; bit < word_size; ++bit)
+                data[bit] = (word >> bit) & 1 ? data[bit] : min_logit;
+        }
+
+        // stop tokens are allowed when the text is complete, or if nothing else can be generated
+        if (m_automaton->is_accepting(m_current_state) || !any_allowed) {
+            size_t i = 0;
+            for (int64_t stop_token_id : m_stop_token_ids)
+                logits.m_data[stop_token_id] = stop_token_logits[i++];
+        }
+    }
+
+protected:
+    using TokenAutomaton = ov::genai::TokenAutomaton;
+
+    struct SequenceState {
+        TokenIds token_ids;
+        // states[i] is a state after the first i tokens
+        std::vector<int32_t> states;
+    };
+
+    std::shared_ptr<TokenAutomaton> m_automaton;
+    std::set<int64_t> m_stop_token_ids;
+    std::map<uint64_t, SequenceState> m_sequences;
+    int32_t m_current_state = TokenAutomaton::DEAD_STATE;
+};
+
 } // namespace LogitTransformers
 
 class LogitProcessor {
 protected:
     std::vector<std::shared_ptr<LogitTransformers::ILogitTransformer>> m_logit_transformers;
+    std::shared_ptr<LogitTransformers::StructuredOutputTransform> m_structured_output = nullptr;
     
     std::shared_ptr<std::map<int64_t, size_t>> m_unique_generated_token_ids = std::shared_ptr<std::map<int64_t, size_t>>(new std::map<int64_t, size_t>);
     std::shared_ptr<std::set<int64_t>> m_unique_prompt_token_ids = std::shared_ptr<std::set<int64_t>>(new std::set<int64_t>);
@@ -321,7 +396,8 @@ protected:
 
 public:
     LogitProcessor(const ov::genai::GenerationConfig& sampling_params,
-                   const LogitTransformers::TokenIds& input_ids) {
+                   const LogitTransformers::TokenIds& input_ids,
+                   const std::shared_ptr<ov::genai::TokenAutomaton>& structured_output_automaton = nullptr) {
         for (const auto& input_id : input_ids) {
             m_unique_prompt_token_ids->insert(input_id);
         }
@@ -354,6 +430,12 @@ public:
                 m_logit_transformers.push_back(transformer);
             }
 
+            // masks raw logits, so it must precede temperature and top_p / top_k filtering
+            if (structured_output_automaton) {
+                m_structured_output = std::make_shared<LogitTransformers::StructuredOutputTransform>(structured_output_automaton, sampling_params.stop_token_ids);
+                m_logit_transformers.push_back(m_structured_output);
+            }
+
             if (sampling_params.is_multinomial()) {
                 m_logit_transformers.emplace_back(new LogitTransformers::TemperatureLogitTransform(sampling_params.temperature));
                 if (sampling_params.top_p != 1.0f) {
@@ -381,6 +463,12 @@ public:
         }
     }
 
+    // sets the sequence which the next apply() is called for, only structured output depends on it
+    void set_current_sequence(uint64_t sequence_id, const LogitTransformers::TokenIds& generated_ids, size_t num_generated_tokens) {
+        if (m_structured_output)
+            m_structured_output->set_sequence(sequence_id, generated_ids, num_generated_tokens);
+    }
+
     void update_generated_len(size_t updated_len) {
         m_generated_tokens = updated_len;
     }
@@ -2,22 +2,45 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <numeric>
 #include <set>
 #include <map>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <regex>
 #include <optional>
 
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "openvino/core/parallel.hpp"
+#include "openvino/core/rt_info.hpp"
+#include "openvino/core/type/bfloat16.hpp"
+#include "openvino/core/type/float16.hpp"
 #include "openvino/op/add.hpp"
 #include "openvino/op/multiply.hpp"
+#include "openvino/op/subtract.hpp"
 #include "openvino/op/matmul.hpp"
 #include "openvino/op/convert.hpp"
 #include "openvino/op/convolution.hpp"
 #include "openvino/op/matmul.hpp"
 #include "openvino/op/concat.hpp"
 #include "openvino/op/reshape.hpp"
+#include "openvino/op/gather.hpp"
+#include "openvino/op/unsqueeze.hpp"
+#include "openvino/op/parameter.hpp"
 #include "openvino/op/broadcast.hpp"
 #include "openvino/op/read_value.hpp"
 #include "openvino/op/assign.hpp"
@@ -27,11 +50,15 @@
 #include "openvino/pass/pattern/op/wrap_type.hpp"
 #include "openvino/pass/graph_rewrite.hpp"
 #include "openvino/pass/manager.hpp"
+#include "openvino/runtime/properties.hpp"
 
 #include "openvino/genai/lora_adapter.hpp"
 
 #include "utils.hpp"
+#include "lora_helper.hpp"
 #include "lora_names_mapping.hpp"
+#include "lora_quantization.hpp"
+#include "size_bounded_lru_cache.hpp"
 
 extern "C" {
     #include "safetensors.h"
@@ -50,10 +77,10 @@ using NodePtr = std::shared_ptr<ov::Node>;
 using ov::NodeVector;
 using namespace ov::op;
 
-// FIXME: Use ov::AlignedBuffer instead of std::vector. ov::AlignedBuffer is not available in public OV API
-using Buffer = std::vector<char>;
-using BufferPtr = std::shared_ptr<Buffer>;
 using ConstantVector = std::vector<std::shared_ptr<v0::Constant>>;
+using ov::genai::get_quantization_range;
+using ov::genai::get_element;
+using ov::genai::quantize_weights;
 
 
 // Holds usual LoRA parameters alpha, A and B of a given type.
@@ -75,22 +102,88 @@ using LoRAPartsParser = LoRAParts<std::function<std::optional<std::string>(const
 using LoRATensors = std::map<std::string, LoRAWeight>;
 
 
-// Read binary file to memory.
-BufferPtr read_file_helper(const std::filesystem::path& filename) {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    OPENVINO_ASSERT(file.is_open(), "Cannot open file with LoRA weights: ", filename);
+// Read-only memory mapping of a whole file, the mapping is released in the destructor.
+// Pages are loaded by OS on demand and can be evicted under memory pressure without swapping,
+// so LoRA weights that are never touched or fused once don't stay in the process memory.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& filename) {
+        // destructor isn't called if the constructor throws, so already opened handles are released here
+        try {
+#ifdef _WIN32
+            m_file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            OPENVINO_ASSERT(m_file != INVALID_HANDLE_VALUE, "Cannot open file with LoRA weights: ", filename);
+            LARGE_INTEGER filesize;
+            OPENVINO_ASSERT(GetFileSizeEx(m_file, &filesize), "Cannot get size of file with LoRA weights: ", filename);
+            m_size = static_cast<size_t>(filesize.QuadPart);
+            if (m_size > 0) {
+                m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                OPENVINO_ASSERT(m_mapping != nullptr, "Cannot map file with LoRA weights: ", filename);
+                m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+                OPENVINO_ASSERT(m_data != nullptr, "Cannot map file with LoRA weights: ", filename);
+            }
+#else
+            m_file = open(filename.c_str(), O_RDONLY);
+            OPENVINO_ASSERT(m_file != -1, "Cannot open file with LoRA weights: ", filename);
+            struct stat file_stat;
+            OPENVINO_ASSERT(fstat(m_file, &file_stat) == 0, "Cannot get size of file with LoRA weights: ", filename);
+            m_size = static_cast<size_t>(file_stat.st_size);
+            if (m_size > 0) {
+                void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+                OPENVINO_ASSERT(data != MAP_FAILED, "Cannot map file with LoRA weights: ", filename);
+                m_data = data;
+            }
+#endif
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
 
-    size_t filesize = file.tellg();
-    auto buffer = std::make_shared<Buffer>(filesize);
-    file.seekg(0, std::ios::beg);
-    // TODO: Use mmapped AlignedBuffer as ov::Core::read_model can do, necessary functionality is not available in public OV API.
-    // LoRA files do not usually have huge size in comparison to the base models, but it can vary depending on adapter,
-    // and using mmap will help to optimize memory consumption and could be critical
-    // when the application at the edge of available memory that is not really uncommon for applications dealing with LLMs.
-    file.read(&(*buffer)[0], filesize);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
 
-    return buffer;
-}
+    ~MappedFile() {
+        release();
+    }
+
+    // Memory is mapped as read-only, the pointer is not constant only because safetensors and ov::Tensor require it.
+    char* data() const { return static_cast<char*>(m_data); }
+    size_t size() const { return m_size; }
+
+private:
+    void release() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+        if (m_file != -1) {
+            close(m_file);
+        }
+#endif
+    }
+
+    void* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+};
+
+using MappedFilePtr = std::shared_ptr<MappedFile>;
 
 
 // Converts Safetensors element type to OV element type. Only part of the types are supported.
@@ -122,16 +215,16 @@ struct AutoSafetensor: public safetensors_File {
 
 
 // Reads a file with a given filename expecting Safetensors file format.
-// The data is read to a solid memory block and the function returns a map of OV Constants allocated on top of that block.
-// The key in the map is a tensor name and the Constant uses a region of memory from the memory block.
-// Each Constant holds a shared pointer to the block in the runtime info.
-// The memory block will be deallocated when the last Constant is destroyed.
+// The file is mapped to memory read-only and the function returns a map of OV Constants allocated on top of the mapping.
+// The key in the map is a tensor name and the Constant uses a region of memory from the mapping.
+// Each Constant holds a shared pointer to the mapping in the runtime info.
+// The file will be unmapped when the last Constant is destroyed.
 ConstantMap read_safetensors(const std::filesystem::path& filename) {
-    auto buffer = read_file_helper(filename);
+    auto buffer = std::make_shared<MappedFile>(filename);
     AutoSafetensor safe_tensors_file{};
 
     OPENVINO_ASSERT(
-        safetensors_file_init(&(*buffer)[0], buffer->size(), &safe_tensors_file) == nullptr,
+        buffer->size() > 0 && safetensors_file_init(buffer->data(), buffer->size(), &safe_tensors_file) == nullptr,
         "Cannot parse ", filename, " as a Safetensors file format. Safetensors file format is supported only"
     );
 
@@ -150,7 +243,7 @@ ConstantMap read_safetensors(const std::filesystem::path& filename) {
         auto type = safetensors_to_ov_element_type(tensor.dtype);
         auto constant =
             std::make_shared<v0::Constant>(type, shape, ptr, nullptr);      // wraps existing memory, no ownership
-        constant->get_rt_info()["__safetensors_buffer_holder"] = buffer;    // to automatically deallocate underlying memory buffer when last constant that holds it is destroyed
+        constant->get_rt_info()["__safetensors_buffer_holder"] = buffer;    // to automatically unmap the file when last constant that holds it is destroyed
         tensors[name] = constant;
     }
     return tensors;
@@ -241,7 +334,6 @@ struct LoRAParameters {
     ov::Dimension rank;         // accumulated LoRA rank, could be dynamic if rank is not known or DYNAMIC mode is applied
     ov::element::Type type;     // element type of a tensor that will be applied to the model, negotiated based on multiple LoRA adapters
     bool fine_grained_alpha;    // use 1D tensor of the same rank for alpha instead of a scalar to blend multiple weighted LoRAs
-    // TODO: flag to have various alphas over the batch
 };
 
 using LoRAParametersGetter = std::function<std::optional<LoRAParameters>(NodePtr node)>;
@@ -391,14 +483,18 @@ using LoRAVarMap = std::map<std::string, LoRAVarIDs>;
 
 // Creates ReadValue and Assign nodes to inject LoRA tensors as variables for a given node but
 // doesn't connect them to the model returning as LoRANode instance.
+// If token_config_ids is set, alpha variable is a table with a row per adapter config, and a row is gathered for every token
+// to have various alphas over the batch.
 struct LoRAWeightStateGetter {
     LoRAParametersGetter params_getter;
     std::shared_ptr<ov::Model> model;
     LoRAVarMap& variable_ids;
+    std::shared_ptr<v0::Parameter> token_config_ids;
     // TODO: Use variable indices instead of variable_id for faster search for a state tensor
 
-    LoRAWeightStateGetter (const LoRAParametersGetter& params_getter, std::shared_ptr<ov::Model> model, LoRAVarMap& variable_ids) :
-        params_getter(params_getter), model(model), variable_ids(variable_ids) {}
+    LoRAWeightStateGetter (const LoRAParametersGetter& params_getter, std::shared_ptr<ov::Model> model, LoRAVarMap& variable_ids,
+                           std::shared_ptr<v0::Parameter> token_config_ids = nullptr) :
+        params_getter(params_getter), model(model), variable_ids(variable_ids), token_config_ids(token_config_ids) {}
 
     std::optional<LoRANode> operator() (NodePtr node) const {
         if(auto params = params_getter(node)) {
@@ -423,11 +519,22 @@ struct LoRAWeightStateGetter {
             // FIXME: No guarantees on ordering of state in InferRequest makes impossible using indices of variables later, forced to use variable_id instead
             //indices.A = model->get_variables().size();
             var_ids.alpha = ov::op::util::VariableInfo{
-                params->fine_grained_alpha ? ov::PartialShape{1, params->rank} : ov::PartialShape{},
+                token_config_ids ? ov::PartialShape{-1, params->rank} :
+                    params->fine_grained_alpha ? ov::PartialShape{1, params->rank} : ov::PartialShape{},
                 ov::element::f32,   // alpha is always f32 because it is set from host as float data type
                 variable_id_prefix + ".alpha"
             };
             result.alpha = add_variable(var_ids.alpha);
+            if(token_config_ids) {
+                result.alpha = std::make_shared<v8::Gather>(result.alpha, token_config_ids, v0::Constant::create(ov::element::i32, ov::Shape{}, {0}));
+                // Tokens are the outermost dimension of activations, LoRA rank is the innermost one
+                auto target_rank = node->get_output_partial_shape(0).rank().get_length();
+                if(target_rank > 2) {
+                    std::vector<int64_t> axes(target_rank - 2);
+                    std::iota(axes.begin(), axes.end(), 1);
+                    result.alpha = std::make_shared<v0::Unsqueeze>(result.alpha, v0::Constant::create(ov::element::i64, ov::Shape{axes.size()}, axes));
+                }
+            }
             // FIXME: No guarantees on ordering of state in InferRequest makes impossible using indices of variables later, forced to use variable_id instead
             //indices.B = model->get_variables().size();
             var_ids.B = ov::op::util::VariableInfo{
@@ -528,7 +635,8 @@ NodePtr tensors_multiplication(NodePtr input, const NodeVector multipliers, ov::
                 input->get_rt_info()["decompression"];
             }
         }
-        if(normalized->get_output_partial_shape(0).rank().get_length() > 2) {
+        // alpha gathered per token is already aligned with the rank of activations
+        if(i != alpha_pos && normalized->get_output_partial_shape(0).rank().get_length() > 2) {
             // FIXME: Any other shape patterns possible?
             normalized = squeeze_2d(normalized);
         }
@@ -560,30 +668,15 @@ NodePtr tensors_multiplication(NodePtr input, const NodeVector multipliers, ov::
 }
 
 
-// Taking a node detects an optional weight decompression pattern Constant -> Convert.
-// Returns a pointer to Convert node if it exists, or nullptr if there is no Convert.
-// If unsupported decompression pattern is used, throws an exception.
-NodePtr decompression_convert (NodePtr node) {
-    auto convert = std::dynamic_pointer_cast<v0::Convert>(node);
-    if(convert) {
-        node = convert->get_input_node_shared_ptr(0);
-    }
-    OPENVINO_ASSERT(
-        std::dynamic_pointer_cast<v0::Constant>(node),
-        "Not supported decompression pattern at the weight input (presumably low-bit compression). Use f32/f16/bf16 weights only."
-    );
-    return convert;
-}
-
-
 // Cache of infer request for on-demand build and compiled helper models for weight modification.
 // It maps a model signature which is an arbitrary string to OpenVINO infer request.
 // Defines `evaluate` method that compute a model by a given signature and input tensors.
 class InferRequestSignatureCache {
 
-    // Infer request with additional input-output pairs that are bypassed from input to output to eliminate Parameter -> Result pairs from the OV model
+    // Infer requests with additional input-output pairs that are bypassed from input to output to eliminate Parameter -> Result pairs from the OV model
     struct RequestWithBypass {
-        ov::InferRequest request;
+        ov::CompiledModel compiled_model;
+        std::vector<ov::InferRequest> idle_requests;    // requests that are not used by any thread at the moment
         std::vector<std::pair<size_t, size_t>> bypass; // a set of index pairs [j, k], where j is an index of input tensor to be forwarded to k-th output tensor
         std::vector<size_t> inputs; // inputs[i] gives an index in the original input tensor vector to be set to i-th input of the request
         std::vector<size_t> outputs;  // outputs[i] gives an index in the original output tensor vector to be set as an i-th output of the request
@@ -592,7 +685,7 @@ class InferRequestSignatureCache {
 public:
     using Signature = std::string;
 
-    InferRequestSignatureCache (const std::string& device) : device(device) {}
+    InferRequestSignatureCache (const std::string& device, const ov::AnyMap& properties = {}) : device(device), properties(properties) {}
 
     bool exist (const Signature& signature) {
         return requests.count(signature);
@@ -637,19 +730,21 @@ public:
 
         ov::Core core = ov::genai::utils::singleton_core();
         auto model = std::make_shared<ov::Model>(request_results, request_parameters);
-        rwb.request = core.compile_model(model, device).create_infer_request();
+        rwb.compiled_model = core.compile_model(model, device, properties);
+        rwb.idle_requests.push_back(rwb.compiled_model.create_infer_request());
         requests.emplace(signature, rwb);
     }
 
+    // Can be called from multiple threads simultaneously if no signatures are inserted at the same time,
+    // each thread takes a separate infer request.
     void evaluate(const Signature& signature, const ov::TensorVector& inputs, ov::TensorVector& outputs) {
         auto& rwb = at(signature);
-        auto request = rwb.request;
-        auto compiled_model = request.get_compiled_model();
+        auto request = acquire_request(rwb);
         for(size_t i = 0; i < rwb.inputs.size(); ++i) {
             request.set_input_tensor(i, inputs[rwb.inputs[i]]);
         }
         for(size_t i = 0; i < rwb.outputs.size(); ++i) {
-            auto target_shape = request.get_compiled_model().output(i).get_partial_shape();
+            auto target_shape = rwb.compiled_model.output(i).get_partial_shape();
             auto& output_tensor = outputs[rwb.outputs[i]];
             if(target_shape != output_tensor.get_shape() && target_shape.is_static()) {
                 // do it for static case only, because if target shape is dynamic, the plugin is allowed to set shape on its own
@@ -660,7 +755,8 @@ public:
         for(auto bypass: rwb.bypass) {
             outputs[bypass.second] = inputs[bypass.first];
         }
-        request.infer();    // TODO: Consider using async to increase throughput, requires more complicated archestration
+        request.infer();
+        release_request(rwb, request);
     }
 
 private:
@@ -669,89 +765,297 @@ private:
         return requests.at(signature);
     }
 
+    ov::InferRequest acquire_request(RequestWithBypass& rwb) {
+        std::lock_guard<std::mutex> lock(requests_mutex);
+        if(rwb.idle_requests.empty()) {
+            return rwb.compiled_model.create_infer_request();
+        }
+        auto request = rwb.idle_requests.back();
+        rwb.idle_requests.pop_back();
+        return request;
+    }
+
+    void release_request(RequestWithBypass& rwb, const ov::InferRequest& request) {
+        std::lock_guard<std::mutex> lock(requests_mutex);
+        rwb.idle_requests.push_back(request);
+    }
+
     std::unordered_map<Signature, RequestWithBypass> requests;
+    std::mutex requests_mutex;
     std::string device;
+    ov::AnyMap properties;
 };
 
 
-// Transformation that modifies existing weights in the base model fusing an arbitrary number of LoRA adapters.
-// This is one-way LoRA fusion that cannot be undone.
-// By default it uses CPU plugin to modify the base model weights.
-// TODO: This transformation unpacks potentially compressed to f16/bf16 weights to f32,
-// we should pack it back into the original precision to maintain the same weight size.
-// But it will work well if all plugins equally support fp-compressed weights and can unpack them on-line.
-class LoRAFuseTransform : public LoRATransformBase {
+// Clones a weight decompression subgraph like Constant -> [Convert] -> [Subtract] -> [Multiply] -> [Reshape] producing `output`.
+// Each Constant is replaced by a node returned by `substitute` except target shapes of Reshape that are copied as is.
+// If `structure` is given, type names of the cloned operations are appended to it in the order of cloning.
+ov::Output<ov::Node> clone_decompression_subgraph(
+    const ov::Output<ov::Node>& output,
+    const std::function<ov::Output<ov::Node>(const std::shared_ptr<v0::Constant>&)>& substitute,
+    std::map<ov::Node*, ov::Output<ov::Node>>& cloned,
+    std::string* structure = nullptr
+) {
+    auto node = output.get_node_shared_ptr();
+    auto it = cloned.find(node.get());
+    if(it != cloned.end()) {
+        return it->second;
+    }
+    ov::Output<ov::Node> result;
+    if(auto constant = std::dynamic_pointer_cast<v0::Constant>(node)) {
+        result = substitute(constant);
+    } else {
+        OPENVINO_ASSERT(
+            ov::is_type<v0::Convert>(node) || ov::is_type<v1::Subtract>(node) || ov::is_type<v1::Multiply>(node) || ov::is_type<v1::Reshape>(node),
+            "Not supported decompression pattern at the weight input: ", node);
+        ov::OutputVector inputs;
+        for(size_t i = 0; i < node->get_input_size(); ++i) {
+            if(ov::is_type<v1::Reshape>(node) && i == 1) {
+                OPENVINO_ASSERT(ov::is_type<v0::Constant>(node->get_input_node_ptr(1)), "Not supported decompression pattern at the weight input: ", node);
+                inputs.push_back(node->get_input_node_ptr(1)->clone_with_new_inputs({}));
+            } else {
+                inputs.push_back(clone_decompression_subgraph(node->input_value(i), substitute, cloned, structure));
+            }
+        }
+        if(structure) {
+            *structure += std::string("(") + node->get_type_name() + ")";
+        }
+        auto clone = node->clone_with_new_inputs(inputs);
+        ov::copy_runtime_info(node, clone);
+        result = clone->output(output.get_index());
+    }
+    cloned[node.get()] = result;
+    return result;
+}
+
+
+// Returns a Constant that is the source of a given input directly or via decompression Convert.
+std::shared_ptr<v0::Constant> get_constant_input(const ov::Output<ov::Node>& input) {
+    auto node = input.get_node_shared_ptr();
+    if(ov::is_type<v0::Convert>(node)) {
+        node = node->get_input_node_shared_ptr(0);
+    }
+    return std::dynamic_pointer_cast<v0::Constant>(node);
+}
+
+
+// Constants of a weight decompression subgraph: weights (possibly in a low-bit type), scale and zero point (if any).
+struct DecompressionConstants {
+    std::shared_ptr<v0::Constant> weights, scale, zero_point;
+};
+
+
+// Follows a weight decompression subgraph from its output to the weights constant collecting scale and zero point on the way.
+DecompressionConstants get_decompression_constants(ov::Output<ov::Node> output) {
+    DecompressionConstants constants;
+    while(!(constants.weights = std::dynamic_pointer_cast<v0::Constant>(output.get_node_shared_ptr()))) {
+        auto node = output.get_node_shared_ptr();
+        if(ov::is_type<v1::Multiply>(node)) {
+            // Weights have the larger shape, scale is broadcasted to them
+            size_t weights_index = ov::shape_size(node->get_input_shape(0)) >= ov::shape_size(node->get_input_shape(1)) ? 0 : 1;
+            constants.scale = get_constant_input(node->input_value(1 - weights_index));
+            output = node->input_value(weights_index);
+        } else if(ov::is_type<v1::Subtract>(node)) {
+            constants.zero_point = get_constant_input(node->input_value(1));
+            output = node->input_value(0);
+        } else {
+            OPENVINO_ASSERT(node->get_input_size() > 0, "Not supported decompression pattern at the weight input: ", node);
+            output = node->input_value(0);
+        }
+    }
+    return constants;
+}
+
+
+// Fuses LoRA adapters to the base model weights. This is one-way LoRA fusion that cannot be undone.
+// Weights are collected by LoRAFuseTransform, and run() computes fused weights in parallel as fusion of different weights is independent.
+// Fused weights keep the compression of the base model: fp16/bf16 weights are converted back to their type,
+// low-bit weights are quantized again with the original group size, so the fused model has about the same size as the base one.
+// By default it uses CPU plugin to compute fused weights.
+class LoRAWeightFuser {
+    // Weights to fuse, new decompression constants are allocated by run() when the weights are fused
+    struct FusionJob {
+        InferRequestSignatureCache::Signature signature;
+        NodePtr node;               // MatMul/Convolution which weights are fused
+        ConstantVector inputs;      // original decompression constants followed by alpha, B and A, hold them until fusion is done
+        ov::Shape fused_shape;      // shape of fused weights at MatMul/Convolution input
+        DecompressionConstants original, fused;
+        bool is_quantized = false;
+        float fixed_zero_point = 0;
+    };
 
     InferRequestSignatureCache fusers;
+    std::vector<FusionJob> jobs;
 
     void signature_push_back(InferRequestSignatureCache::Signature& signature, ov::Output<ov::Node> input) const {
         // TODO: Define hash function on vector<tuple<element_type, PartialShape>> to make it C++ish
         signature += "(el: " + input.get_element_type().get_type_name() + ", shape: " + input.get_partial_shape().to_string() + ")";
     }
 
-public:
+    static std::shared_ptr<v0::Constant> create_replacement(const std::shared_ptr<v0::Constant>& constant) {
+        if(!constant) {
+            return constant;
+        }
+        auto replacement = std::make_shared<v0::Constant>(constant->get_element_type(), constant->get_shape());
+        replacement->set_friendly_name(constant->get_friendly_name());
+        ov::copy_runtime_info(constant, replacement);
+        return replacement;
+    }
 
-    OPENVINO_RTTI("LoRAFuseTransform");
+    // Allocates new decompression constants of the job and fills them with fused weights
+    void fuse(FusionJob& job) {
+        job.fused.weights = create_replacement(job.original.weights);
+        // scale and zero point are recomputed for low-bit weights only
+        if(job.is_quantized) {
+            job.fused.scale = create_replacement(job.original.scale);
+            job.fused.zero_point = create_replacement(job.original.zero_point);
+        }
 
-    LoRAFuseTransform(const LoRAWeightByNodeGetter& lora_weight_getter, const std::string& device_for_fusion = "CPU") :
-        LoRATransformBase(lora_weight_getter),
-        fusers(device_for_fusion)
+        ov::TensorVector inputs;
+        inputs.reserve(job.inputs.size());
+        for(const auto& input: job.inputs) {
+            inputs.push_back(input->get_tensor_view());
+        }
+        if(!job.fused.scale) {
+            ov::TensorVector outputs{job.fused.weights->get_tensor_view()};
+            fusers.evaluate(job.signature, inputs, outputs);
+            return;
+        }
+        ov::TensorVector outputs{ov::Tensor(ov::element::f32, job.fused_shape)};
+        fusers.evaluate(job.signature, inputs, outputs);
+        // Reshape at the end of decompression keeps the order of elements, so fused weights can be read in the shape of the weights constant
+        auto quantized = job.fused.weights->get_tensor_view(), scale = job.fused.scale->get_tensor_view();
+        auto zero_point = job.fused.zero_point ? job.fused.zero_point->get_tensor_view() : ov::Tensor();
+        quantize_weights(outputs[0].data<float>(), quantized, scale, job.fused.zero_point ? &zero_point : nullptr, job.fixed_zero_point);
+    }
+
+    // Connects the decompression subgraph with fused constants to the node of the job.
+    // The subgraph is copied and connected to this node only, the original weights may be shared with other nodes
+    // (like tied embeddings) that should not be modified.
+    static void replace_weights(const FusionJob& job) {
+        std::map<std::shared_ptr<v0::Constant>, std::shared_ptr<v0::Constant>> replacements;
+        for(const auto& [original, fused]: {std::make_pair(job.original.weights, job.fused.weights),
+                                            std::make_pair(job.original.scale, job.fused.scale),
+                                            std::make_pair(job.original.zero_point, job.fused.zero_point)}) {
+            if(fused) {
+                replacements[original] = fused;
+            }
+        }
+        std::map<ov::Node*, ov::Output<ov::Node>> cloned;
+        auto fused_weights = clone_decompression_subgraph(job.node->input_value(1), [&replacements](const std::shared_ptr<v0::Constant>& constant) {
+            auto replacement = replacements.find(constant);
+            return replacement != replacements.end() ? replacement->second->output(0) : constant->output(0);
+        }, cloned);
+        job.node->input(1).replace_source_output(fused_weights);
+    }
+
+public:
+
+    LoRAWeightFuser(const std::string& device_for_fusion = "CPU") :
+        fusers(device_for_fusion, {ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT)})
     {}
 
-    bool apply (NodePtr node, const LoRANode& lora_weight) override {
+    void add(NodePtr node, const LoRANode& lora_weight) {
         auto weights_input = node->input_value(1);
-        auto weights_input_type = weights_input.get_element_type();
-        auto weights_convert = decompression_convert(weights_input.get_node_shared_ptr());
-        auto weights_constant = weights_convert ? weights_convert->input_value(0) : weights_input;
-        ConstantVector adapter = {
-            std::dynamic_pointer_cast<v0::Constant>(lora_weight.alpha),
-            std::dynamic_pointer_cast<v0::Constant>(lora_weight.B),
-            std::dynamic_pointer_cast<v0::Constant>(lora_weight.A)};
-        InferRequestSignatureCache::Signature signature;
-        signature_push_back(signature, weights_input);
-        for(auto multiplier : adapter) {
-            signature_push_back(signature, multiplier);
+        auto constants = get_decompression_constants(weights_input);
+        const auto quantization_range = get_quantization_range(constants.weights->get_element_type());
+        if(quantization_range) {
+            OPENVINO_ASSERT(constants.scale,
+                "Not supported decompression pattern at the weight input: ", constants.weights->get_element_type(), " weights without scale");
+        } else {
+            OPENVINO_ASSERT(constants.weights->get_element_type().is_real() && !constants.scale && !constants.zero_point,
+                "Not supported decompression pattern at the weight input: ", constants.weights->get_element_type(), " weights",
+                constants.scale ? " with scale" : "", ". Use f32/f16/bf16 or int8/int4 weights only.");
         }
 
-        // TODO: In case when compressed repacking of newly created weights is retained,
-        // replace weights_input by weigths_constant to keep decompression Convert in the model.
-        auto consumers = weights_input.get_target_inputs();
+        FusionJob job;
+        job.node = node;
+        job.fused_shape = weights_input.get_shape();
+        job.original = constants;
+        job.is_quantized = quantization_range.has_value();
+        if(quantization_range && constants.zero_point && constants.zero_point->get_shape() != constants.scale->get_shape()) {
+            OPENVINO_ASSERT(ov::shape_size(constants.zero_point->get_shape()) == 1,
+                "Not supported decompression pattern at the weight input: zero point of shape ", constants.zero_point->get_shape(),
+                " with scale of shape ", constants.scale->get_shape());
+            job.fixed_zero_point = get_element(constants.zero_point->get_tensor_view(), 0);
+            // the fixed zero point is kept in the fused subgraph
+            job.original.zero_point = nullptr;
+        }
 
-        if(!fusers.exist(signature)) {
+        // Build a small model that decompresses weights and fuses them with LoRA, the part of the model is copied with parameters instead of constants
+        ov::ParameterVector parameters;
+        std::map<ov::Node*, ov::Output<ov::Node>> cloned;
+        auto target = clone_decompression_subgraph(weights_input, [&](const std::shared_ptr<v0::Constant>& constant) {
+            auto parameter = std::make_shared<v0::Parameter>(constant->get_element_type(), constant->get_shape());
+            parameters.push_back(parameter);
+            job.inputs.push_back(constant);
+            job.signature += std::string(constant == constants.weights ? "W" : "C");
+            signature_push_back(job.signature, constant);
+            return parameter->output(0);
+        }, cloned, &job.signature);
+        signature_push_back(job.signature, weights_input);
+        for(const auto& multiplier: {lora_weight.alpha, lora_weight.B, lora_weight.A}) {
+            job.inputs.push_back(std::dynamic_pointer_cast<v0::Constant>(multiplier));
+            signature_push_back(job.signature, multiplier);
+        }
+
+        if(!fusers.exist(job.signature)) {
             // Build a small model for weight and LoRA fusion, and stash it into `fusers` cache.
-            ov::ParameterVector parameters;
-            auto target_parameter = std::make_shared<v0::Parameter>(weights_constant.get_element_type(), weights_constant.get_partial_shape());
-            parameters.push_back(target_parameter);   // original weights input is one of the parameters
-            ov::Output<ov::Node> target = weights_convert ? weights_convert->clone_with_new_inputs({target_parameter}) : target_parameter;
-            for(auto multiplier : adapter) {
-                parameters.push_back(std::make_shared<v0::Parameter>(multiplier->get_output_element_type(0), multiplier->get_output_partial_shape(0)));
+            ov::ParameterVector lora_parameters;
+            for(size_t i = parameters.size(); i < job.inputs.size(); ++i) {
+                lora_parameters.push_back(std::make_shared<v0::Parameter>(job.inputs[i]->get_output_element_type(0), job.inputs[i]->get_output_partial_shape(0)));
+            }
+            NodePtr fused = tensors_multiplication(nullptr, NodeVector{lora_parameters.begin(), lora_parameters.end()}, target, false, 1, false);
+            // Fused weights are converted back to fp type of the original weights or to f32 to be quantized to low-bit type
+            auto fused_type = quantization_range ? ov::element::f32 : constants.weights->get_element_type();
+            if(fused->get_output_element_type(0) != fused_type) {
+                fused = std::make_shared<v0::Convert>(fused, fused_type);
             }
-            auto result = std::make_shared<v0::Result>(tensors_multiplication(nullptr, NodeVector{parameters.begin() + 1, parameters.end()}, target, false, 1, false));
-            ov::ResultVector results{result};
-            fusers.insert(signature, results, parameters);
+            parameters.insert(parameters.end(), lora_parameters.begin(), lora_parameters.end());
+            ov::ResultVector results{std::make_shared<v0::Result>(fused)};
+            fusers.insert(job.signature, results, parameters);
         }
 
-        // Newly created constants in the next line are not mmaped unlike original weights, so it will inflate required memory
-        // eventually allocating up to 2x of the base model size.
-        // 2X is due to usually applied compression in the base model that is not retained in the current version of this code.
-        // But even if the compression is used, then still a copy of all weights that affected by the LoRA adapters are allocated in memory.
-        // FIXME: Provide a way for postponed weight repacking that will be triggered by the plugin in compile_model call for the base model.
-        // Constant sub-expression can be a solution, but it requires improvements inside plugins, because currently it works extremely slow.
-        auto replacement_const = std::make_shared<v0::Constant>(weights_input.get_element_type(), weights_input.get_shape());
+        jobs.push_back(std::move(job));
+    }
 
-        ov::TensorVector outputs{replacement_const->get_tensor_view()};
-        // set input constants
-        ov::TensorVector inputs;
-        inputs.reserve(1 + adapter.size());
-        inputs.push_back(std::dynamic_pointer_cast<v0::Constant>(weights_constant.get_node_shared_ptr())->get_tensor_view());
-        for(size_t i = 0; i < adapter.size(); ++i) {
-            inputs.push_back(adapter[i]->get_tensor_view());
+    // Computes all collected fused weights and replaces the original weights in the model by them.
+    // Jobs are processed in chunks of the number of threads, and original constants of a chunk are released as soon as
+    // its fused weights are connected to the model, so the peak memory is the base model plus one chunk of fused weights.
+    void run() {
+        const size_t chunk_size = std::max(1, ov::parallel_get_max_threads());
+        for(size_t chunk_begin = 0; chunk_begin < jobs.size(); chunk_begin += chunk_size) {
+            const size_t chunk_end = std::min(jobs.size(), chunk_begin + chunk_size);
+            ov::parallel_for(chunk_end - chunk_begin, [this, chunk_begin](size_t i) {
+                fuse(jobs[chunk_begin + i]);
+            });
+            // the model is modified sequentially
+            for(size_t i = chunk_begin; i < chunk_end; ++i) {
+                replace_weights(jobs[i]);
+                jobs[i] = FusionJob();
+            }
         }
-        fusers.evaluate(signature, inputs, outputs);
+        jobs.clear();
+    }
+};
 
-        for (auto consumer : consumers) {
-            consumer.replace_source_output(replacement_const->output(0));
-        }
+
+// Transformation that fuses LoRA adapters into weights of the base model, the fusion itself is done by LoRAWeightFuser.
+class LoRAFuseTransform : public LoRATransformBase {
+
+    std::shared_ptr<LoRAWeightFuser> fuser;
+
+public:
+
+    OPENVINO_RTTI("LoRAFuseTransform");
+
+    LoRAFuseTransform(const LoRAWeightByNodeGetter& lora_weight_getter, std::shared_ptr<LoRAWeightFuser> fuser) :
+        LoRATransformBase(lora_weight_getter),
+        fuser(fuser)
+    {}
+
+    bool apply (NodePtr node, const LoRANode& lora_weight) override {
+        fuser->add(node, lora_weight);
         return true;
     }
 };
@@ -863,6 +1167,22 @@ struct AdapterControllerImpl {
     AdapterConfig current_config;
     bool need_full_apply = true;
     InferRequestSignatureCache lora_state_evaluators;
+    // MODE_DYNAMIC_PER_TOKEN: model input with an index of adapter config for every token, configs of the last batch
+    // and LoRA ranks of adapters from current_config for every LoRA layer
+    std::shared_ptr<v0::Parameter> token_config_ids;
+    std::vector<AdapterConfig> token_configs;
+    std::map<std::string, std::vector<size_t>> adapter_ranks;
+
+    // State tensors prepared for a particular config of adapters and alphas, an item per LoRA layer in the order of variable_ids
+    using PreparedAdapters = std::vector<LoRAParts<ov::Tensor>>;
+
+    // Recently applied configs with their prepared state tensors.
+    // Switching to one of them sets already prepared tensors to the state without evaluating concatenation again.
+    ov::genai::SizeBoundedLRUCache<AdapterConfig, PreparedAdapters> prepared_adapters;
+
+    // Indices of LoRA states in the order of variable_ids for the last infer request adapters were applied to
+    ov::InferRequest indexed_request;
+    std::vector<LoRAIndices> lora_indices;
 
     AdapterControllerImpl(std::shared_ptr<ov::Model> model, const AdapterConfig& config) :
         current_config(config),  // FIXME: Compare current and passed configs and change incrementally
@@ -913,8 +1233,14 @@ struct AdapterControllerImpl {
         };
 
         ov::pass::Manager pm;
+        std::shared_ptr<LoRAWeightFuser> fuser;
         auto mode = current_config.get_mode();
-        if(mode == AdapterConfig::MODE_DYNAMIC || mode == AdapterConfig::MODE_STATIC_RANK || mode == AdapterConfig::MODE_AUTO) {
+        if(mode == AdapterConfig::MODE_DYNAMIC_PER_TOKEN) {
+            token_config_ids = std::make_shared<v0::Parameter>(ov::element::i32, ov::PartialShape{-1});
+            token_config_ids->set_friendly_name("lora_config_ids");
+            token_config_ids->output(0).set_names({"lora_config_ids"});
+            pm.register_pass<LoRASeparateTransform>(LoRAWeightStateGetter(params_getter, model, variable_ids, token_config_ids));
+        } else if(mode == AdapterConfig::MODE_DYNAMIC || mode == AdapterConfig::MODE_STATIC_RANK || mode == AdapterConfig::MODE_AUTO) {
             // State mode
             params_getter.dynamic_lora_rank = (mode != AdapterConfig::MODE_STATIC_RANK);
             pm.register_pass<LoRASeparateTransform>(LoRAWeightStateGetter(params_getter, model, variable_ids));
@@ -923,12 +1249,19 @@ struct AdapterControllerImpl {
             pm.register_pass<LoRASeparateTransform>(weight_as_constant);
         } else if(mode == AdapterConfig::MODE_FUSE) {
             // Fuse mode
-            pm.register_pass<LoRAFuseTransform>(weight_as_constant);
+            fuser = std::make_shared<LoRAWeightFuser>();
+            pm.register_pass<LoRAFuseTransform>(weight_as_constant, fuser);
         } else {
             OPENVINO_THROW("Unrecognized AdapterConfig::Mode was used: ", mode);
         }
 
         pm.run_passes(model);
+        if(fuser) {
+            fuser->run();
+        }
+        if(token_config_ids && !variable_ids.empty()) {
+            model->add_parameters({token_config_ids});
+        }
 
         // Collect all variable names to quickly detect which state tensor belongs to this adapter controller later
         for(const auto& var: variable_ids) {
@@ -973,6 +1306,8 @@ struct AdapterControllerImpl {
     }
 
     void apply (ov::InferRequest& infer_request, std::optional<AdapterConfig> config) {
+        OPENVINO_ASSERT(current_config.get_mode() != AdapterConfig::MODE_DYNAMIC_PER_TOKEN,
+            "AdapterConfig::MODE_DYNAMIC_PER_TOKEN requires adapter configs for every token of a batch");
         // FIXME: If a part of LoRA state tensors are not set here, then need to carefully reset state in LLMPipeline where global reset is called after the generation
         ConfigChanged diff;
         if(config) {
@@ -997,6 +1332,88 @@ struct AdapterControllerImpl {
         }
     }
 
+    void apply (ov::InferRequest& infer_request, const std::vector<AdapterConfig>& configs, const ov::Tensor& config_ids) {
+        OPENVINO_ASSERT(current_config.get_mode() == AdapterConfig::MODE_DYNAMIC_PER_TOKEN,
+            "Adapter configs for every token of a batch can be applied in AdapterConfig::MODE_DYNAMIC_PER_TOKEN only");
+        if(variable_ids.empty()) {
+            return;
+        }
+
+        // A and B of adapters used in the batch are concatenated in LoRA states once the batch needs a new adapter,
+        // adapters which are not used anymore are dropped at the same time
+        std::vector<Adapter> used_adapters;
+        for(const auto& config: configs) {
+            for(const auto& adapter: config.get_adapters()) {
+                if(std::find(used_adapters.begin(), used_adapters.end(), adapter) == used_adapters.end()) {
+                    used_adapters.push_back(adapter);
+                }
+            }
+        }
+        const auto& loaded_adapters = current_config.get_adapters();
+        bool need_new_adapters = need_full_apply || std::any_of(used_adapters.begin(), used_adapters.end(), [&loaded_adapters](const Adapter& adapter) {
+            return std::find(loaded_adapters.begin(), loaded_adapters.end(), adapter) == loaded_adapters.end();
+        });
+        if(need_new_adapters) {
+            need_full_apply = false;
+            AdapterConfig new_config(used_adapters, AdapterConfig::MODE_DYNAMIC_PER_TOKEN);
+            new_config.set_tensor_name_prefix(current_config.get_tensor_name_prefix());
+            new_config.set_cache_size(current_config.get_cache_size());
+            current_config = new_config;
+            set_new_adapter_tensors(infer_request);
+            update_adapter_ranks();
+        }
+
+        if(need_new_adapters || configs.size() != token_configs.size() ||
+           !std::equal(configs.begin(), configs.end(), token_configs.begin(), is_same_config)) {
+            token_configs = configs;
+            set_token_alphas(infer_request);
+        }
+        infer_request.set_tensor(token_config_ids->output(0).get_any_name(), config_ids);
+    }
+
+    void update_adapter_ranks() {
+        std::vector<LoRAWeightGetter> weight_getters;
+        for(const auto& adapter: current_config.get_adapters()) {
+            weight_getters.emplace_back(LoRAWeightGetterDefault(&get_adapter_impl(adapter)->tensors, current_config.get_tensor_name_prefix().value_or("")));
+        }
+        adapter_ranks.clear();
+        for(const auto& lora_var_ids: variable_ids) {
+            auto& ranks = adapter_ranks[lora_var_ids.first];
+            for(const auto& weight_getter: weight_getters) {
+                auto lora_tensors = weight_getter(lora_var_ids.first);
+                ranks.push_back(lora_tensors ? lora_tensors->A->get_output_partial_shape(0)[0].get_length() : 0);
+            }
+        }
+    }
+
+    // Sets alpha tables: a row per adapter config and a column per LoRA rank of adapters concatenated in A and B states
+    void set_token_alphas(ov::InferRequest& infer_request) {
+        auto state = infer_request.query_state();
+        const auto& indices = get_lora_indices(infer_request, state);
+
+        const auto& adapters = current_config.get_adapters();
+        size_t lora_index = 0;
+        for(const auto& lora_var_ids: variable_ids) {
+            const auto& ranks = adapter_ranks.at(lora_var_ids.first);
+            const size_t total_rank = std::accumulate(ranks.begin(), ranks.end(), size_t(0));
+            ov::Tensor alphas(ov::element::f32, {token_configs.size(), total_rank});
+            float* alphas_data = alphas.data<float>();
+            std::fill_n(alphas_data, alphas.get_size(), 0.0f);
+            for(const auto& config: token_configs) {
+                const auto& config_adapters = config.get_adapters();
+                float* column = alphas_data;
+                for(size_t i = 0; i < adapters.size(); ++i) {
+                    if(std::find(config_adapters.begin(), config_adapters.end(), adapters[i]) != config_adapters.end()) {
+                        std::fill_n(column, ranks[i], config.get_alpha(adapters[i]));
+                    }
+                    column += ranks[i];
+                }
+                alphas_data += total_rank;
+            }
+            state[indices[lora_index++].alpha].set_state(alphas);
+        }
+    }
+
     bool has_state_name(const std::string& name) {
         return variable_names.count(name);
     }
@@ -1006,37 +1423,95 @@ struct AdapterControllerImpl {
     }
 
     void set_new_adapter_tensors (ov::InferRequest& infer_request, bool alpha_only = false) {
-        if(current_config.get_mode() != AdapterConfig::MODE_AUTO && current_config.get_mode() != AdapterConfig::MODE_DYNAMIC && current_config.get_mode() != AdapterConfig::MODE_STATIC_RANK ) {
+        if(current_config.get_mode() != AdapterConfig::MODE_AUTO && current_config.get_mode() != AdapterConfig::MODE_DYNAMIC && current_config.get_mode() != AdapterConfig::MODE_STATIC_RANK &&
+           current_config.get_mode() != AdapterConfig::MODE_DYNAMIC_PER_TOKEN) {
             return;
         }
 
-        std::vector<LoRAWeightGetter> weight_getters;
-        const auto& adapters = current_config.get_adapters();
-        weight_getters.reserve(adapters.size());
-        for(const auto& adapter: adapters) {
-            weight_getters.emplace_back(LoRAWeightGetterDefault(&get_adapter_impl(adapter)->tensors, current_config.get_tensor_name_prefix().value_or("")));
-        }
-
         auto state = infer_request.query_state();
+        const auto& indices = get_lora_indices(infer_request, state);
+        const auto& prepared = get_prepared_adapters(alpha_only);
 
-        // TODO: Forced to use variable_id instead of index to address the state tensors, require the same order for state as for variables from plugins
+        for(size_t i = 0; i < indices.size(); ++i) {
+            state[indices[i].alpha].set_state(prepared[i].alpha);
+            if(!alpha_only) {
+                state[indices[i].A].set_state(prepared[i].A);
+                state[indices[i].B].set_state(prepared[i].B);
+            }
+        }
+    }
 
-        // Convert LoRAVarIDs to LoRAIndices to speedup search for state with a given name
-        // TODO: If state order is stable, then the mapping should be done once for a given infer request, TODO: cache it based on the infer request
+    // Maps LoRA variables to state indices once for a given infer request, the order of state is stable for the same request.
+    // TODO: Forced to use variable_id instead of index to address the state tensors, require the same order for state as for variables from plugins
+    const std::vector<LoRAIndices>& get_lora_indices(const ov::InferRequest& infer_request, const std::vector<VariableState>& state) {
+        if(indexed_request == infer_request && !lora_indices.empty()) {
+            return lora_indices;
+        }
         std::map<std::string, size_t> state_name_to_index;
         for(size_t i = 0; i < state.size(); ++i) {
-            auto name = state[i].get_name();
-            state_name_to_index[name] = i;
+            state_name_to_index[state[i].get_name()] = i;
+        }
+        lora_indices.clear();
+        lora_indices.reserve(variable_ids.size());
+        for(const auto& lora_var_ids : variable_ids) {
+            lora_indices.emplace_back(
+                state_name_to_index.at(lora_var_ids.second.alpha.variable_id),
+                state_name_to_index.at(lora_var_ids.second.A.variable_id),
+                state_name_to_index.at(lora_var_ids.second.B.variable_id));
         }
+        indexed_request = infer_request;
+        return lora_indices;
+    }
 
+    // Returns state tensors for current_config taking them from the cache or preparing and caching them if they are not there.
+    // If alpha_only is set, the last applied config differs in alphas only, so its A and B are reused and only alphas are prepared.
+    const PreparedAdapters& get_prepared_adapters(bool alpha_only) {
+        auto cached = prepared_adapters.find_if([this](const AdapterConfig& config) {
+            return is_same_config(config, current_config);
+        });
+        if(cached) {
+            return cached->value;
+        }
+
+        const PreparedAdapters* base = nullptr;
+        auto last_applied = prepared_adapters.front();
+        if(alpha_only && last_applied && last_applied->key.get_adapters() == current_config.get_adapters()) {
+            base = &last_applied->value;
+        }
+
+        std::vector<LoRAWeightGetter> weight_getters;
+        const auto& adapters = current_config.get_adapters();
+        weight_getters.reserve(adapters.size());
+        for(const auto& adapter: adapters) {
+            weight_getters.emplace_back(LoRAWeightGetterDefault(&get_adapter_impl(adapter)->tensors, current_config.get_tensor_name_prefix().value_or("")));
+        }
+
+        PreparedAdapters prepared;
+        size_t prepared_byte_size = 0;
+        prepared.reserve(variable_ids.size());
         for(const auto& lora_var_ids : variable_ids) {
-            // FIXME: Remove this mapping when the order of state will be the same as the order of variables
-            LoRAIndices lora_indices;
-            lora_indices.alpha = state_name_to_index.at(lora_var_ids.second.alpha.variable_id);
-            lora_indices.A = state_name_to_index.at(lora_var_ids.second.A.variable_id);
-            lora_indices.B = state_name_to_index.at(lora_var_ids.second.B.variable_id);
-            set_lora_tensors(state, lora_var_ids.first, lora_var_ids.second, lora_indices, weight_getters, alpha_only);
+            LoRAParts<ov::Tensor> tensors;
+            if(base) {
+                tensors = prepare_state_tensors(lora_var_ids.first, lora_var_ids.second, weight_getters, /*alpha_only=*/true);
+                const auto& base_tensors = (*base)[prepared.size()];
+                tensors.A = base_tensors.A;
+                tensors.B = base_tensors.B;
+                if(!tensors.alpha) {
+                    // No adapter has this layer, so the empty alpha is the same
+                    tensors.alpha = base_tensors.alpha;
+                }
+            } else {
+                tensors = prepare_state_tensors(lora_var_ids.first, lora_var_ids.second, weight_getters, /*alpha_only=*/false);
+            }
+            // A and B shared with another cached config are counted for both of them, so the real footprint is not greater than the counted one
+            for(const auto& tensor: {tensors.alpha, tensors.A, tensors.B}) {
+                prepared_byte_size += tensor ? tensor.get_byte_size() : 0;
+            }
+            prepared.push_back(tensors);
         }
+
+        // The last applied config is kept regardless of the budget, it is used to prepare alphas for the same adapters
+        return prepared_adapters.insert(current_config, std::move(prepared), prepared_byte_size, current_config.get_cache_size().value_or(0)).value;
     }
 
      std::vector<LoRAWeight> collect_applicable_tensors (const std::string& lora_name, const std::vector<LoRAWeightGetter>& weight_getters) {
@@ -1225,11 +1700,9 @@ struct AdapterControllerImpl {
         return shape;
     }
 
-    void set_lora_tensors(
-        std::vector<VariableState>& state,
+    LoRAParts<ov::Tensor> prepare_state_tensors(
         const std::string& name,
         const LoRAVarIDs& lora_var_ids,
-        const LoRAIndices& lora_indices,
         const std::vector<LoRAWeightGetter>& weight_getters,
         bool alpha_only
     ) {
@@ -1238,13 +1711,7 @@ struct AdapterControllerImpl {
             alpha_only ? ov::Tensor() : ov::Tensor(lora_var_ids.A.data_type, dynamic_to_static(lora_var_ids.A.data_shape)),
             alpha_only ? ov::Tensor() : ov::Tensor(lora_var_ids.B.data_type, dynamic_to_static(lora_var_ids.B.data_shape))
         };
-        auto new_tensors = prepare_lora_tensors(name, weight_getters, lora_state_tensors, /*set_empty_adapters=*/true, alpha_only);
-
-        state[lora_indices.alpha].set_state(new_tensors.alpha);
-        if(!alpha_only) {
-            state[lora_indices.A].set_state(new_tensors.A);
-            state[lora_indices.B].set_state(new_tensors.B);
-        }
+        return prepare_lora_tensors(name, weight_getters, lora_state_tensors, /*set_empty_adapters=*/!alpha_only, alpha_only);
     }
 
     LoRAParts<ov::Tensor> prepare_lora_tensors (
@@ -1313,6 +1780,12 @@ void AdapterController::apply(ov::InferRequest& request, const std::optional<Ada
 }
 
 
+void AdapterController::apply(ov::InferRequest& request, const std::vector<AdapterConfig>& configs, const ov::Tensor& token_config_ids) {
+    OPENVINO_ASSERT(m_pimpl, "AdapterController was not configured to use adapters");
+    m_pimpl->apply(request, configs, token_config_ids);
+}
+
+
 bool AdapterController::has_state_name(const std::string& name) {
     return m_pimpl->has_state_name(name);
 }
@@ -1397,6 +1870,9 @@ void AdapterConfig::update (const AdapterConfig& other) {
     if(other.tensor_name_prefix) {
         tensor_name_prefix = other.tensor_name_prefix;
     }
+    if(other.cache_size) {
+        cache_size = other.cache_size;
+    }
 }
 
 
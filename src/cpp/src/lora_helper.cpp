@@ -27,5 +27,17 @@ bool update_adapters_from_properties (const AnyMap& properties, std::optional<Ad
     return false;
 }
 
+bool is_same_config (const AdapterConfig& config1, const AdapterConfig& config2) {
+    if(config1.get_adapters() != config2.get_adapters()) {
+        return false;
+    }
+    for(const auto& adapter: config1.get_adapters()) {
+        if(config1.get_alpha(adapter) != config2.get_alpha(adapter)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
 }
\ No newline at end of file
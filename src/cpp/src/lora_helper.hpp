@@ -17,5 +17,8 @@ std::optional<AnyMap> extract_adapters_from_properties (const AnyMap& properties
 // If `adapters` property is not found, do nothing and return false.
 bool update_adapters_from_properties (const AnyMap& properties, std::optional<AdapterConfig>& adapter_config);
 
+// Return true if both configs consist of the same adapters with the same alphas.
+bool is_same_config (const AdapterConfig& config1, const AdapterConfig& config2);
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+#include "openvino/core/type/bfloat16.hpp"
+#include "openvino/core/type/float16.hpp"
+
+#include "lora_quantization.hpp"
+
+namespace ov {
+namespace genai {
+
+std::optional<std::pair<float, float>> get_quantization_range(const ov::element::Type& type) {
+    if(type == ov::element::u8) {
+        return std::make_pair(0.0f, 255.0f);
+    } else if(type == ov::element::i8) {
+        return std::make_pair(-128.0f, 127.0f);
+    } else if(type == ov::element::u4) {
+        return std::make_pair(0.0f, 15.0f);
+    } else if(type == ov::element::i4) {
+        return std::make_pair(-8.0f, 7.0f);
+    }
+    return std::nullopt;
+}
+
+
+float get_element(const ov::Tensor& tensor, size_t index) {
+    const auto type = tensor.get_element_type();
+    if(type == ov::element::f32) {
+        return tensor.data<float>()[index];
+    } else if(type == ov::element::f16) {
+        return tensor.data<ov::float16>()[index];
+    } else if(type == ov::element::bf16) {
+        return tensor.data<ov::bfloat16>()[index];
+    } else if(type == ov::element::u8) {
+        return static_cast<const uint8_t*>(tensor.data())[index];
+    } else if(type == ov::element::i8) {
+        return static_cast<const int8_t*>(tensor.data())[index];
+    } else if(type == ov::element::u4 || type == ov::element::i4) {
+        // Two elements per byte, the first one is in the lower half of the byte
+        uint8_t value = (static_cast<const uint8_t*>(tensor.data())[index / 2] >> (index % 2 * 4)) & 0x0F;
+        return type == ov::element::i4 && value > 7 ? float(value) - 16 : float(value);
+    }
+    OPENVINO_THROW("Not supported element type of a decompression constant: ", type);
+}
+
+
+void set_element(ov::Tensor& tensor, size_t index, float value) {
+    const auto type = tensor.get_element_type();
+    if(type == ov::element::f32) {
+        tensor.data<float>()[index] = value;
+    } else if(type == ov::element::f16) {
+        tensor.data<ov::float16>()[index] = value;
+    } else if(type == ov::element::bf16) {
+        tensor.data<ov::bfloat16>()[index] = value;
+    } else if(type == ov::element::u8) {
+        static_cast<uint8_t*>(tensor.data())[index] = static_cast<uint8_t>(value);
+    } else if(type == ov::element::i8) {
+        static_cast<int8_t*>(tensor.data())[index] = static_cast<int8_t>(value);
+    } else if(type == ov::element::u4 || type == ov::element::i4) {
+        uint8_t& byte = static_cast<uint8_t*>(tensor.data())[index / 2];
+        const int shift = index % 2 * 4;
+        byte = (byte & ~(0x0F << shift)) | ((static_cast<int>(value) & 0x0F) << shift);
+    } else {
+        OPENVINO_THROW("Not supported element type of a decompression constant: ", type);
+    }
+}
+
+
+void quantize_weights(const float* weights, ov::Tensor& quantized, ov::Tensor& scale, ov::Tensor* zero_point, float fixed_zero_point) {
+    const auto range = get_quantization_range(quantized.get_element_type());
+    OPENVINO_ASSERT(range, "Not supported element type of compressed weights: ", quantized.get_element_type());
+    const auto [q_min, q_max] = *range;
+
+    // Maps each weight element to its group: strides of the scale tensor are zero along broadcasted dimensions
+    const ov::Shape& shape = quantized.get_shape();
+    ov::Shape scale_shape = scale.get_shape();
+    OPENVINO_ASSERT(scale_shape.size() <= shape.size(), "Scale rank is greater than weights rank in decompression subgraph");
+    scale_shape.insert(scale_shape.begin(), shape.size() - scale_shape.size(), 1);
+    std::vector<size_t> group_strides(shape.size());
+    size_t group_stride = 1;
+    for(size_t i = shape.size(); i-- > 0;) {
+        OPENVINO_ASSERT(scale_shape[i] == 1 || scale_shape[i] == shape[i], "Scale of shape ", scale.get_shape(), " is not applicable to weights of shape ", shape);
+        group_strides[i] = scale_shape[i] == 1 ? 0 : group_stride;
+        group_stride *= scale_shape[i];
+    }
+    auto for_each_element = [&](const std::function<void(size_t, size_t)>& func) {
+        std::vector<size_t> coordinate(shape.size(), 0);
+        size_t group = 0;
+        for(size_t i = 0, size = ov::shape_size(shape); i < size; ++i) {
+            func(i, group);
+            for(size_t axis = shape.size(); axis-- > 0;) {
+                group += group_strides[axis];
+                if(++coordinate[axis] < shape[axis]) {
+                    break;
+                }
+                group -= group_strides[axis] * coordinate[axis];
+                coordinate[axis] = 0;
+            }
+        }
+    };
+
+    const size_t num_groups = scale.get_size();
+    std::vector<float> group_min(num_groups, std::numeric_limits<float>::max()), group_max(num_groups, std::numeric_limits<float>::lowest());
+    for_each_element([&](size_t i, size_t group) {
+        group_min[group] = std::min(group_min[group], weights[i]);
+        group_max[group] = std::max(group_max[group], weights[i]);
+    });
+
+    std::vector<float> group_scale(num_groups), group_zero_point(num_groups, fixed_zero_point);
+    for(size_t group = 0; group < num_groups; ++group) {
+        float value;
+        if(zero_point) {
+            value = (group_max[group] - group_min[group]) / (q_max - q_min);
+        } else {
+            value = std::max({0.0f,
+                q_max > fixed_zero_point ? group_max[group] / (q_max - fixed_zero_point) : 0.0f,
+                q_min < fixed_zero_point ? group_min[group] / (q_min - fixed_zero_point) : 0.0f});
+        }
+        set_element(scale, group, value > 0 ? value : 1.0f);
+        // Scale is read back to quantize with the same value that is used for decompression after rounding to the scale type
+        group_scale[group] = get_element(scale, group);
+        if(zero_point) {
+            group_zero_point[group] = std::clamp(std::round(q_min - group_min[group] / group_scale[group]), q_min, q_max);
+            set_element(*zero_point, group, group_zero_point[group]);
+        }
+    }
+
+    for_each_element([&](size_t i, size_t group) {
+        set_element(quantized, i, std::clamp(std::round(weights[i] / group_scale[group]) + group_zero_point[group], q_min, q_max));
+    });
+}
+
+}  // namespace genai
+}  // namespace ov
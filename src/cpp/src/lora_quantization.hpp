@@ -0,0 +1,26 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <optional>
+#include <utility>
+
+#include "openvino/runtime/tensor.hpp"
+
+namespace ov {
+namespace genai {
+
+// Integer range of low-bit weight types that are re-compressed after LoRA fusion, std::nullopt for other types.
+std::optional<std::pair<float, float>> get_quantization_range(const ov::element::Type& type);
+
+// Reads and writes elements of f32/f16/bf16 and 8/4-bit integer tensors as float.
+float get_element(const ov::Tensor& tensor, size_t index);
+void set_element(ov::Tensor& tensor, size_t index, float value);
+
+// Quantizes `weights` to the element type of `quantized` with the granularity of `scale`: elements sharing a scale value form a group.
+// If `zero_point` is given, it has the shape of `scale` and is computed per group, otherwise the group range is symmetric around `fixed_zero_point`.
+void quantize_weights(const float* weights, ov::Tensor& quantized, ov::Tensor& scale, ov::Tensor* zero_point, float fixed_zero_point);
+
+}  // namespace genai
+}  // namespace ov
@@ -8,7 +8,10 @@
 
 #include <openvino/runtime/infer_request.hpp>
 
+#include "openvino/genai/lora_adapter.hpp"
+
 #include "debug_utils.hpp"
+#include "lora_helper.hpp"
 #include "sequence_group.hpp"
 #include "scheduler.hpp"
 #include "timer.hpp"
@@ -32,6 +35,7 @@ class ModelRunner {
     AttentionScoresForEachSubsequence m_last_attention_scores;
     size_t m_num_decoder_layers, m_block_size;
     bool m_collect_attention_scores;
+    std::optional<AdapterController> m_adapter_controller;
 public:
     /**
      * Constructs the ModelRunner.
@@ -49,6 +53,14 @@ public:
         OPENVINO_ASSERT(m_num_decoder_layers != 0, "num_decoder_layers must be non-zero");
     }
 
+    /**
+     * Enables LoRA adapters configured per request by GenerationConfig::adapters.
+     * @param adapter_controller Adapter controller created for the model in AdapterConfig::MODE_DYNAMIC_PER_TOKEN.
+     */
+    void set_adapter_controller(const AdapterController& adapter_controller) {
+        m_adapter_controller = adapter_controller;
+    }
+
     /**
      * @return The ov::InferRequest this ModelRunner is handling.
      */
@@ -168,6 +180,10 @@ public:
         m_request.set_tensor("block_indices_begins", block_indices_begins);
         m_request.set_tensor("max_context_len", max_context_len);
 
+        if (m_adapter_controller) {
+            _set_adapters(sequence_groups, scheduler_output, total_num_tokens);
+        }
+
         // print_tensor("input_ids", input_ids);
         // print_tensor("position_ids", position_ids);
 
@@ -193,6 +209,30 @@ public:
     }
 
 private:
+    // Requests with the same adapter config share a row of LoRA alphas, every token gets the index of its request config
+    void _set_adapters(const std::vector<SequenceGroup::Ptr>& sequence_groups, const Scheduler::Output& scheduler_output, size_t total_num_tokens) {
+        // the first config is used by requests without adapters
+        std::vector<AdapterConfig> adapter_configs(1);
+        ov::Tensor config_ids(ov::element::i32, {total_num_tokens});
+        int32_t* config_ids_data = config_ids.data<int32_t>();
+        for (size_t seq_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+            SequenceGroup::CPtr sequence_group = sequence_groups[seq_group_id];
+            const std::optional<AdapterConfig>& adapters = sequence_group->get_sampling_parameters().adapters;
+            size_t config_id = 0;
+            if (adapters && *adapters) {
+                config_id = std::distance(adapter_configs.begin(), std::find_if(adapter_configs.begin(), adapter_configs.end(),
+                    [&](const AdapterConfig& config) { return is_same_config(config, *adapters); }));
+                if (config_id == adapter_configs.size()) {
+                    adapter_configs.push_back(*adapters);
+                }
+            }
+            size_t num_tokens = sequence_group->get_num_scheduled_tokens() * sequence_group->num_running_seqs();
+            config_ids_data = std::fill_n(config_ids_data, num_tokens, static_cast<int32_t>(config_id));
+        }
+
+        m_adapter_controller->apply(m_request, adapter_configs, config_ids);
+    }
+
     void _set_block_indices(ov::InferRequest& infer_request, const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output,
                             size_t total_num_blocks) {
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
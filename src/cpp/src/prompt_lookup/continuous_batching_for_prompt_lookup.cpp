@@ -0,0 +1,115 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "prompt_lookup/continuous_batching_for_prompt_lookup.hpp"
+
+namespace ov::genai {
+ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::ContinuousBatchingForPromptLookupImpl(
+    const std::filesystem::path& models_path,
+    const Tokenizer& tokenizer,
+    const SchedulerConfig& scheduler_config,
+    const std::string& device,
+    const ov::AnyMap& properties)
+    : ContinuousBatchingImpl(models_path, tokenizer, scheduler_config, device, properties) {
+    // candidates are validated by the same model that generates tokens
+    m_is_validation_mode_enabled = true;
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::pull_awaiting_requests() {
+    ContinuousBatchingImpl::_pull_awaiting_requests();
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates() {
+    m_candidates_info.clear();
+    std::map<uint64_t, NgramIndex> ngram_indexes;
+
+    for (auto& request : m_requests) {
+        const auto& sampling_params = request->get_sampling_parameters();
+        if (!sampling_params.is_prompt_lookup()) {
+            continue;
+        }
+        // greedy decoding has a single sequence, so indexes are kept per request
+        auto node = m_ngram_indexes.extract(request->get_request_id());
+        if (node.empty()) {
+            NgramIndex ngram_index(sampling_params.max_ngram_size);
+            ngram_index.append(request->get_prompt_ids());
+            ngram_indexes.emplace(request->get_request_id(), std::move(ngram_index));
+        } else {
+            ngram_indexes.insert(std::move(node));
+        }
+
+        // candidates can be proposed only when the prompt is processed and candidates of the previous step are validated
+        std::vector<Sequence::Ptr> running_sequences = request->get_running_sequences();
+        if (request->has_finished() || running_sequences.size() != 1 || request->get_num_tokens_to_validate() > 0 ||
+            request->get_num_processed_tokens() < request->get_prompt_len()) {
+            continue;
+        }
+        Sequence::Ptr sequence = running_sequences.front();
+
+        size_t generated_len = sequence->get_generated_len();
+        size_t max_new_tokens = sampling_params.get_max_new_tokens(request->get_prompt_len());
+        OPENVINO_ASSERT(max_new_tokens >= generated_len);
+        // one more token is always generated by the model after the candidates, so it's excluded from the remaining budget
+        size_t max_num_candidates = max_new_tokens > generated_len ?
+            std::min(sampling_params.num_assistant_tokens, max_new_tokens - generated_len - 1) : 0;
+
+        NgramIndex& ngram_index = ngram_indexes.at(request->get_request_id());
+        const auto& generated_ids = sequence->get_generated_ids();
+        if (ngram_index.get_token_ids().size() > request->get_prompt_len() + generated_ids.size()) {
+            // generated tokens were removed, so the index is rebuilt
+            ngram_index = NgramIndex(sampling_params.max_ngram_size);
+            ngram_index.append(request->get_prompt_ids());
+        }
+        for (size_t i = ngram_index.get_token_ids().size() - request->get_prompt_len(); i < generated_ids.size(); ++i) {
+            ngram_index.append(generated_ids[i]);
+        }
+
+        std::vector<std::vector<int64_t>> branches = ngram_index.propose_branches(max_num_candidates, sampling_params.max_candidate_branches);
+        if (max_num_candidates == 0 || branches.empty()) {
+            continue;
+        }
+
+        // all sequences of a request validate the same number of tokens, so shorter alternative branches are skipped
+        size_t num_candidates = branches.front().size();
+        for (size_t branch_idx = 1; branch_idx < branches.size(); ++branch_idx) {
+            if (branches[branch_idx].size() < num_candidates) {
+                continue;
+            }
+            // the fork shares KV cache blocks of the prompt and generated tokens with the sequence
+            Sequence::Ptr branch = request->fork_sequence(sequence);
+            m_scheduler->fork_sequence(sequence->get_id(), branch->get_id());
+            for (size_t i = 0; i < num_candidates; ++i) {
+                branch->append_token(branches[branch_idx][i], 0.0f);
+            }
+        }
+        for (int64_t token_id : branches.front()) {
+            // candidates are copied deterministically, so their draft probability is 1
+            sequence->append_token(token_id, 0.0f);
+        }
+        request->set_num_validated_tokens(num_candidates);
+        m_candidates_info[request->get_request_id()] = {generated_len, num_candidates};
+    }
+
+    // indexes of finished and dropped requests are released
+    m_ngram_indexes = std::move(ngram_indexes);
+}
+
+std::map<uint64_t, UpdateRequestResult>
+ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::get_validation_results() const {
+    std::map<uint64_t, UpdateRequestResult> results;
+    for (const auto& request : m_requests) {
+        auto it = m_candidates_info.find(request->get_request_id());
+        std::vector<Sequence::Ptr> running_sequences = request->get_running_sequences();
+        if (it == m_candidates_info.end() || running_sequences.empty()) {
+            continue;
+        }
+
+        const CandidatesInfo& info = it->second;
+        // accepted candidates are followed by one token generated by the model
+        size_t generated_len = running_sequences.front()->get_generated_len();
+        size_t num_accepted = generated_len > info.generated_len ? std::min(generated_len - info.generated_len - 1, info.num_candidates) : 0;
+        results.emplace(request->get_request_id(), UpdateRequestResult{info.num_candidates, info.num_candidates - num_accepted});
+    }
+    return results;
+}
+}
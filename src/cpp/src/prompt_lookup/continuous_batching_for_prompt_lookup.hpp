@@ -0,0 +1,48 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvino/genai/continuous_batching_pipeline.hpp"
+
+#include "continuous_batching_impl.hpp"
+#include "prompt_lookup/ngram_index.hpp"
+#include "speculative_decoding/update_request_structs.hpp"
+
+namespace ov::genai {
+class ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl : public ContinuousBatchingPipeline::ContinuousBatchingImpl {
+public:
+    ContinuousBatchingForPromptLookupImpl() = default;
+
+    ContinuousBatchingForPromptLookupImpl(const std::filesystem::path& models_path,
+                                          const Tokenizer& tokenizer,
+                                          const SchedulerConfig& scheduler_config,
+                                          const std::string& device,
+                                          const ov::AnyMap& properties);
+
+    void pull_awaiting_requests();
+
+    /**
+     * @brief Appends candidates copied from prompt and generated tokens to running sequences,
+     * so they are validated by the next step(). Alternative branches of candidates are appended to forks
+     * of the sequence, which are validated in the same step, and only the longest accepted branch is kept.
+     */
+    void generate_candidates();
+
+    /**
+     * @brief Returns numbers of inserted and removed candidates for every request validated by the last step().
+     */
+    std::map<uint64_t, UpdateRequestResult> get_validation_results() const;
+
+protected:
+    // request ID => n-gram index over prompt and validated generated tokens
+    std::map<uint64_t, NgramIndex> m_ngram_indexes;
+
+    struct CandidatesInfo {
+        size_t generated_len = 0;
+        size_t num_candidates = 0;
+    };
+    // request ID => generated len before candidates and number of candidates of the last step
+    std::map<uint64_t, CandidatesInfo> m_candidates_info;
+};
+}
@@ -0,0 +1,99 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "prompt_lookup/ngram_index.hpp"
+
+#include <algorithm>
+
+#include "openvino/core/except.hpp"
+
+namespace {
+
+uint64_t hash_combine(uint64_t seed, int64_t token_id) {
+    // 64-bit variant of boost::hash_combine
+    return seed ^ (static_cast<uint64_t>(token_id) + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4));
+}
+
+}  // namespace
+
+namespace ov::genai {
+
+NgramIndex::NgramIndex(size_t max_ngram_size) : m_max_ngram_size(max_ngram_size) {
+    OPENVINO_ASSERT(max_ngram_size > 0, "max_ngram_size must be greater than 0");
+}
+
+std::vector<uint64_t> NgramIndex::get_ngram_hashes(size_t end_position) const {
+    size_t max_ngram_size = std::min(m_max_ngram_size, end_position);
+    std::vector<uint64_t> hashes;
+    hashes.reserve(max_ngram_size);
+    uint64_t hash = 0;
+    for (size_t ngram_size = 1; ngram_size <= max_ngram_size; ++ngram_size) {
+        // n-grams are hashed from the end, so a hash of (n + 1)-gram extends a hash of n-gram
+        hash = hash_combine(hash, m_token_ids[end_position - ngram_size]);
+        hashes.push_back(hash_combine(hash, static_cast<int64_t>(ngram_size)));
+    }
+    return hashes;
+}
+
+bool NgramIndex::ngram_matches(size_t end_position, size_t other_end_position, size_t ngram_size) const {
+    return std::equal(m_token_ids.begin() + (end_position - ngram_size), m_token_ids.begin() + end_position,
+                      m_token_ids.begin() + (other_end_position - ngram_size));
+}
+
+void NgramIndex::append(int64_t token_id) {
+    // n-grams ending with the previous last token get a following token, so they can be indexed now,
+    // while the suffix of the sequence is not indexed to not match itself
+    size_t position = m_token_ids.size();
+    m_token_ids.push_back(token_id);
+    m_previous_positions.resize(m_token_ids.size() * m_max_ngram_size, 0);
+    std::vector<uint64_t> hashes = get_ngram_hashes(position);
+    for (size_t ngram_size = 1; ngram_size <= hashes.size(); ++ngram_size) {
+        // an n-gram is followed by at least one token, so position 0 is never stored
+        size_t& latest_position = m_positions[hashes[ngram_size - 1]];
+        m_previous_positions[position * m_max_ngram_size + ngram_size - 1] = latest_position;
+        latest_position = position;
+    }
+}
+
+void NgramIndex::append(const std::vector<int64_t>& token_ids) {
+    m_token_ids.reserve(m_token_ids.size() + token_ids.size());
+    for (int64_t token_id : token_ids) {
+        append(token_id);
+    }
+}
+
+std::vector<int64_t> NgramIndex::propose(size_t max_num_candidates) const {
+    std::vector<std::vector<int64_t>> branches = propose_branches(max_num_candidates, 1);
+    return branches.empty() ? std::vector<int64_t>{} : std::move(branches.front());
+}
+
+std::vector<std::vector<int64_t>> NgramIndex::propose_branches(size_t max_num_candidates, size_t max_num_branches) const {
+    // bounds the walk over occurrences of frequent n-grams whose continuations repeat
+    const size_t max_num_visited_occurrences = 4 * max_num_branches;
+
+    std::vector<std::vector<int64_t>> branches;
+    size_t end_position = m_token_ids.size();
+    std::vector<uint64_t> hashes = get_ngram_hashes(end_position);
+    for (size_t ngram_size = hashes.size(); ngram_size > 0 && branches.size() < max_num_branches; --ngram_size) {
+        auto it = m_positions.find(hashes[ngram_size - 1]);
+        if (it == m_positions.end())
+            continue;
+
+        size_t num_visited_occurrences = 0;
+        for (size_t position = it->second;
+             position != 0 && branches.size() < max_num_branches && num_visited_occurrences < max_num_visited_occurrences;
+             position = m_previous_positions[position * m_max_ngram_size + ngram_size - 1], ++num_visited_occurrences) {
+            // the index stores hashes only, so an occurrence has to be verified
+            if (position < ngram_size || !ngram_matches(end_position, position, ngram_size))
+                continue;
+
+            size_t num_candidates = std::min(max_num_candidates, end_position - position);
+            std::vector<int64_t> branch(m_token_ids.begin() + position, m_token_ids.begin() + (position + num_candidates));
+            if (std::find(branches.begin(), branches.end(), branch) == branches.end())
+                branches.push_back(std::move(branch));
+        }
+    }
+    return branches;
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,55 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ov::genai {
+
+/**
+ * @brief Hash index of n-grams of a growing token sequence which proposes continuation of the sequence
+ * by copying tokens that followed the latest earlier occurrence of its longest possible suffix.
+ * Appending a token updates the index in O(max_ngram_size), so lookups don't rescan the sequence.
+ */
+class NgramIndex {
+public:
+    explicit NgramIndex(size_t max_ngram_size);
+
+    void append(int64_t token_id);
+    void append(const std::vector<int64_t>& token_ids);
+
+    /**
+     * @brief Returns up to max_num_candidates tokens which followed an earlier occurrence of the longest suffix
+     * of the sequence not longer than max_ngram_size, or an empty vector if there is no such occurrence.
+     */
+    std::vector<int64_t> propose(size_t max_num_candidates) const;
+
+    /**
+     * @brief Returns up to max_num_branches distinct continuations of the sequence, each of up to max_num_candidates tokens.
+     * Occurrences of longer suffixes go first, and occurrences of the same suffix go from the latest one,
+     * so the first branch is the one returned by propose().
+     */
+    std::vector<std::vector<int64_t>> propose_branches(size_t max_num_candidates, size_t max_num_branches) const;
+
+    const std::vector<int64_t>& get_token_ids() const {
+        return m_token_ids;
+    }
+
+private:
+    size_t m_max_ngram_size;
+    std::vector<int64_t> m_token_ids;
+    // hash of n-gram and its size => position of a token following the latest occurrence of the n-gram
+    std::unordered_map<uint64_t, size_t> m_positions;
+    // position * max_ngram_size + ngram_size - 1 => position following the previous occurrence of the same n-gram or 0
+    std::vector<size_t> m_previous_positions;
+
+    // hashes of n-grams of sizes 1, 2, ... ending right before end_position
+    std::vector<uint64_t> get_ngram_hashes(size_t end_position) const;
+    bool ngram_matches(size_t end_position, size_t other_end_position, size_t ngram_size) const;
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,153 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "text_callback_streamer.hpp"
+#include "prompt_lookup/prompt_lookup_impl.hpp"
+#include "timer.hpp"
+
+namespace ov::genai {
+template<class... Ts> struct overloaded : Ts... {using Ts::operator()...;};
+template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
+
+ContinuousBatchingPipeline::PromptLookupImpl::PromptLookupImpl(const std::filesystem::path& models_path,
+                                                               const Tokenizer& tokenizer,
+                                                               const SchedulerConfig& scheduler_config,
+                                                               const std::string& device,
+                                                               const ov::AnyMap& properties) {
+    m_pipeline = std::make_shared<ContinuousBatchingForPromptLookupImpl>(models_path, tokenizer, scheduler_config, device, properties);
+    m_tokenizer = m_pipeline->get_tokenizer();
+    m_generation_config = m_pipeline->get_config();
+}
+
+GenerationHandle
+ContinuousBatchingPipeline::PromptLookupImpl::add_request(uint64_t request_id,
+                                                          const ov::Tensor& input_ids,
+                                                          ov::genai::GenerationConfig sampling_params) {
+    OPENVINO_ASSERT(!sampling_params.is_prompt_lookup() || sampling_params.is_greedy_decoding(),
+                    "Prompt lookup decoding is supported for greedy decoding only");
+    return m_pipeline->add_request(request_id, input_ids, sampling_params);
+}
+
+GenerationHandle
+ContinuousBatchingPipeline::PromptLookupImpl::add_request(uint64_t request_id,
+                                                          const std::string& prompt,
+                                                          ov::genai::GenerationConfig sampling_params) {
+    OPENVINO_ASSERT(!sampling_params.is_prompt_lookup() || sampling_params.is_greedy_decoding(),
+                    "Prompt lookup decoding is supported for greedy decoding only");
+    ov::Tensor input_ids = m_tokenizer.encode(prompt).input_ids;
+    return m_pipeline->add_request(request_id, input_ids, sampling_params);
+}
+
+bool ContinuousBatchingPipeline::PromptLookupImpl::has_non_finished_requests() {
+    return m_pipeline->has_non_finished_requests();
+}
+
+void ContinuousBatchingPipeline::PromptLookupImpl::set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) {
+    m_pipeline->set_batched_streamer(std::move(streamer));
+}
+
+void ContinuousBatchingPipeline::PromptLookupImpl::step() {
+    m_pipeline->pull_awaiting_requests();
+
+    ManualTimer candidates_timer("prompt_lookup_decoding: generate_candidates()");
+    candidates_timer.start();
+    m_pipeline->generate_candidates();
+    candidates_timer.end();
+    m_sd_metrics.draft_duration += candidates_timer.get_duration();
+
+    ManualTimer main_timer("prompt_lookup_decoding: step()");
+    main_timer.start();
+    m_pipeline->step();
+    main_timer.end();
+    m_sd_metrics.main_duration += main_timer.get_duration();
+    m_pipeline_metrics = m_pipeline->get_metrics();
+
+    for (const auto& [request_id, validation_result] : m_pipeline->get_validation_results()) {
+        float acceptance_rate = 1 - static_cast<float>(validation_result.removed_tokens_cnt) / validation_result.inserted_tokens_cnt;
+        m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
+        m_sd_metrics.update_draft_accepted_tokens(request_id, validation_result.inserted_tokens_cnt - validation_result.removed_tokens_cnt);
+        m_sd_metrics.update_draft_len(request_id, validation_result.inserted_tokens_cnt);
+    }
+}
+
+std::vector<EncodedGenerationResult>
+ContinuousBatchingPipeline::PromptLookupImpl::generate(const std::vector<ov::Tensor>& input_ids,
+                                                       const std::vector<GenerationConfig>& sampling_params,
+                                                       const StreamerVariant& streamer) {
+    ManualTimer generate_timer("prompt_lookup_decoding: generate()");
+    generate_timer.start();
+    OPENVINO_ASSERT(!has_non_finished_requests(), "Generate cannot be called while ContinuousBatchingPipeline is already in running state. Use ContinuousBatchingPipeline::add_request");
+    OPENVINO_ASSERT(input_ids.size() == sampling_params.size());
+    const std::shared_ptr<StreamerBase>& streamer_ptr = std::visit(overloaded{
+        [](std::monostate) -> std::shared_ptr<StreamerBase> {
+            return nullptr;
+        },
+        [](const std::shared_ptr<StreamerBase>& streamer) {
+            return streamer;
+        },
+        [this](const std::function<bool(std::string)>& streamer) -> std::shared_ptr<StreamerBase> {
+            return std::make_unique<TextCallbackStreamer>(m_tokenizer, streamer);
+        }
+    }, streamer);
+
+    OPENVINO_ASSERT(streamer_ptr == nullptr || input_ids.size() == 1 && sampling_params[0].is_greedy_decoding(),
+        "Currently streaming is possible only with batch size=1 and only for greedy decoding");
+
+    std::vector<GenerationHandle> generations;
+    for (size_t request_id = 0; request_id < input_ids.size(); ++request_id) {
+        OPENVINO_ASSERT(1 == input_ids[request_id].get_shape().at(0), "Use multiple tensors to pass a batch.");
+        generations.push_back(add_request(request_id, input_ids[request_id], sampling_params[request_id]));
+    }
+
+    bool continue_generation = true;
+    while (has_non_finished_requests() && continue_generation) {
+        step();
+        if (streamer_ptr) {
+            // several tokens can be generated by one step
+            if (!generations.at(0).get()->can_read()) {
+                continue;
+            }
+            std::unordered_map<uint64_t, GenerationOutput> token = generations.at(0).get()->back();
+            OPENVINO_ASSERT(1 == token.size());
+            for (const auto& gen_token : token.begin()->second.generated_ids) {
+                continue_generation = !streamer_ptr->put(gen_token);
+                if (!continue_generation) {
+                    break;
+                }
+            }
+        }
+    }
+    if (streamer_ptr) {
+        streamer_ptr->end();
+    }
+
+    std::vector<EncodedGenerationResult> results;
+    results.reserve(input_ids.size());
+    for (size_t generation_idx = 0; generation_idx < generations.size(); ++generation_idx) {
+        const auto& generation = generations[generation_idx];
+        if (!continue_generation) {
+            generation->drop();
+        }
+        EncodedGenerationResult result;
+        result.m_request_id = generation_idx;
+        std::vector<GenerationOutput> generation_outputs = generation->read_all();
+        for (const auto& generation_output : generation_outputs) {
+            m_sd_metrics.set_generated_len(generation_idx, generation_output.generated_ids.size());
+            result.m_generation_ids.push_back(std::move(generation_output.generated_ids));
+            result.m_scores.push_back(generation_output.score);
+        }
+        result.m_status = generation->get_status();
+        results.push_back(std::move(result));
+    }
+
+    OPENVINO_ASSERT(results.size() == input_ids.size());
+    generate_timer.end();
+    m_sd_metrics.total_duration = generate_timer.get_duration();
+    return results;
+}
+
+SpeculativeDecodingMetrics
+ContinuousBatchingPipeline::PromptLookupImpl::get_speculative_decoding_metrics() {
+    return m_sd_metrics;
+}
+}
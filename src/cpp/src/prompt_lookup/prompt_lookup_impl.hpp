@@ -0,0 +1,60 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvino/genai/continuous_batching_pipeline.hpp"
+#include "prompt_lookup/continuous_batching_for_prompt_lookup.hpp"
+#include "speculative_decoding/speculative_decoding_metrics.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Speculative decoding without a draft model: candidates are copied from prompt and generated tokens
+ * after an earlier occurrence of the last n-gram and validated by the main model in a single step.
+ */
+class ContinuousBatchingPipeline::PromptLookupImpl : public ContinuousBatchingPipeline::ImplInterface {
+protected:
+    std::shared_ptr<ContinuousBatchingForPromptLookupImpl> m_pipeline;
+    SpeculativeDecodingMetrics m_sd_metrics;
+
+public:
+    PromptLookupImpl(const std::filesystem::path& models_path,
+                     const Tokenizer& tokenizer,
+                     const SchedulerConfig& scheduler_config,
+                     const std::string& device,
+                     const ov::AnyMap& properties);
+
+    PromptLookupImpl(const std::filesystem::path& models_path,
+                     const SchedulerConfig& scheduler_config,
+                     const std::string& device,
+                     const ov::AnyMap& properties,
+                     const ov::AnyMap& tokenizer_properties)
+    : PromptLookupImpl{ models_path,
+                        Tokenizer(models_path, tokenizer_properties),
+                        scheduler_config,
+                        device,
+                        properties } {}
+
+    GenerationHandle add_request(uint64_t request_id,
+                                 const ov::Tensor& input_ids,
+                                 ov::genai::GenerationConfig sampling_params) override;
+    GenerationHandle add_request(uint64_t request_id,
+                                 const std::string& prompt,
+                                 ov::genai::GenerationConfig sampling_params) override;
+
+    bool has_non_finished_requests() override;
+
+    void set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) override;
+
+    void step() override;
+
+    std::vector<EncodedGenerationResult>
+    generate(const std::vector<ov::Tensor>& input_ids,
+             const std::vector<GenerationConfig>& sampling_params,
+             const StreamerVariant& streamer) override;
+
+    SpeculativeDecodingMetrics get_speculative_decoding_metrics();
+};
+
+}
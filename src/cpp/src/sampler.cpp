@@ -3,6 +3,8 @@
 
 #include "sampler.hpp"
 
+#include "openvino/core/parallel.hpp"
+
 namespace ov::genai {
 // Modified Knuth–Morris–Pratt algorithm which returns tokens following after every needle occurrence in haystack
 std::vector<int64_t> kmp_search(const std::vector<int64_t>& haystack, const std::vector<int64_t>& needle) {
@@ -67,6 +69,72 @@ std::vector<Token> log_softmax(const ov::Tensor& logits, size_t batch_idx) {
     return tokens;
 }
 
+std::vector<Token> log_softmax_top_k(const float* logits, size_t vocab_size, size_t top_k, float& log_norm) {
+    constexpr size_t BLOCK_SIZE = 16;
+    const float neg_infinity = -std::numeric_limits<float>::infinity();
+    auto greater_log_prob = [](const Token& left, const Token& right) {
+        return left.m_log_prob > right.m_log_prob;
+    };
+
+    top_k = std::min(top_k, vocab_size);
+    // min-heap of the most probable tokens seen so far, the least probable of them is the first
+    std::vector<Token> top_tokens;
+    top_tokens.reserve(top_k);
+
+    // logits are processed by fixed size blocks with per-lane accumulators, so the compiler can vectorize
+    // the inner loops, while the sum of exponents is rescaled every time the running maximum grows
+    float lane_sums[BLOCK_SIZE] = {};
+    float max_logit = neg_infinity;
+    for (size_t block_begin = 0; block_begin < vocab_size; block_begin += BLOCK_SIZE) {
+        const float* block = logits + block_begin;
+        const size_t block_size = std::min(BLOCK_SIZE, vocab_size - block_begin);
+
+        float block_max = neg_infinity;
+        for (size_t i = 0; i < block_size; ++i)
+            block_max = std::max(block_max, block[i]);
+        if (block_max > max_logit) {
+            if (max_logit != neg_infinity) {
+                const float scale = std::exp(max_logit - block_max);
+                for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                    lane_sums[i] *= scale;
+            }
+            max_logit = block_max;
+        }
+        if (max_logit != neg_infinity) {
+            for (size_t i = 0; i < block_size; ++i)
+                lane_sums[i] += std::exp(block[i] - max_logit);
+        }
+
+        // most blocks don't contain tokens more probable than the current top ones
+        if (top_tokens.size() < top_k || (top_k > 0 && block_max > top_tokens.front().m_log_prob)) {
+            for (size_t i = 0; i < block_size; ++i) {
+                if (top_tokens.size() < top_k) {
+                    top_tokens.emplace_back(block[i], int64_t(block_begin + i));
+                    std::push_heap(top_tokens.begin(), top_tokens.end(), greater_log_prob);
+                } else if (block[i] > top_tokens.front().m_log_prob) {
+                    std::pop_heap(top_tokens.begin(), top_tokens.end(), greater_log_prob);
+                    top_tokens.back() = Token(block[i], int64_t(block_begin + i));
+                    std::push_heap(top_tokens.begin(), top_tokens.end(), greater_log_prob);
+                }
+            }
+        }
+    }
+
+    log_norm = max_logit + std::log(std::accumulate(lane_sums, lane_sums + BLOCK_SIZE, 0.0f));
+    std::sort_heap(top_tokens.begin(), top_tokens.end(), greater_log_prob);
+    for (Token& token : top_tokens)
+        token.m_log_prob -= log_norm;
+    return top_tokens;
+}
+
+const float* get_last_token_logits(const ov::Tensor& logits, size_t batch_idx) {
+    ov::Shape shape = logits.get_shape();
+    OPENVINO_ASSERT(shape.size() == 3);
+    size_t batch = shape[0], seq_len = shape[1], vocab_size = shape[2];
+    OPENVINO_ASSERT(batch_idx < batch, "Logits batch size doesn't match the number of beams");
+    return logits.data<const float>() + (batch_idx * seq_len + seq_len - 1) * vocab_size;
+}
+
 std::vector<int64_t> wrap_tokens(const std::vector<int64_t>& tokens, const std::vector<int64_t>& prefix_tokens, const std::vector<int64_t>& suffix_tokens) {
     std::vector<int64_t> all_tokens = prefix_tokens;
     all_tokens.insert(all_tokens.end(), tokens.begin(), tokens.end());
@@ -245,14 +313,54 @@ std::map<size_t, int32_t> Sampler::GroupBeamSearcher::get_beam_idxs() {
     return next_beams;
 }
 
+size_t Sampler::GroupBeamSearcher::prepare_top_tokens() {
+    m_running_sequences = m_sequence_group->get_running_sequences();
+    m_top_tokens.assign(m_running_sequences.size(), TopTokens{});
+
+    for (Group& group : m_groups) {
+        if (!group.done) {
+            for (Beam& beam : group.ongoing) {
+                // here we need to map index of sequence in beam search group(s) and sequence group
+                auto running_seq_it = std::find(m_running_sequences.begin(), m_running_sequences.end(), beam.m_sequence);
+                OPENVINO_ASSERT(running_seq_it != m_running_sequences.end(), "Internal error in beam search: should not be here");
+                beam.m_global_beam_idx = std::distance(m_running_sequences.begin(), running_seq_it);
+            }
+        }
+    }
+
+    return m_running_sequences.size();
+}
+
+void Sampler::GroupBeamSearcher::compute_top_tokens(const ov::Tensor& logits, size_t row) {
+    OPENVINO_ASSERT(row < m_top_tokens.size());
+    size_t group_size = m_parameters.num_beams / m_parameters.num_beam_groups;
+    size_t vocab_size = logits.get_shape().back();
+    TopTokens& top_tokens = m_top_tokens[row];
+
+    // apply n_gramm
+    const Sequence::Ptr& sequence = m_running_sequences[row];
+    std::vector<int64_t> full_text{m_sequence_group->get_prompt_ids()};
+    full_text.insert(full_text.end(), sequence->get_generated_ids().begin(), sequence->get_generated_ids().end());
+    if (full_text.size() > 1 && full_text.size() >= m_parameters.no_repeat_ngram_size) {
+        auto tail_start = full_text.end() - ptrdiff_t(m_parameters.no_repeat_ngram_size) + 1;
+        top_tokens.banned_tokens = kmp_search(full_text, {tail_start, full_text.end()});
+    }
+
+    // penalties change log probs of a few tokens only, so it's enough to keep 2 * group_size tokens
+    // in addition to every token which can be penalized
+    size_t num_penalized_tokens = top_tokens.banned_tokens.size();
+    if (m_parameters.diversity_penalty != 0.0f)
+        num_penalized_tokens += (m_groups.size() - 1) * group_size;
+    top_tokens.tokens = log_softmax_top_k(get_last_token_logits(logits, row), vocab_size,
+                                          2 * group_size + num_penalized_tokens, top_tokens.log_norm);
+}
+
 void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output) {
     assert(m_parameters.num_beams % m_parameters.num_beam_groups == 0 &&
         "number of beams should be divisible by number of groups");
     size_t group_size = m_parameters.num_beams / m_parameters.num_beam_groups;
-    std::vector<int64_t> next_tokens;
-    std::vector<int32_t> next_beams;
-    next_tokens.reserve(m_parameters.num_beams);
-    next_beams.reserve(m_parameters.num_beams);
+    OPENVINO_ASSERT(m_top_tokens.size() == m_sequence_group->num_running_seqs(),
+                    "Top tokens must be computed before beam search selects next tokens");
 
     // parent sequence ID -> number of child sequences
     std::map<uint64_t, uint64_t> parent_2_num_childs_map;
@@ -260,20 +368,8 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits, Sa
     for (Group& group : m_groups) {
         if (!group.done) {
             for (Beam& beam : group.ongoing) {
-                uint64_t parent_seq_id = beam.m_sequence->get_id();
-
-                // here we need to map index of sequence in beam search group(s) and sequence group
-                beam.m_global_beam_idx = [this] (uint64_t seq_id) -> size_t {
-                    std::vector<Sequence::Ptr> running_seqs = m_sequence_group->get_running_sequences();
-                    for (size_t seq_global_index = 0; seq_global_index < running_seqs.size(); ++seq_global_index) {
-                        if (seq_id == running_seqs[seq_global_index]->get_id())
-                            return seq_global_index;
-                    }
-                    OPENVINO_THROW("Internal error in beam search: should not be here");
-                } (parent_seq_id);
-
                 // zero out all parent forks counts
-                parent_2_num_childs_map[parent_seq_id] = 0;
+                parent_2_num_childs_map[beam.m_sequence->get_id()] = 0;
             }
         }
     }
@@ -326,29 +422,41 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits, Sa
         std::vector<Beam> candidates;
         candidates.reserve(group_size * 2 * group_size);
         for (const Beam& beam : group.ongoing) {
-            std::vector<Token> tokens = log_softmax(logits, beam.m_global_beam_idx);
+            const TopTokens& top_tokens = m_top_tokens[beam.m_global_beam_idx];
+            const float* beam_logits = get_last_token_logits(logits, beam.m_global_beam_idx);
 
+            // token ID => log prob change
+            std::map<int64_t, float> penalties;
             // apply diversity penalty
-            for (auto prev_group_id = 0; prev_group_id < group_id; ++prev_group_id) {
-                for (const Beam& prev_beam : child_beams_per_group[prev_group_id]) {
-                    tokens[prev_beam.m_token_id].m_log_prob -= m_parameters.diversity_penalty;
+            if (m_parameters.diversity_penalty != 0.0f) {
+                for (auto prev_group_id = 0; prev_group_id < group_id; ++prev_group_id) {
+                    for (const Beam& prev_beam : child_beams_per_group[prev_group_id]) {
+                        penalties[prev_beam.m_token_id] -= m_parameters.diversity_penalty;
+                    }
                 }
             }
-
             // apply n_gramm
-            std::vector<int64_t> full_text{m_sequence_group->get_prompt_ids()};
-            full_text.insert(full_text.end(), beam.m_sequence->get_generated_ids().begin(), beam.m_sequence->get_generated_ids().end());
-            if (full_text.size() > 1 && full_text.size() >= m_parameters.no_repeat_ngram_size) {
-                auto tail_start = full_text.end() - ptrdiff_t(m_parameters.no_repeat_ngram_size) + 1;
-                for (int64_t banned_token : kmp_search(full_text, {tail_start, full_text.end()})) {
-                    tokens[banned_token].m_log_prob = -std::numeric_limits<float>::infinity();
-                }
+            for (int64_t banned_token : top_tokens.banned_tokens) {
+                penalties[banned_token] = -std::numeric_limits<float>::infinity();
+            }
+
+            // merge top tokens which are not penalized with the penalized ones
+            std::vector<Token> tokens;
+            tokens.reserve(top_tokens.tokens.size() + penalties.size());
+            for (const Token& token : top_tokens.tokens) {
+                if (penalties.find(token.m_index) == penalties.end())
+                    tokens.push_back(token);
+            }
+            for (const auto& [token_id, penalty] : penalties) {
+                tokens.emplace_back(beam_logits[token_id] - top_tokens.log_norm + penalty, token_id);
             }
 
             // sort tokens
-            std::sort(tokens.begin(), tokens.end(), [](Token left, Token right) {
+            auto tokens_to_sort = tokens.begin() + ptrdiff_t(std::min(2 * group_size, tokens.size()));
+            std::partial_sort(tokens.begin(), tokens_to_sort, tokens.end(), [](const Token& left, const Token& right) {
                 return left.m_log_prob > right.m_log_prob;  // Most probable tokens in front
             });
+            tokens.erase(tokens_to_sort, tokens.end());
 
             size_t add_count = 0;
             for (Token token : tokens) {
@@ -478,6 +586,10 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits, Sa
             group.ongoing = child_beams_per_group[group_id];
         }
     }
+
+    // top tokens are valid for the current step only
+    m_running_sequences.clear();
+    m_top_tokens.clear();
 }
 
 Logits Sampler::_get_logit_vector(ov::Tensor logits, size_t batch_idx, size_t token_idx) {
@@ -666,6 +778,34 @@ align_all_sequence_len(SequenceGroup::Ptr& sequence_group,
     logit_processor.update_generated_len(min_generated_tokens);
 }
 
+// candidate branches of greedy decoding are validated as separate sequences, so only the branch with the most
+// accepted tokens is kept, while it takes over the place of the first sequence in outputs
+size_t
+keep_longest_branch(SequenceGroup::Ptr& sequence_group,
+                    size_t validated_len,
+                    LogitProcessor& logit_processor,
+                    SamplerOutput& sampler_output) {
+    std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
+    Sequence::Ptr longest_branch = *std::max_element(running_sequences.begin(), running_sequences.end(),
+        [] (const Sequence::Ptr& lhs, const Sequence::Ptr& rhs) {
+            return lhs->get_generated_len() < rhs->get_generated_len();
+        });
+    uint64_t grouped_id = running_sequences.front()->get_grouped_id();
+    for (const auto& sequence : running_sequences) {
+        if (sequence != longest_branch) {
+            sequence_group->remove_sequence(sequence->get_id());
+            sampler_output.m_dropped_sequences.push_back(sequence->get_id());
+        }
+    }
+    longest_branch->set_grouped_id(grouped_id);
+
+    const auto& generated_ids = longest_branch->get_generated_ids();
+    for (size_t i = validated_len; i < generated_ids.size(); ++i) {
+        logit_processor.register_new_generated_token(generated_ids[i]);
+    }
+    return generated_ids.size();
+}
+
 bool Sampler::validate_candidate(
     Sequence::Ptr running_sequence,
     size_t& token_idx,
@@ -749,6 +889,9 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
     size_t batch_seq_len = logits_shape[1], vocab_size = logits_shape[2];
 
     SamplerOutput sampler_output;
+    std::vector<ov::Tensor> sequence_groups_logits(sequence_groups.size());
+    // (beam searcher, sequence group index, row of logits) for every row whose top tokens are required by beam search
+    std::vector<std::tuple<GroupBeamSearcher*, size_t, size_t>> beam_search_rows;
     for (size_t sequence_group_id = 0, currently_processed_tokens = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
         SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
         if (!sequence_group->is_scheduled())
@@ -757,25 +900,61 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
         size_t num_running_sequences = sequence_group->num_running_seqs();
         size_t actual_seq_len = sequence_group->get_num_scheduled_tokens(); // points to a token which needs to be sampled
         size_t padded_amount_of_processed_tokens = std::max(actual_seq_len, batch_seq_len);
+
+        const void * sequence_group_logits_data = logits_data + vocab_size * currently_processed_tokens;
+        sequence_groups_logits[sequence_group_id] = ov::Tensor(ov::element::f32, ov::Shape{num_running_sequences, actual_seq_len, vocab_size}, (void *)sequence_group_logits_data);
+
+        if (sequence_group->requires_sampling() && sequence_group->get_sampling_parameters().is_beam_search()) {
+            uint64_t request_id = sequence_group->get_request_id();
+
+            // create beam search info if we are on the first generate
+            if (m_beam_search_info.find(request_id) == m_beam_search_info.end()) {
+                m_beam_search_info.emplace(request_id, GroupBeamSearcher(sequence_group, m_tokenizer));
+            }
+
+            GroupBeamSearcher& beam_searcher = m_beam_search_info.at(request_id);
+            for (size_t row = 0, num_rows = beam_searcher.prepare_top_tokens(); row < num_rows; ++row) {
+                beam_search_rows.emplace_back(&beam_searcher, sequence_group_id, row);
+            }
+        }
+
+        // accumulate a number of processed tokens
+        currently_processed_tokens += padded_amount_of_processed_tokens * num_running_sequences;
+    }
+
+    // top tokens of beams are independent across beams and requests, so the most expensive part of beam search runs in parallel
+    ov::parallel_for(beam_search_rows.size(), [&](size_t i) {
+        auto& [beam_searcher, sequence_group_id, row] = beam_search_rows[i];
+        beam_searcher->compute_top_tokens(sequence_groups_logits[sequence_group_id], row);
+    });
+
+    for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
+        SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
+        if (!sequence_group->is_scheduled())
+            continue;
+
+        size_t num_running_sequences = sequence_group->num_running_seqs();
         const ov::genai::GenerationConfig& sampling_params = sequence_group->get_sampling_parameters();
 
         const auto request_id = sequence_group->get_request_id();
         if (!m_logit_processors.count(request_id)) {
-            m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids())});
+            m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids(), _get_structured_output_automaton(sampling_params))});
         }
         auto& logit_processor = m_logit_processors.at(request_id);
 
-        const void * sequence_group_logits_data = logits_data + vocab_size * currently_processed_tokens;
-        ov::Tensor sequence_group_logits(ov::element::f32, ov::Shape{num_running_sequences, actual_seq_len, vocab_size}, (void *)sequence_group_logits_data);
+        const ov::Tensor& sequence_group_logits = sequence_groups_logits[sequence_group_id];
         size_t max_removed_tokens_per_request = 0, min_generated_len = std::numeric_limits<size_t>::max();
         if (sequence_group->requires_sampling()) {
             // get number of token to be validated
             auto num_tokens_to_process = sequence_group->get_num_tokens_to_validate();
             if (sampling_params.is_greedy_decoding() || sampling_params.is_multinomial()) {
                 std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
+                // several sequences of greedy decoding are alternative branches of candidates
+                bool is_branch_validation = sampling_params.is_greedy_decoding() && num_running_sequences > 1;
                 if (sampling_params.is_greedy_decoding()) {
-                    OPENVINO_ASSERT(num_running_sequences == 1);
+                    OPENVINO_ASSERT(num_running_sequences == 1 || is_validation_mode_enabled);
                 }
+                size_t validated_len = is_branch_validation ? running_sequences.front()->get_generated_len() - num_tokens_to_process : 0;
                 for (size_t running_sequence_id = 0; running_sequence_id < num_running_sequences; ++running_sequence_id) {
                     auto& running_sequence = running_sequences[running_sequence_id];
                     bool is_validation_passed = true;
@@ -801,6 +980,7 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
                         }
 
                         auto logit_vector = _get_logit_vector(sequence_group_logits, running_sequence_id, token_offset);
+                        logit_processor.set_current_sequence(running_sequence->get_id(), running_sequence->get_generated_ids(), generated_and_verified_len);
                         logit_processor.apply(logit_vector);
 
                         Token sampled_token;
@@ -853,8 +1033,20 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
                             break;
                         }
                     }
+                    if (is_branch_validation) {
+                        // tokens of a branch are not counted by other branches, the kept branch is registered again
+                        const auto& generated_ids = running_sequence->get_generated_ids();
+                        for (size_t i = validated_len; i < generated_ids.size(); ++i) {
+                            logit_processor.decrease_generated_token_occurance(generated_ids[i]);
+                        }
+                    }
                     min_generated_len = std::min(min_generated_len, running_sequence->get_generated_len());
                 }
+                if (is_branch_validation) {
+                    min_generated_len = keep_longest_branch(sequence_group, validated_len, logit_processor, sampler_output);
+                    OPENVINO_ASSERT(min_generated_len > validated_len);
+                    max_removed_tokens_per_request = validated_len + num_tokens_to_process + 1 - min_generated_len;
+                }
                 align_all_sequence_len(sequence_group, min_generated_len, logit_processor);
                 for (const auto& dropped_seq_id : _try_finish_generation(sequence_group)) {
                     sampler_output.m_dropped_sequences.push_back(dropped_seq_id);
@@ -862,11 +1054,6 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
             } else if (sampling_params.is_beam_search()) {
                 uint64_t request_id = sequence_group->get_request_id();
 
-                // create beam search info if we are on the first generate
-                if (m_beam_search_info.find(request_id) == m_beam_search_info.end()) {
-                    m_beam_search_info.emplace(request_id, GroupBeamSearcher(sequence_group, m_tokenizer));
-                }
-
                 // current algorithm already adds new tokens to running sequences and
                 m_beam_search_info.at(request_id).select_next_tokens(sequence_group_logits, sampler_output);
 
@@ -897,9 +1084,6 @@ SamplerOutput Sampler::sample(std::vector<SequenceGroup::Ptr> & sequence_groups,
             sequence_group->update_processed_tokens_num(min_processed_tokens);
             logit_processor.update_generated_len(min_processed_tokens);
         }
-
-        // accumulate a number of processed tokens
-        currently_processed_tokens += padded_amount_of_processed_tokens * num_running_sequences;
     }
 
     return sampler_output;
@@ -912,7 +1096,14 @@ LogitProcessor& Sampler::get_logit_processor(uint64_t request_id) {
 
 
 void Sampler::create_logit_processor(uint64_t request_id, const GenerationConfig& sampling_params, const TokenIds& prompt) {
-    m_logit_processors.insert({request_id, LogitProcessor(sampling_params, prompt)});
+    m_logit_processors.insert({request_id, LogitProcessor(sampling_params, prompt, _get_structured_output_automaton(sampling_params))});
+}
+
+std::shared_ptr<TokenAutomaton> Sampler::_get_structured_output_automaton(const GenerationConfig& sampling_params) {
+    if (!sampling_params.structured_output_config.has_value())
+        return nullptr;
+    OPENVINO_ASSERT(m_structured_output_cache, "Structured output requires a Sampler created with a tokenizer");
+    return m_structured_output_cache->get(*sampling_params.structured_output_config);
 }
 
 void Sampler::clear_request_info(uint64_t request_id) { 
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <random>
 #include <set>
+#include <tuple>
 
 #include "openvino/runtime/tensor.hpp"
 
@@ -32,6 +33,14 @@ inline bool is_stop_token_id_hit(int64_t generated_token, const std::set<int64_t
 
 std::vector<Token> log_softmax(const ov::Tensor& logits, size_t batch_idx);
 
+/**
+ * @brief Computes log softmax of logits and selects top_k most probable tokens in a single pass without
+ * materializing the whole vocabulary.
+ * @param log_norm is set to the log of softmax denominator, so log probability of any token is logit - log_norm.
+ * @return top_k tokens with their log probabilities, the most probable ones in front.
+ */
+std::vector<Token> log_softmax_top_k(const float* logits, size_t vocab_size, size_t top_k, float& log_norm);
+
 struct SamplerOutput {
     // IDs of sequences that need to be dropped
     std::vector<uint64_t> m_dropped_sequences;
@@ -47,6 +56,7 @@ class Sampler {
     Token _greedy_sample(const Logits& logits, size_t top_logprobs) const;
     std::vector<Token> _multinomial_sample(const Logits& logits, size_t num_tokens_per_sequence);
     std::vector<int64_t> _try_finish_generation(SequenceGroup::Ptr & sequence_group);
+    std::shared_ptr<TokenAutomaton> _get_structured_output_automaton(const GenerationConfig& sampling_params);
 
     bool validate_candidate(Sequence::Ptr running_sequence, size_t& token_idx, Token& sampled_token,
                             bool& is_extend_sequence, size_t& max_removed_tokens, bool do_sample);
@@ -59,10 +69,12 @@ class Sampler {
     std::map<uint64_t, LogitProcessor> m_logit_processors;
 
     Tokenizer m_tokenizer;
+    // compiled automatons are shared by requests with the same structured output config
+    std::shared_ptr<StructuredOutputCache> m_structured_output_cache = nullptr;
 
 public:
     Sampler() = default;
-    Sampler(Tokenizer & tokenizer) : m_tokenizer(tokenizer) {};
+    Sampler(Tokenizer & tokenizer) : m_tokenizer(tokenizer), m_structured_output_cache(std::make_shared<StructuredOutputCache>(tokenizer)) {};
 
     SamplerOutput sample(std::vector<SequenceGroup::Ptr> & sequence_groups, ov::Tensor logits, bool is_validation_mode_enabled = false);
     void set_seed(size_t seed) { rng_engine.seed(seed); }
@@ -99,6 +111,13 @@ class Sampler::GroupBeamSearcher {
         return left.m_score > right.m_score;
     }
 
+    // the most probable tokens for a row of logits, beams made on top of the same sequence share them
+    struct TopTokens {
+        std::vector<Token> tokens;  // Most probable tokens in front
+        float log_norm = 0.0f;
+        std::vector<int64_t> banned_tokens;  // tokens prohibited by no_repeat_ngram_size
+    };
+
     struct Group {
         std::vector<Beam> ongoing;  // Best beams in front
         std::vector<Beam> min_heap;  // The worst of the best completed beams is the first
@@ -112,9 +131,21 @@ class Sampler::GroupBeamSearcher {
     ov::genai::GenerationConfig m_parameters;
     std::vector<Group> m_groups;
     Tokenizer m_tokenizer;
+    // running sequences and their top tokens indexed by global beam index
+    std::vector<Sequence::Ptr> m_running_sequences;
+    std::vector<TopTokens> m_top_tokens;
 public:
     explicit GroupBeamSearcher(SequenceGroup::Ptr sequence_group, Tokenizer tokenizer);
 
+    /**
+     * @brief Maps ongoing beams to rows of logits.
+     * @return number of rows whose top tokens must be computed by compute_top_tokens before select_next_tokens
+     */
+    size_t prepare_top_tokens();
+    /**
+     * @brief Computes top tokens for a row of logits. Different rows can be computed concurrently.
+     */
+    void compute_top_tokens(const ov::Tensor& logits, size_t row);
     void select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output);
     void finalize(SamplerOutput& sampler_output);
     std::map<size_t, int32_t> get_beam_idxs();
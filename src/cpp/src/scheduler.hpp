@@ -46,6 +46,10 @@ public:
     Output schedule(std::vector<SequenceGroup::Ptr>& sequence_groups) {
         Output scheduler_output;
 
+        if (m_config.session_idle_timeout > 0) {
+            m_block_manager.release_idle_sessions(m_config.session_idle_timeout);
+        }
+
         if (m_config.dynamic_split_fuse) {
             // deepspeed-mii case
             // generation phase is always scheduled first
@@ -99,6 +103,18 @@ public:
         m_block_manager.restore_cached_blocks(sequence_group);
     }
 
+    void pin_session(uint64_t session_id, uint64_t seq_id, TokenIds token_ids) {
+        m_block_manager.pin_session(session_id, seq_id, std::move(token_ids));
+    }
+
+    void restore_session(uint64_t session_id, const SequenceGroup::Ptr& sequence_group) {
+        m_block_manager.restore_session(session_id, sequence_group);
+    }
+
+    void release_session(uint64_t session_id) {
+        m_block_manager.release_session(session_id);
+    }
+
     const SchedulerConfig& get_config() const {
         return m_config;
     }
@@ -191,6 +207,10 @@ private:
 
         // check whether current sequence requires a new slot / block
         while (!m_block_manager.can_append_slots(sequence_group)) {
+            // idle chat sessions are demoted before running sequences are preempted
+            if (m_block_manager.release_lru_session()) {
+                continue;
+            }
             // let's run a sequence for eviction
             size_t evicted_sequence_group_id = _get_low_priority_sequence_group_id(sequence_groups);
 
@@ -236,7 +256,10 @@ private:
                 OPENVINO_ASSERT(currently_allocated_token_slots >= occupied_token_slots, "internal error");
                 size_t available_slots = currently_allocated_token_slots - occupied_token_slots,
                        required_slots = num_scheduled_tokens > available_slots ? num_scheduled_tokens - available_slots : 0;
-                size_t num_required_blocks = (required_slots + block_size - 1) / block_size, num_free_blocks = m_block_manager.num_free_blocks();
+                size_t num_required_blocks = (required_slots + block_size - 1) / block_size;
+                // idle chat sessions are demoted to free space for prompts
+                while (num_required_blocks > m_block_manager.num_free_blocks() && m_block_manager.release_lru_session());
+                size_t num_free_blocks = m_block_manager.num_free_blocks();
                 size_t num_scheduled_blocks = std::min(num_required_blocks, num_free_blocks);
                 // some scheduled blocks can be no fully occupied, so we need to take min between num_scheduled_blocks
                 // and total "scheduled capacity"
@@ -350,7 +373,8 @@ private:
                 // prompt phases can have a single running sequence
                 OPENVINO_ASSERT(num_running_seqs == 1);
                 // here we also assume that sequence must be scheduler in a single shot and has no already generated context
-                if (!m_config.enable_prefix_caching)
+                // except blocks restored by prefix caching or from a chat session
+                if (!m_config.enable_prefix_caching && !m_block_manager.has_block_table((*sequence_group)[0]->get_id()))
                     OPENVINO_ASSERT(sequence_group->get_context_len() == 0);
                 size_t num_available_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
                 size_t sequence_len = sequence_group->get_num_available_tokens_for_batching();
@@ -370,6 +394,8 @@ private:
                 // apply KV cache limitations
                 size_t block_size = get_block_size();
                 const size_t num_required_blocks = (sequence_len + block_size - 1) / block_size;
+                // idle chat sessions are demoted to free space for prompts
+                while (!m_block_manager.can_allocate_blocks(num_required_blocks) && m_block_manager.release_lru_session());
                 if (!m_block_manager.can_allocate_blocks(num_required_blocks))
                     break;
 
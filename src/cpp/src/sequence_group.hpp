@@ -54,6 +54,7 @@ public:
     // don't use directly
     Sequence(const Sequence& seq, const uint64_t id) :
         m_generated_ids(seq.m_generated_ids),
+        m_generated_log_probs(seq.m_generated_log_probs),
         m_grouped_id(id),
         m_status(seq.m_status),
         m_cumulative_log_prob(seq.m_cumulative_log_prob){
@@ -80,6 +81,11 @@ public:
         return m_grouped_id;
     }
 
+    // used when a fork replaces its parent, so outputs of the parent are continued by the fork
+    void set_grouped_id(uint64_t grouped_id) {
+        m_grouped_id = grouped_id;
+    }
+
     bool has_finished() const {
         return m_status == SequenceStatus::FINISHED;
     }
@@ -131,8 +137,8 @@ public:
         OPENVINO_ASSERT(m_generated_ids.size());
         output.score = get_cumulative_log_probs();
 
-        auto generated_token_id = get_generated_ids();
-        auto generated_log_probs = get_generated_log_probs();
+        const auto& generated_token_id = get_generated_ids();
+        const auto& generated_log_probs = get_generated_log_probs();
 
         OPENVINO_ASSERT(get_generated_len() >= token_cnt);
         auto offset = get_generated_len() - token_cnt;
@@ -567,6 +573,11 @@ public:
         return m_generation_stream;
     }
 
+    // used when a handle is returned to the user before the group is created, e.g. while its prompt is tokenized
+    void set_generation_stream(GenerationStream::Ptr generation_stream) {
+        m_generation_stream = generation_stream;
+    }
+
     void set_generation_status(GenerationStatus status) {
         m_generation_stream->set_generation_status(status);
     }
@@ -579,37 +590,65 @@ public:
         m_generation_stream->push({});
     }
 
+    // Pushes full results of a finished group. Token vectors are copied only when the handle reads them,
+    // so the sequences must not be modified after this call.
     void push_outputs() {
-        GenerationOutputs outputs;
+        struct SequenceResult {
+            Sequence::CPtr sequence;
+            float score;
+            GenerationFinishReason finish_reason;
+        };
+        std::vector<SequenceResult> results;
+        results.reserve(m_sequences.size());
         for (auto& sequence: m_sequences) {
-            GenerationOutput output;
-            output.generated_ids = sequence->get_generated_ids();
-            output.generated_log_probs = sequence->get_generated_log_probs();
-            if (m_sampling_params.echo) {
-                output.generated_ids.insert(output.generated_ids.begin(), m_prompt_ids.begin(), m_prompt_ids.end());
-                output.generated_log_probs.insert(output.generated_log_probs.begin(), m_prompt_log_probs.begin(), m_prompt_log_probs.end());
-            }
-            output.score = m_sampling_params.is_beam_search() ? sequence->get_beam_search_score(m_sampling_params) : sequence->get_cumulative_log_probs();
-            output.finish_reason = sequence->get_finish_reason();
-            outputs.emplace(sequence->get_grouped_id(), output);
+            float score = m_sampling_params.is_beam_search() ? sequence->get_beam_search_score(m_sampling_params) : sequence->get_cumulative_log_probs();
+            results.push_back({sequence, score, sequence->get_finish_reason()});
         }
-        m_generation_stream->push(std::move(outputs));
+
+        TokenIds prompt_ids;
+        LogProbs prompt_log_probs;
+        if (m_sampling_params.echo) {
+            prompt_ids = m_prompt_ids;
+            prompt_log_probs = m_prompt_log_probs;
+        }
+
+        m_generation_stream->push_final([results = std::move(results), prompt_ids = std::move(prompt_ids), prompt_log_probs = std::move(prompt_log_probs)] {
+            GenerationOutputs outputs;
+            for (const auto& result : results) {
+                GenerationOutput output;
+                output.generated_ids = prompt_ids;
+                output.generated_log_probs = prompt_log_probs;
+                const TokenIds& generated_ids = result.sequence->get_generated_ids();
+                const LogProbs& generated_log_probs = result.sequence->get_generated_log_probs();
+                output.generated_ids.insert(output.generated_ids.end(), generated_ids.begin(), generated_ids.end());
+                output.generated_log_probs.insert(output.generated_log_probs.end(), generated_log_probs.begin(), generated_log_probs.end());
+                output.score = result.score;
+                output.finish_reason = result.finish_reason;
+                outputs.emplace(result.sequence->get_grouped_id(), std::move(output));
+            }
+            return outputs;
+        });
     }
 
     void push_partial_outputs(size_t token_cnt = 1) {
-        GenerationOutputs outputs;
         for (auto& sequence : m_sequences) {
             // todo: check seq.is_finished() to generate without several </s>
             // or is it ok to use padding?
-            auto output = sequence->get_last_generation_output(token_cnt);
+            const TokenIds& generated_ids = sequence->get_generated_ids();
+            const LogProbs& generated_log_probs = sequence->get_generated_log_probs();
+            OPENVINO_ASSERT(generated_ids.size() && generated_ids.size() >= token_cnt);
+            const size_t offset = generated_ids.size() - token_cnt;
+            const uint64_t sequence_id = sequence->get_grouped_id();
+            const float score = sequence->get_cumulative_log_probs();
             if (m_sampling_params.echo && !m_has_echoed) {
-                output.generated_ids.insert(output.generated_ids.begin(), m_prompt_ids.begin(), m_prompt_ids.end());
-                output.generated_log_probs.insert(output.generated_log_probs.begin(), m_prompt_log_probs.begin(), m_prompt_log_probs.end());
+                m_generation_stream->append(sequence_id, m_prompt_ids.data(), m_prompt_log_probs.data(), m_prompt_ids.size(),
+                                            score, sequence->get_finish_reason());
             }
-            outputs.emplace(sequence->get_grouped_id(), output);
+            m_generation_stream->append(sequence_id, generated_ids.data() + offset, generated_log_probs.data() + offset, token_cnt,
+                                        score, sequence->get_finish_reason());
         }
         m_has_echoed = true;
-        m_generation_stream->push(std::move(outputs));
+        m_generation_stream->commit();
     }
 
     void notify_handle(size_t num_output_token_to_push = 0) {
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+
+namespace ov::genai {
+
+// LRU cache with a budget for the total byte size of its values, the most recently used item is at the front.
+// The most recently inserted item is kept even if it alone exceeds the budget.
+// Keys are looked up by a predicate, so they don't need to be hashable or ordered.
+template <typename Key, typename Value>
+class SizeBoundedLRUCache {
+public:
+    struct Item {
+        Key key;
+        Value value;
+        size_t byte_size;
+    };
+
+    // Returns the first item satisfying the predicate and makes it the most recently used one, nullptr if there is none
+    template <typename Predicate>
+    Item* find_if(Predicate predicate) {
+        auto found = std::find_if(m_items.begin(), m_items.end(), [&predicate](const Item& item) {
+            return predicate(item.key);
+        });
+        if (found == m_items.end()) {
+            return nullptr;
+        }
+        m_items.splice(m_items.begin(), m_items, found);
+        return &m_items.front();
+    }
+
+    // Returns the most recently used item, nullptr if the cache is empty
+    Item* front() {
+        return m_items.empty() ? nullptr : &m_items.front();
+    }
+
+    // Inserts the item as the most recently used one and evicts the least recently used items exceeding the budget
+    Item& insert(Key key, Value value, size_t byte_size, size_t budget) {
+        m_items.push_front(Item{std::move(key), std::move(value), byte_size});
+        m_byte_size += byte_size;
+        while (m_items.size() > 1 && m_byte_size > budget) {
+            m_byte_size -= m_items.back().byte_size;
+            m_items.pop_back();
+        }
+        return m_items.front();
+    }
+
+    size_t size() const {
+        return m_items.size();
+    }
+
+    size_t get_byte_size() const {
+        return m_byte_size;
+    }
+
+private:
+    std::list<Item> m_items;
+    size_t m_byte_size = 0;
+};
+
+}  // namespace ov::genai
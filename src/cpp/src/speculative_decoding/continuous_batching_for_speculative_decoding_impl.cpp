@@ -43,6 +43,14 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::f
     }
 }
 
+void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pause_requests(const std::set<uint64_t>& request_ids) {
+    for (auto& request : m_requests) {
+        if (request_ids.count(request->get_request_id())) {
+            request->pause_generation(true);
+        }
+    }
+}
+
 GeneratedRequests
 ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::get_generated_requests() {
     GeneratedRequests result;
@@ -284,7 +292,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pull_a
     ContinuousBatchingImpl::_pull_awaiting_requests();
 }
 
-void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep() {
+size_t ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep(const std::map<uint64_t, size_t>& num_assistant_tokens) {
     size_t generated_tokens_cnt = 0;
     // cycle to generate several tokens per one iteration for speculative decoding case
     bool to_generate = true;
@@ -296,12 +304,15 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
         to_generate = false;
         for (auto& request : m_requests) {
             const auto& sampling_params = request->get_sampling_parameters();
+            auto num_assistant_tokens_it = num_assistant_tokens.find(request->get_request_id());
+            size_t request_num_assistant_tokens = num_assistant_tokens_it == num_assistant_tokens.end() ?
+                sampling_params.num_assistant_tokens : num_assistant_tokens_it->second;
             if (!sampling_params.is_speculative_decoding()) {
                 // generate only one token in case of non speculative decoding
                 request->pause_generation(true);
             } else if (request->get_num_processed_tokens() == 0 && sampling_params.num_return_sequences > 1) {
                 request->pause_generation(true);
-            } else if (sampling_params.num_assistant_tokens <= generated_tokens_cnt && sampling_params.assistant_confidence_threshold == 0.f) {
+            } else if (request_num_assistant_tokens <= generated_tokens_cnt && sampling_params.assistant_confidence_threshold == 0.f) {
                 request->pause_generation(true);
             } else if (request->get_context_len() >= request->get_prompt_len() &&
                 (request->get_context_len() - request->get_prompt_len()) >= sampling_params.max_new_tokens - 1) {
@@ -312,5 +323,6 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
             to_generate |= request->can_generate_tokens();
         }
     }
+    return generated_tokens_cnt;
 }
 }
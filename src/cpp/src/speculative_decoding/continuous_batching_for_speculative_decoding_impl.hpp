@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "continuous_batching_impl.hpp"
@@ -23,9 +25,16 @@ public:
                                                  const ov::AnyMap& plugin_config,
                                                  bool is_validation_mode_enabled);
 
-    void multistep();
+    /**
+     * @brief Generates candidates by several steps of the model.
+     * @param num_assistant_tokens per request number of candidates overriding GenerationConfig::num_assistant_tokens
+     * @return the number of performed steps
+     */
+    size_t multistep(const std::map<uint64_t, size_t>& num_assistant_tokens = {});
 
     void finish_request(int64_t request_id = -1);
+    // paused requests are not scheduled until they are updated by update_request()
+    void pause_requests(const std::set<uint64_t>& request_ids);
     void pull_awaiting_requests();
     GeneratedRequests get_generated_requests();
     UpdateRequestResult update_request(uint64_t request_id, const GeneratedSequences& candidates, bool is_update_logit_processor);
@@ -0,0 +1,99 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+
+#include "speculative_decoding/draft_length_controller.hpp"
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+DraftLengthController::DraftLengthController(size_t max_draft_len, float decay) :
+    m_max_draft_len(max_draft_len),
+    m_decay(decay) {
+    OPENVINO_ASSERT(max_draft_len > 0, "Max draft length must be positive");
+    OPENVINO_ASSERT(decay >= 0.f && decay < 1.f, "Decay must be in [0; 1)");
+}
+
+void DraftLengthController::add_request(uint64_t request_id, size_t initial_draft_len) {
+    RequestState state;
+    state.draft_len = std::clamp<size_t>(initial_draft_len, 1, m_max_draft_len);
+    m_requests[request_id] = state;
+}
+
+void DraftLengthController::remove_request(uint64_t request_id) {
+    m_requests.erase(request_id);
+}
+
+bool DraftLengthController::has_request(uint64_t request_id) const {
+    return m_requests.count(request_id) > 0;
+}
+
+size_t DraftLengthController::get_draft_len(uint64_t request_id) const {
+    OPENVINO_ASSERT(has_request(request_id), "Request ", request_id, " is not controlled");
+    return m_requests.at(request_id).draft_len;
+}
+
+std::map<uint64_t, size_t> DraftLengthController::get_draft_lens() const {
+    std::map<uint64_t, size_t> draft_lens;
+    for (const auto& [request_id, state] : m_requests) {
+        draft_lens.emplace(request_id, state.draft_len);
+    }
+    return draft_lens;
+}
+
+void DraftLengthController::update_acceptance(uint64_t request_id, size_t num_proposed, size_t num_accepted) {
+    auto it = m_requests.find(request_id);
+    if (it == m_requests.end() || num_proposed == 0) {
+        return;
+    }
+    OPENVINO_ASSERT(num_accepted <= num_proposed);
+    RequestState& state = it->second;
+    // tokens after the first rejected one are not validated, so they carry no information about acceptance
+    size_t num_validated = num_accepted + (num_accepted < num_proposed ? 1 : 0);
+    state.num_accepted = m_decay * state.num_accepted + num_accepted;
+    state.num_validated = m_decay * state.num_validated + num_validated;
+    state.draft_len = choose_draft_len(get_acceptance_probability(request_id));
+}
+
+void DraftLengthController::update_durations(float draft_step_duration, float main_step_duration) {
+    if (m_main_step_duration == 0.f) {
+        m_draft_step_duration = draft_step_duration;
+        m_main_step_duration = main_step_duration;
+    } else {
+        m_draft_step_duration = m_decay * m_draft_step_duration + (1 - m_decay) * draft_step_duration;
+        m_main_step_duration = m_decay * m_main_step_duration + (1 - m_decay) * main_step_duration;
+    }
+}
+
+float DraftLengthController::get_acceptance_probability(uint64_t request_id) const {
+    OPENVINO_ASSERT(has_request(request_id), "Request ", request_id, " is not controlled");
+    const RequestState& state = m_requests.at(request_id);
+    return state.num_validated > 0.f ? state.num_accepted / state.num_validated : 0.f;
+}
+
+size_t DraftLengthController::choose_draft_len(float acceptance_probability) const {
+    // relative cost of a draft token; without measurements draft tokens are considered free
+    float draft_cost = m_main_step_duration > 0.f ? m_draft_step_duration / m_main_step_duration : 0.f;
+    // keeps the expected number of tokens finite when all tokens were accepted so far
+    float alpha = std::min(acceptance_probability, 0.99f);
+
+    size_t best_draft_len = 1;
+    float best_throughput = 0.f;
+    float alpha_pow = alpha;
+    float expected_tokens = 1.f;
+    for (size_t draft_len = 1; draft_len <= m_max_draft_len; ++draft_len) {
+        // 1 + alpha + ... + alpha^draft_len
+        expected_tokens += alpha_pow;
+        alpha_pow *= alpha;
+        float throughput = expected_tokens / (1.f + draft_len * draft_cost);
+        if (throughput > best_throughput) {
+            best_throughput = throughput;
+            best_draft_len = draft_len;
+        }
+    }
+    return best_draft_len;
+}
+
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace ov::genai {
+
+/**
+ * @brief Chooses the number of draft tokens per request which maximizes the expected number of accepted tokens
+ * per unit of time. Each draft token is assumed to be accepted with probability `alpha` estimated from the recent
+ * validation history of the request, so `k` draft tokens yield (1 - alpha^(k + 1)) / (1 - alpha) tokens
+ * (including the token generated by the main model) and cost `k * draft_step_duration + main_step_duration`.
+ */
+class DraftLengthController {
+public:
+    /**
+     * @param max_draft_len the upper bound of chosen draft lengths
+     * @param decay weight of the history when acceptance statistics and step durations are updated
+     */
+    explicit DraftLengthController(size_t max_draft_len = 16, float decay = 0.8f);
+
+    void add_request(uint64_t request_id, size_t initial_draft_len);
+    void remove_request(uint64_t request_id);
+    bool has_request(uint64_t request_id) const;
+
+    /** @brief Returns the number of draft tokens to be generated for the request at the next step. */
+    size_t get_draft_len(uint64_t request_id) const;
+    std::map<uint64_t, size_t> get_draft_lens() const;
+
+    /**
+     * @brief Updates the acceptance statistics of the request with a validation result: the first `num_accepted`
+     * out of `num_proposed` draft tokens were accepted.
+     */
+    void update_acceptance(uint64_t request_id, size_t num_proposed, size_t num_accepted);
+
+    /** @brief Updates measured durations of a single draft model step and a single main model step. */
+    void update_durations(float draft_step_duration, float main_step_duration);
+
+    float get_acceptance_probability(uint64_t request_id) const;
+
+private:
+    struct RequestState {
+        size_t draft_len = 1;
+        // decayed numbers of accepted and validated draft tokens
+        float num_accepted = 0.f;
+        float num_validated = 0.f;
+    };
+
+    size_t choose_draft_len(float acceptance_probability) const;
+
+    size_t m_max_draft_len;
+    float m_decay;
+    float m_draft_step_duration = 0.f;
+    float m_main_step_duration = 0.f;
+    std::map<uint64_t, RequestState> m_requests;
+};
+
+}
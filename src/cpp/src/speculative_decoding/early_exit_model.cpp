@@ -0,0 +1,184 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "speculative_decoding/early_exit_model.hpp"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "openvino/op/add.hpp"
+#include "openvino/op/constant.hpp"
+#include "openvino/op/parameter.hpp"
+
+namespace ov::genai {
+namespace {
+
+// returns the decoder layer index of a per-layer input or output like `key_cache.5`, or -1 if the name doesn't match
+int64_t get_layer_index(const std::string& name, const std::string& prefix) {
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+        return -1;
+    }
+    const std::string suffix = name.substr(prefix.size());
+    if (suffix.find_first_not_of("0123456789") != std::string::npos) {
+        return -1;
+    }
+    return std::stoll(suffix);
+}
+
+int64_t get_layer_index(const ov::Output<ov::Node>& output, const std::string& prefix) {
+    int64_t layer_idx = get_layer_index(output.get_node()->get_friendly_name(), prefix);
+    for (const auto& name : output.get_names()) {
+        layer_idx = std::max(layer_idx, get_layer_index(name, prefix));
+    }
+    return layer_idx;
+}
+
+std::map<size_t, std::shared_ptr<ov::op::v0::Parameter>> get_key_cache_parameters(const std::shared_ptr<ov::Model>& model) {
+    std::map<size_t, std::shared_ptr<ov::op::v0::Parameter>> key_cache_params;
+    for (const auto& param : model->get_parameters()) {
+        int64_t layer_idx = get_layer_index(param->get_friendly_name(), "key_cache.");
+        if (layer_idx >= 0) {
+            key_cache_params[layer_idx] = param;
+        }
+    }
+    return key_cache_params;
+}
+
+// paged attention operation is the only consumer of KV cache inputs
+ov::Node* get_attention_node(const std::shared_ptr<ov::op::v0::Parameter>& key_cache) {
+    const auto consumers = key_cache->output(0).get_target_inputs();
+    OPENVINO_ASSERT(consumers.size() == 1, "Expected a single consumer of ", key_cache->get_friendly_name(), ", got ", consumers.size());
+    return consumers.begin()->get_node();
+}
+
+std::unordered_set<ov::Node*> get_ancestors(ov::Node* node) {
+    std::unordered_set<ov::Node*> visited;
+    std::vector<ov::Node*> stack = {node};
+    while (!stack.empty()) {
+        ov::Node* current = stack.back();
+        stack.pop_back();
+        for (const auto& input_value : current->input_values()) {
+            if (visited.insert(input_value.get_node()).second) {
+                stack.push_back(input_value.get_node());
+            }
+        }
+    }
+    return visited;
+}
+
+std::unordered_set<ov::Node*> get_descendants(ov::Node* node) {
+    std::unordered_set<ov::Node*> visited;
+    std::vector<ov::Node*> stack = {node};
+    while (!stack.empty()) {
+        ov::Node* current = stack.back();
+        stack.pop_back();
+        for (const auto& output : current->outputs()) {
+            for (const auto& target_input : output.get_target_inputs()) {
+                if (visited.insert(target_input.get_node()).second) {
+                    stack.push_back(target_input.get_node());
+                }
+            }
+        }
+    }
+    return visited;
+}
+
+// detects constants including small decompression subgraphs like Constant -> Convert -> Multiply
+bool is_constant_path(const ov::Node* node, size_t max_depth = 4) {
+    if (ov::is_type<ov::op::v0::Constant>(node)) {
+        return true;
+    }
+    if (max_depth == 0 || node->get_input_size() == 0) {
+        return false;
+    }
+    for (const auto& input_value : node->input_values()) {
+        if (!is_constant_path(input_value.get_node(), max_depth - 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// residual connections are floating point additions of two activations, while biases and norm epsilons are constants
+bool is_residual_add(const ov::Node* node) {
+    return ov::is_type<ov::op::v1::Add>(node) &&
+           node->get_output_element_type(0).is_real() &&
+           !is_constant_path(node->get_input_node_ptr(0)) &&
+           !is_constant_path(node->get_input_node_ptr(1));
+}
+
+// input hidden states of a decoder layer are added to the output of its attention by a residual connection
+ov::Output<ov::Node> get_layer_input(const std::shared_ptr<ov::Model>& model, ov::Node* attention) {
+    const auto ancestors = get_ancestors(attention), descendants = get_descendants(attention);
+    for (const auto& op : model->get_ordered_ops()) {
+        if (!descendants.count(op.get()) || !is_residual_add(op.get())) {
+            continue;
+        }
+        for (const auto& input_value : op->input_values()) {
+            if (ancestors.count(input_value.get_node()) && !descendants.count(input_value.get_node())) {
+                return input_value;
+            }
+        }
+    }
+    OPENVINO_THROW("Failed to find the residual connection of the decoder layer with ", attention->get_friendly_name());
+}
+
+// output hidden states of the last decoder layer is the last residual connection before the final norm
+std::shared_ptr<ov::Node> get_last_layer_output(const std::shared_ptr<ov::Model>& model, ov::Node* last_attention) {
+    const auto descendants = get_descendants(last_attention);
+    const auto logits_ancestors = get_ancestors(model->get_results().front().get());
+    std::shared_ptr<ov::Node> last_residual_add;
+    for (const auto& op : model->get_ordered_ops()) {
+        if (descendants.count(op.get()) && logits_ancestors.count(op.get()) && is_residual_add(op.get())) {
+            last_residual_add = op;
+        }
+    }
+    OPENVINO_ASSERT(last_residual_add, "Failed to find the residual connection of the last decoder layer");
+    return last_residual_add;
+}
+
+}  // namespace
+
+size_t get_num_decoder_layers(const std::shared_ptr<ov::Model>& model) {
+    return get_key_cache_parameters(model).size();
+}
+
+std::shared_ptr<ov::Model> get_early_exit_model(const std::shared_ptr<ov::Model>& model, size_t num_layers) {
+    std::shared_ptr<ov::Model> early_exit_model = model->clone();
+
+    const auto key_cache_params = get_key_cache_parameters(early_exit_model);
+    const size_t num_model_layers = key_cache_params.size();
+    OPENVINO_ASSERT(num_model_layers > 0, "Model is expected to be transformed for paged attention");
+    OPENVINO_ASSERT(num_layers > 0 && num_layers < num_model_layers,
+                    "Number of early exit layers must be in range [1, ", num_model_layers - 1, "], got ", num_layers);
+
+    ov::Output<ov::Node> exit_hidden_states = get_layer_input(early_exit_model, get_attention_node(key_cache_params.at(num_layers)));
+    std::shared_ptr<ov::Node> last_layer_output = get_last_layer_output(early_exit_model, get_attention_node(key_cache_params.rbegin()->second));
+    // final norm and LM head are applied to hidden states of the exit layer, the rest layers become unreachable
+    last_layer_output->output(0).replace(exit_hidden_states);
+
+    const ov::ResultVector results = early_exit_model->get_results();
+    for (const auto& result : results) {
+        if (std::max(get_layer_index(result->output(0), "scores."), get_layer_index(result->input_value(0), "scores.")) >=
+            static_cast<int64_t>(num_layers)) {
+            early_exit_model->remove_result(result);
+        }
+    }
+    const ov::ParameterVector params = early_exit_model->get_parameters();
+    for (const auto& param : params) {
+        for (const std::string prefix : {"key_cache.", "value_cache.", "block_indices."}) {
+            if (get_layer_index(param->output(0), prefix) >= static_cast<int64_t>(num_layers)) {
+                early_exit_model->remove_parameter(param);
+                break;
+            }
+        }
+    }
+
+    early_exit_model->validate_nodes_and_infer_types();
+    return early_exit_model;
+}
+
+}  // namespace ov::genai
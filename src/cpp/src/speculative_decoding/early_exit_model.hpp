@@ -0,0 +1,24 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+
+#include "openvino/core/model.hpp"
+
+namespace ov::genai {
+
+/** @brief Returns the number of decoder layers of a model transformed for paged attention. */
+size_t get_num_decoder_layers(const std::shared_ptr<ov::Model>& model);
+
+/**
+ * @brief Builds a draft model for self-speculative decoding from a model transformed for paged attention:
+ * hidden states after the first `num_layers` decoder layers are passed directly to the final norm and LM head.
+ * The returned model is a clone of the original one, so weight constants are shared and not copied.
+ * @param model model with paged attention operations
+ * @param num_layers number of decoder layers to keep, it has to be less than the number of layers in the model
+ */
+std::shared_ptr<ov::Model> get_early_exit_model(const std::shared_ptr<ov::Model>& model, size_t num_layers);
+
+}  // namespace ov::genai
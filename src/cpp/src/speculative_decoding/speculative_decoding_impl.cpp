@@ -1,8 +1,14 @@
 // Copyright (C) 2023-2024 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <array>
+#include <fstream>
+#include <future>
+#include <iterator>
+
 #include "text_callback_streamer.hpp"
 #include "speculative_decoding_impl.hpp"
+#include "speculative_decoding/early_exit_model.hpp"
 #include "utils.hpp"
 #include "utils/paged_attention_transformations.hpp"
 
@@ -23,6 +29,28 @@ bool are_tokenizers_equal(Tokenizer& lhs, Tokenizer& rhs) {
            lhs.get_bos_token_id() == rhs.get_bos_token_id() && lhs.get_pad_token_id() == rhs.get_pad_token_id();
 }
 
+// checks whether the tokenizer files of two models match byte by byte, so the main tokenizer can be used for the draft model
+// without loading another tokenizer and comparing them by inference
+bool are_tokenizer_files_equal(const std::filesystem::path& lhs, const std::filesystem::path& rhs) {
+    for (const char* file_name : {"openvino_tokenizer.xml", "openvino_tokenizer.bin",
+                                  "openvino_detokenizer.xml", "openvino_detokenizer.bin",
+                                  "tokenizer_config.json", "special_tokens_map.json"}) {
+        const bool lhs_exists = std::filesystem::exists(lhs / file_name), rhs_exists = std::filesystem::exists(rhs / file_name);
+        if (lhs_exists != rhs_exists)
+            return false;
+        if (!lhs_exists)
+            continue;
+        if (std::filesystem::file_size(lhs / file_name) != std::filesystem::file_size(rhs / file_name))
+            return false;
+        std::ifstream lhs_file(lhs / file_name, std::ios::binary), rhs_file(rhs / file_name, std::ios::binary);
+        if (!lhs_file.is_open() || !rhs_file.is_open() ||
+            !std::equal(std::istreambuf_iterator<char>(lhs_file), std::istreambuf_iterator<char>(),
+                        std::istreambuf_iterator<char>(rhs_file)))
+            return false;
+    }
+    return true;
+}
+
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(
     const std::filesystem::path& main_models_path,
     const SchedulerConfig& main_scheduler_config,
@@ -31,17 +59,36 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(
     const ov::genai::ModelDesc draft_model_desc,
     const ov::AnyMap& tokenizer_properties) {
     ov::Core core;
-    auto [core_properties, compile_properties] = ov::genai::utils::split_core_compile_config(main_properties);
+    ov::AnyMap properties = main_properties;
+    if (properties.count(ov::genai::pipelined_speculative_decoding.name())) {
+        m_is_pipelined = properties.at(ov::genai::pipelined_speculative_decoding.name()).as<bool>();
+        properties.erase(ov::genai::pipelined_speculative_decoding.name());
+    }
+    size_t early_exit_draft_layers = 0;
+    if (properties.count(ov::genai::early_exit_draft_layers.name())) {
+        early_exit_draft_layers = properties.at(ov::genai::early_exit_draft_layers.name()).as<size_t>();
+        properties.erase(ov::genai::early_exit_draft_layers.name());
+    }
+    // draft model is built from the first decoder layers of the main model
+    bool is_self_speculative = early_exit_draft_layers > 0;
+    OPENVINO_ASSERT(!is_self_speculative || draft_model_desc.models_path.empty(),
+                    "Draft model and early exit draft layers are mutually excluded");
+    auto [core_properties, compile_properties] = ov::genai::utils::split_core_compile_config(properties);
     core.set_property(core_properties);
 
     std::filesystem::path openvino_model_name = "openvino_model.xml",
-                          draft_models_path = draft_model_desc.models_path;
-
-    std::shared_ptr<ov::Model> main_model = core.read_model((main_models_path / openvino_model_name).string()),
-                               draft_model = core.read_model((draft_models_path / openvino_model_name).string());
+                          draft_models_path = is_self_speculative ? main_models_path : draft_model_desc.models_path;
 
+    std::shared_ptr<ov::Model> main_model = core.read_model((main_models_path / openvino_model_name).string()), draft_model;
     utils::apply_paged_attention_transformations(main_model, main_scheduler_config.use_cache_eviction);
-    utils::apply_paged_attention_transformations(draft_model, main_scheduler_config.use_cache_eviction);
+
+    if (is_self_speculative) {
+        // early exit model is a clone of the main one, so weights are not duplicated
+        draft_model = get_early_exit_model(main_model, early_exit_draft_layers);
+    } else {
+        draft_model = core.read_model((draft_models_path / openvino_model_name).string());
+        utils::apply_paged_attention_transformations(draft_model, main_scheduler_config.use_cache_eviction);
+    }
 
     std::string draft_device = draft_model_desc.device.empty() ? main_device : draft_model_desc.device;
 
@@ -53,6 +100,11 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(
         // split KV cache to 2 caches for main and draft models
         size_t main_model_cache_size = utils::get_kv_cache_size(main_model),
             draft_model_cache_size = utils::get_kv_cache_size(draft_model);
+        if (is_self_speculative) {
+            // layers have the same KV cache shapes, while the draft model has fewer of them
+            main_model_cache_size *= get_num_decoder_layers(main_model);
+            draft_model_cache_size *= early_exit_draft_layers;
+        }
         auto k = static_cast<float>(draft_model_cache_size) / (main_model_cache_size + draft_model_cache_size);
 
         size_t main_cache_size = main_scheduler_config.cache_size * (1 - k),
@@ -76,11 +128,13 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(
 
     // main and draft model can have different tokenizers
     // to do: support retokenization: 154103
+    const bool is_same_tokenizer = is_self_speculative || are_tokenizer_files_equal(main_models_path, draft_models_path);
     Tokenizer main_model_tokenizer(main_models_path, tokenizer_properties),
-              draft_model_tokenizer(draft_models_path, tokenizer_properties);
+              draft_model_tokenizer = is_same_tokenizer ? main_model_tokenizer : Tokenizer(draft_models_path, tokenizer_properties);
 
     // todo: remove this condition after support of CVS-154103
-    OPENVINO_ASSERT(are_tokenizers_equal(main_model_tokenizer, draft_model_tokenizer), "Tokenizers for draft and main models are different!");
+    OPENVINO_ASSERT(is_same_tokenizer || are_tokenizers_equal(main_model_tokenizer, draft_model_tokenizer),
+                    "Tokenizers for draft and main models are different!");
     
     m_tokenizer = main_model_tokenizer;
 
@@ -98,6 +152,9 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::add_request(uint64_t reques
                                                                  const ov::Tensor& input_ids,
                                                                  ov::genai::GenerationConfig sampling_params) {
     std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
+    if (sampling_params.dynamic_num_assistant_tokens) {
+        m_draft_len_controller.add_request(request_id, sampling_params.num_assistant_tokens);
+    }
     m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, input_ids, sampling_params)});
     return m_main_pipeline->add_request(request_id, input_ids, sampling_params);
 };
@@ -106,15 +163,19 @@ GenerationHandle
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::add_request(uint64_t request_id,
                                                                  const std::string& prompt,
                                                                  ov::genai::GenerationConfig sampling_params) {
-    std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
-    m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, prompt, sampling_params)});
-    return m_main_pipeline->add_request(request_id, prompt, sampling_params);
+    // the prompt is tokenized once, so the request is added to the draft and main pipelines within the same step
+    ov::Tensor input_ids = m_tokenizer.encode(prompt).input_ids;
+    return add_request(request_id, input_ids, sampling_params);
 }
 
 bool ContinuousBatchingPipeline::SpeculativeDecodingImpl::has_non_finished_requests() {
     return m_main_pipeline->has_non_finished_requests();
 }
 
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) {
+    OPENVINO_ASSERT(streamer == nullptr, "Batched streaming is not supported by speculative decoding pipeline");
+}
+
 void print_generated_request(const ov::genai::GeneratedRequests& requests) {
     for (const auto& request : requests) {
         for (const auto& sequence : request.second) {
@@ -128,16 +189,30 @@ void print_generated_request(const ov::genai::GeneratedRequests& requests) {
     }
 }
 
+// Requests with dynamic draft length report the length chosen by the controller, as fewer candidates are inserted
+// when the draft model finishes earlier. Other requests report the number of inserted candidates.
+size_t get_reported_draft_len(const std::map<uint64_t, size_t>& draft_lens, uint64_t request_id, size_t inserted_tokens_cnt) {
+    auto draft_len_it = draft_lens.find(request_id);
+    return draft_len_it != draft_lens.end() ? draft_len_it->second : inserted_tokens_cnt;
+}
+
 void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     // this blocks adding new requests during step as it may break coherence between main and draft models
     std::lock_guard<std::mutex> lock{m_draft_generations_mutex};
     m_draft_pipeline->pull_awaiting_requests();
     m_main_pipeline->pull_awaiting_requests();
 
+    if (m_is_pipelined) {
+        step_pipelined();
+        return;
+    }
+
     // generate candidates by draft model
+    // draft lengths are saved before they are updated by validation results to be reported in metrics
+    const std::map<uint64_t, size_t> draft_lens = m_draft_len_controller.get_draft_lens();
     ManualTimer draft_timer("speculative_decoding: draft_model: multistep()");
     draft_timer.start();
-    m_draft_pipeline->multistep();
+    size_t num_draft_steps = m_draft_pipeline->multistep(draft_lens);
     draft_timer.end();
     m_sd_metrics.draft_duration += draft_timer.get_duration();
     m_pipeline_metrics = m_main_pipeline->get_metrics();
@@ -157,6 +232,7 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     main_timer.end();
     m_sd_metrics.main_duration += main_timer.get_duration();
     m_pipeline_metrics = m_main_pipeline->get_metrics();
+    m_draft_len_controller.update_durations(draft_timer.get_duration() / num_draft_steps, main_timer.get_duration());
 
     auto main_generated_requests = m_main_pipeline->get_generated_requests();
     for (const auto& checked_sequence : main_generated_requests) {
@@ -171,6 +247,7 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
             m_draft_pipeline->finish_request(request_id);
             // remove draft_generation_handle from queue
             m_draft_generations.erase(request_id);
+            m_draft_len_controller.remove_request(request_id);
         }
         auto updated_seq_info = update_sequence_info[request_id];
         // several prompt phase
@@ -180,9 +257,105 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
         float acceptance_rate = 1 - static_cast<float>(updated_seq_info.removed_tokens_cnt) / updated_seq_info.inserted_tokens_cnt;
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
         m_sd_metrics.update_draft_accepted_tokens(request_id, (updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt));
+        m_sd_metrics.update_draft_len(request_id, get_reported_draft_len(draft_lens, request_id, updated_seq_info.inserted_tokens_cnt));
+        m_draft_len_controller.update_acceptance(request_id, updated_seq_info.inserted_tokens_cnt,
+                                                 updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt);
     }
 }
 
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step_pipelined() {
+    // prompt has to be processed by draft model first, so new requests can join the drafted slice only;
+    // to keep slices balanced, a request waits for one step if the drafted slice is the larger one
+    std::array<size_t, 2> slice_sizes = {0, 0};
+    for (const auto& [request_id, slice] : m_request_slices) {
+        ++slice_sizes[slice];
+    }
+    std::set<uint64_t> drafted_requests, validated_requests, delayed_requests;
+    for (const auto& [request_id, draft_generation] : m_draft_generations) {
+        if (m_request_slices.count(request_id)) {
+            (m_request_slices.at(request_id) == m_drafted_slice ? drafted_requests : validated_requests).insert(request_id);
+        } else if (slice_sizes[m_drafted_slice] <= slice_sizes[1 - m_drafted_slice]) {
+            m_request_slices.emplace(request_id, m_drafted_slice);
+            ++slice_sizes[m_drafted_slice];
+            drafted_requests.insert(request_id);
+        } else {
+            delayed_requests.insert(request_id);
+        }
+    }
+
+    // requests of the drafted slice wait for candidates in main pipeline, while other requests wait for
+    // validation results in draft pipeline
+    drafted_requests.insert(delayed_requests.begin(), delayed_requests.end());
+    validated_requests.insert(delayed_requests.begin(), delayed_requests.end());
+    m_main_pipeline->pause_requests(drafted_requests);
+    m_draft_pipeline->pause_requests(validated_requests);
+
+    const std::map<uint64_t, size_t> draft_lens = m_draft_len_controller.get_draft_lens();
+    auto draft_future = std::async(std::launch::async, [this, &draft_lens] {
+        ManualTimer draft_timer("speculative_decoding: draft_model: multistep()");
+        draft_timer.start();
+        size_t num_draft_steps = m_draft_pipeline->multistep(draft_lens);
+        draft_timer.end();
+        return std::make_pair(num_draft_steps, draft_timer.get_duration());
+    });
+
+    ManualTimer main_timer("speculative_decoding: main_model: step()");
+    main_timer.start();
+    m_main_pipeline->step();
+    main_timer.end();
+    auto [num_draft_steps, draft_duration] = draft_future.get();
+
+    m_sd_metrics.draft_duration += draft_duration;
+    m_sd_metrics.main_duration += main_timer.get_duration();
+    m_pipeline_metrics = m_main_pipeline->get_metrics();
+    m_draft_len_controller.update_durations(draft_duration / num_draft_steps, main_timer.get_duration());
+
+    // put candidates of the drafted slice to main model KV cache, they are validated by the next step
+    auto main_generated_requests = m_main_pipeline->get_generated_requests();
+    auto draft_generated_requests = m_draft_pipeline->get_generated_requests();
+    for (const auto& [request_id, candidates] : draft_generated_requests) {
+        if (m_request_slices.count(request_id) && m_request_slices.at(request_id) == m_drafted_slice &&
+            main_generated_requests.count(request_id)) {
+            auto update_result = m_main_pipeline->update_request(request_id, candidates, false);
+            m_inserted_candidates[request_id] = update_result.inserted_tokens_cnt;
+            m_sd_metrics.update_draft_len(request_id, get_reported_draft_len(draft_lens, request_id, update_result.inserted_tokens_cnt));
+        }
+    }
+
+    // update draft model by validation results of the other slice
+    for (const auto& [request_id, checked_sequences] : main_generated_requests) {
+        if (!m_request_slices.count(request_id) || m_request_slices.at(request_id) == m_drafted_slice) {
+            continue;
+        }
+        auto update_result = m_draft_pipeline->update_request(request_id, checked_sequences, true);
+        auto inserted_it = m_inserted_candidates.find(request_id);
+        // prompt was not processed by main model yet
+        if (inserted_it == m_inserted_candidates.end() || inserted_it->second == 0) {
+            continue;
+        }
+        size_t inserted_tokens_cnt = inserted_it->second;
+        m_inserted_candidates.erase(inserted_it);
+        float acceptance_rate = 1 - static_cast<float>(update_result.removed_tokens_cnt) / inserted_tokens_cnt;
+        m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
+        m_sd_metrics.update_draft_accepted_tokens(request_id, inserted_tokens_cnt - update_result.removed_tokens_cnt);
+        m_draft_len_controller.update_acceptance(request_id, inserted_tokens_cnt, inserted_tokens_cnt - update_result.removed_tokens_cnt);
+    }
+
+    // finish draft request if the generation was completed
+    for (const auto& [request_id, draft_request] : draft_generated_requests) {
+        if (!main_generated_requests.count(request_id)) {
+            m_draft_pipeline->finish_request(request_id);
+            // remove draft_generation_handle from queue
+            m_draft_generations.erase(request_id);
+            m_draft_len_controller.remove_request(request_id);
+            m_request_slices.erase(request_id);
+            m_inserted_candidates.erase(request_id);
+        }
+    }
+
+    m_drafted_slice = 1 - m_drafted_slice;
+}
+
 std::vector<EncodedGenerationResult>
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<ov::Tensor>& input_ids,
                                                               const std::vector<GenerationConfig>& sampling_params,
@@ -215,6 +388,9 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<
         // set the parameters do not stop draft generation without stopping of the same request for main pipeline
         draft_sampling_params.ignore_eos = true;
         std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
+        if (sampling_params[request_id].dynamic_num_assistant_tokens) {
+            m_draft_len_controller.add_request(request_id, sampling_params[request_id].num_assistant_tokens);
+        }
         m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, input_ids[request_id], draft_sampling_params)});
     }
 
@@ -7,6 +7,7 @@
 #include "continuous_batching_impl.hpp"
 #include "continuous_batching_for_speculative_decoding_impl.hpp"
 #include "speculative_decoding/speculative_decoding_metrics.hpp"
+#include "speculative_decoding/draft_length_controller.hpp"
 
 namespace ov::genai {
 
@@ -33,6 +34,19 @@ protected:
     // Mutex protecting access to m_draft_generations, so add_request and step methods can be called from different threads
     std::mutex m_draft_generations_mutex;
     std::map<uint64_t, GenerationHandle> m_draft_generations;
+    // tunes number of candidates for requests with GenerationConfig::dynamic_num_assistant_tokens
+    DraftLengthController m_draft_len_controller;
+
+    // draft model generates candidates for one slice of requests while main model validates the other one
+    bool m_is_pipelined = false;
+    // index of the slice whose candidates are generated by the current step
+    size_t m_drafted_slice = 0;
+    // request ID => slice of the request
+    std::map<uint64_t, size_t> m_request_slices;
+    // request ID => number of candidates inserted to main model and not validated yet
+    std::map<uint64_t, size_t> m_inserted_candidates;
+
+    void step_pipelined();
     
 public:
     SpeculativeDecodingImpl(const std::filesystem::path& main_models_path,
@@ -51,6 +65,8 @@ public:
 
     bool has_non_finished_requests() override;
 
+    void set_batched_streamer(std::shared_ptr<BatchedStreamerBase> streamer) override;
+
     void step() override;
 
     std::vector<EncodedGenerationResult>
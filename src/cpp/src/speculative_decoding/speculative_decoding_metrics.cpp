@@ -95,4 +95,24 @@ void SpeculativeDecodingMetrics::set_generated_len(int64_t request_id, size_t ge
     m_generated_len.insert({ request_id, generated_len });
 }
 
+void SpeculativeDecodingMetrics::update_draft_len(int64_t request_id, size_t draft_len) {
+    m_draft_lens[request_id].push_back(draft_len);
+}
+
+std::vector<size_t> SpeculativeDecodingMetrics::get_draft_lens(int64_t request_id) {
+    OPENVINO_ASSERT(m_draft_lens.count(request_id));
+    return m_draft_lens[request_id];
+}
+
+float SpeculativeDecodingMetrics::get_avg_draft_len(int64_t request_id) {
+    size_t total_draft_len = 0, total_iteration_cnt = 0;
+    for (const auto& [id, draft_lens] : m_draft_lens) {
+        if (request_id == -1 || request_id == id) {
+            total_draft_len += std::accumulate(draft_lens.begin(), draft_lens.end(), size_t{0});
+            total_iteration_cnt += draft_lens.size();
+        }
+    }
+    return total_iteration_cnt == 0 ? 0.f : static_cast<float>(total_draft_len) / total_iteration_cnt;
+}
+
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ class SpeculativeDecodingMetrics {
 
     std::map<int64_t, size_t> m_draft_accepted_tokens;
     std::map<int64_t, size_t> m_generated_len;
+    // { request_id, draft length of every iteration: the chosen one in case of dynamic draft length }
+    std::map<int64_t, std::vector<size_t>> m_draft_lens;
 
 public:
     float draft_duration = 0, main_duration = 0, total_duration = 0;
@@ -29,6 +31,10 @@ public:
 
     void set_generated_len(int64_t request_id, size_t generated_len);
 
+    void update_draft_len(int64_t request_id, size_t draft_len);
+    std::vector<size_t> get_draft_lens(int64_t request_id);
+    float get_avg_draft_len(int64_t request_id);
+
     size_t get_iteration_number(int64_t request_id);
 
     float get_draft_duration_percentage();
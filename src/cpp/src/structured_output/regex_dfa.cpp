@@ -0,0 +1,607 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "structured_output/regex_dfa.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <map>
+
+#include "openvino/core/except.hpp"
+
+namespace {
+
+constexpr uint32_t MAX_CODE_POINT = 0x10FFFF;
+constexpr size_t INFINITE_COUNT = std::numeric_limits<size_t>::max();
+constexpr size_t MAX_REPEAT_COUNT = 1000;
+constexpr size_t MAX_NFA_STATES = 1000000;
+
+using CodePointRanges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+struct RegexNode {
+    enum class Type { EMPTY, CHARS, CONCAT, ALTERNATION, REPEAT };
+
+    Type type = Type::EMPTY;
+    CodePointRanges ranges;         // CHARS
+    std::vector<size_t> children;   // CONCAT, ALTERNATION, REPEAT
+    size_t min_count = 0, max_count = 0;  // REPEAT
+};
+
+CodePointRanges normalize(CodePointRanges ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    CodePointRanges merged;
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+CodePointRanges complement(const CodePointRanges& ranges) {
+    CodePointRanges result;
+    uint32_t next = 0;
+    for (const auto& range : normalize(ranges)) {
+        if (range.first > next)
+            result.emplace_back(next, range.first - 1);
+        next = range.second + 1;
+    }
+    if (next <= MAX_CODE_POINT)
+        result.emplace_back(next, MAX_CODE_POINT);
+    return result;
+}
+
+class RegexParser {
+public:
+    RegexParser(const std::string& pattern, std::vector<RegexNode>& nodes) : m_pattern(pattern), m_nodes(nodes) {}
+
+    size_t parse() {
+        if (peek('^'))
+            ++m_pos;
+        size_t root = parse_alternation();
+        OPENVINO_ASSERT(m_pos == m_pattern.size(), "Unexpected '", m_pattern[m_pos], "' at position ", m_pos, " of regex '", m_pattern, "'");
+        return root;
+    }
+
+private:
+    const std::string& m_pattern;
+    std::vector<RegexNode>& m_nodes;
+    size_t m_pos = 0;
+
+    bool peek(char c) const {
+        return m_pos < m_pattern.size() && m_pattern[m_pos] == c;
+    }
+
+    size_t add_node(RegexNode node) {
+        m_nodes.push_back(std::move(node));
+        return m_nodes.size() - 1;
+    }
+
+    size_t add_chars(CodePointRanges ranges) {
+        RegexNode node;
+        node.type = RegexNode::Type::CHARS;
+        node.ranges = normalize(std::move(ranges));
+        return add_node(std::move(node));
+    }
+
+    size_t parse_alternation() {
+        std::vector<size_t> alternatives = {parse_concatenation()};
+        while (peek('|')) {
+            ++m_pos;
+            alternatives.push_back(parse_concatenation());
+        }
+        if (alternatives.size() == 1)
+            return alternatives.front();
+        RegexNode node;
+        node.type = RegexNode::Type::ALTERNATION;
+        node.children = std::move(alternatives);
+        return add_node(std::move(node));
+    }
+
+    size_t parse_concatenation() {
+        RegexNode node;
+        node.type = RegexNode::Type::CONCAT;
+        while (m_pos < m_pattern.size() && !peek('|') && !peek(')')) {
+            if (peek('$') && m_pos + 1 == m_pattern.size()) {
+                ++m_pos;
+                break;
+            }
+            node.children.push_back(parse_repeat());
+        }
+        if (node.children.empty())
+            return add_node(RegexNode{});
+        if (node.children.size() == 1)
+            return node.children.front();
+        return add_node(std::move(node));
+    }
+
+    bool parse_count(size_t& count) {
+        size_t begin = m_pos;
+        count = 0;
+        while (m_pos < m_pattern.size() && std::isdigit(static_cast<unsigned char>(m_pattern[m_pos]))) {
+            count = count * 10 + (m_pattern[m_pos++] - '0');
+            OPENVINO_ASSERT(count <= MAX_REPEAT_COUNT, "Repetition count exceeds ", MAX_REPEAT_COUNT, " in regex '", m_pattern, "'");
+        }
+        return m_pos > begin;
+    }
+
+    // parses "{n}", "{n,}" or "{n,m}", restores position and returns false if it is a literal '{'
+    bool parse_braces(size_t& min_count, size_t& max_count) {
+        size_t begin = m_pos++;
+        if (parse_count(min_count)) {
+            max_count = min_count;
+            if (peek(',')) {
+                ++m_pos;
+                if (!parse_count(max_count))
+                    max_count = INFINITE_COUNT;
+            }
+            if (peek('}')) {
+                ++m_pos;
+                OPENVINO_ASSERT(min_count <= max_count, "Invalid repetition range in regex '", m_pattern, "'");
+                return true;
+            }
+        }
+        m_pos = begin;
+        return false;
+    }
+
+    size_t parse_repeat() {
+        size_t atom = parse_atom();
+        while (m_pos < m_pattern.size()) {
+            size_t min_count = 0, max_count = 0;
+            char c = m_pattern[m_pos];
+            if (c == '*') {
+                min_count = 0, max_count = INFINITE_COUNT;
+                ++m_pos;
+            } else if (c == '+') {
+                min_count = 1, max_count = INFINITE_COUNT;
+                ++m_pos;
+            } else if (c == '?') {
+                min_count = 0, max_count = 1;
+                ++m_pos;
+            } else if (c != '{' || !parse_braces(min_count, max_count)) {
+                break;
+            }
+            // lazy and possessive modifiers don't change the set of matched texts
+            if (peek('?') || peek('+'))
+                ++m_pos;
+
+            RegexNode node;
+            node.type = RegexNode::Type::REPEAT;
+            node.children = {atom};
+            node.min_count = min_count;
+            node.max_count = max_count;
+            atom = add_node(std::move(node));
+        }
+        return atom;
+    }
+
+    uint32_t parse_code_point() {
+        unsigned char lead = m_pattern[m_pos];
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        OPENVINO_ASSERT(length && m_pos + length <= m_pattern.size(), "Invalid UTF-8 in regex '", m_pattern, "'");
+        uint32_t code_point = length == 1 ? lead : lead & (0x7F >> length);
+        for (size_t i = 1; i < length; ++i)
+            code_point = (code_point << 6) | (m_pattern[m_pos + i] & 0x3F);
+        m_pos += length;
+        return code_point;
+    }
+
+    uint32_t parse_hex(size_t num_digits) {
+        OPENVINO_ASSERT(m_pos + num_digits <= m_pattern.size(), "Incomplete hex escape in regex '", m_pattern, "'");
+        uint32_t value = std::stoul(m_pattern.substr(m_pos, num_digits), nullptr, 16);
+        m_pos += num_digits;
+        return value;
+    }
+
+    // parses an escape sequence after '\', returns ranges of the matched code points
+    CodePointRanges parse_escape() {
+        OPENVINO_ASSERT(m_pos < m_pattern.size(), "Trailing '\\' in regex '", m_pattern, "'");
+        const CodePointRanges digits = {{'0', '9'}};
+        const CodePointRanges word = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+        const CodePointRanges space = {{'\t', '\r'}, {' ', ' '}};
+        char c = m_pattern[m_pos++];
+        switch (c) {
+        case 'd': return digits;
+        case 'D': return complement(digits);
+        case 'w': return word;
+        case 'W': return complement(word);
+        case 's': return space;
+        case 'S': return complement(space);
+        case 'n': return {{'\n', '\n'}};
+        case 't': return {{'\t', '\t'}};
+        case 'r': return {{'\r', '\r'}};
+        case 'f': return {{'\f', '\f'}};
+        case 'v': return {{'\v', '\v'}};
+        case '0': return {{0, 0}};
+        case 'x': {
+            uint32_t code_point = parse_hex(2);
+            return {{code_point, code_point}};
+        }
+        case 'u': {
+            uint32_t code_point = parse_hex(4);
+            return {{code_point, code_point}};
+        }
+        default:
+            OPENVINO_ASSERT(!std::isalnum(static_cast<unsigned char>(c)), "Unsupported escape '\\", c, "' in regex '", m_pattern, "'");
+            --m_pos;
+            uint32_t code_point = parse_code_point();
+            return {{code_point, code_point}};
+        }
+    }
+
+    size_t parse_class() {
+        bool negate = peek('^');
+        if (negate)
+            ++m_pos;
+        CodePointRanges ranges;
+        bool first = true;
+        while (true) {
+            OPENVINO_ASSERT(m_pos < m_pattern.size(), "Unterminated character class in regex '", m_pattern, "'");
+            if (peek(']') && !first) {
+                ++m_pos;
+                break;
+            }
+            first = false;
+
+            CodePointRanges item;
+            if (peek('\\')) {
+                ++m_pos;
+                item = parse_escape();
+            } else {
+                uint32_t code_point = parse_code_point();
+                item = {{code_point, code_point}};
+            }
+
+            // range "a-z", '-' before ']' is a literal
+            bool is_range = item.size() == 1 && item[0].first == item[0].second &&
+                            peek('-') && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != ']';
+            if (is_range) {
+                ++m_pos;
+                uint32_t last;
+                if (peek('\\')) {
+                    ++m_pos;
+                    CodePointRanges end = parse_escape();
+                    OPENVINO_ASSERT(end.size() == 1 && end[0].first == end[0].second, "Invalid range in regex '", m_pattern, "'");
+                    last = end[0].first;
+                } else {
+                    last = parse_code_point();
+                }
+                OPENVINO_ASSERT(item[0].first <= last, "Invalid range in regex '", m_pattern, "'");
+                item[0].second = last;
+            }
+            ranges.insert(ranges.end(), item.begin(), item.end());
+        }
+        return add_chars(negate ? complement(ranges) : ranges);
+    }
+
+    size_t parse_atom() {
+        OPENVINO_ASSERT(m_pos < m_pattern.size(), "Unexpected end of regex '", m_pattern, "'");
+        char c = m_pattern[m_pos];
+        if (c == '(') {
+            ++m_pos;
+            if (peek('?')) {
+                OPENVINO_ASSERT(m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] == ':',
+                                "Only non-capturing groups '(?:' are supported in regex '", m_pattern, "'");
+                m_pos += 2;
+            }
+            size_t group = parse_alternation();
+            OPENVINO_ASSERT(peek(')'), "Missing ')' in regex '", m_pattern, "'");
+            ++m_pos;
+            return group;
+        }
+        OPENVINO_ASSERT(c != ')' && c != '*' && c != '+' && c != '?', "Unexpected '", c, "' at position ", m_pos, " of regex '", m_pattern, "'");
+        if (c == '[') {
+            ++m_pos;
+            return parse_class();
+        }
+        if (c == '.') {
+            ++m_pos;
+            return add_chars(complement({{'\n', '\n'}}));
+        }
+        if (c == '\\') {
+            ++m_pos;
+            return add_chars(parse_escape());
+        }
+        uint32_t code_point = parse_code_point();
+        return add_chars({{code_point, code_point}});
+    }
+};
+
+using ByteRanges = std::vector<std::pair<uint8_t, uint8_t>>;
+
+size_t encode_utf8(uint32_t code_point, uint8_t* bytes) {
+    if (code_point < 0x80) {
+        bytes[0] = code_point;
+        return 1;
+    }
+    if (code_point < 0x800) {
+        bytes[0] = 0xC0 | (code_point >> 6);
+        bytes[1] = 0x80 | (code_point & 0x3F);
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        bytes[0] = 0xE0 | (code_point >> 12);
+        bytes[1] = 0x80 | ((code_point >> 6) & 0x3F);
+        bytes[2] = 0x80 | (code_point & 0x3F);
+        return 3;
+    }
+    bytes[0] = 0xF0 | (code_point >> 18);
+    bytes[1] = 0x80 | ((code_point >> 12) & 0x3F);
+    bytes[2] = 0x80 | ((code_point >> 6) & 0x3F);
+    bytes[3] = 0x80 | (code_point & 0x3F);
+    return 4;
+}
+
+// Splits a code point range into sequences of byte ranges, so that UTF-8 encodings of [first, last]
+// are exactly the byte strings matching one of the sequences.
+void split_utf8_range(uint32_t first, uint32_t last, std::vector<ByteRanges>& sequences) {
+    for (uint32_t limit : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+        if (first <= limit && last > limit) {
+            split_utf8_range(first, limit, sequences);
+            split_utf8_range(limit + 1, last, sequences);
+            return;
+        }
+    }
+    if (last <= 0x7F) {
+        sequences.push_back({{static_cast<uint8_t>(first), static_cast<uint8_t>(last)}});
+        return;
+    }
+    for (uint32_t i = 1; i < 4; ++i) {
+        uint32_t mask = (1u << (6 * i)) - 1;
+        if ((first & ~mask) != (last & ~mask)) {
+            if ((first & mask) != 0) {
+                split_utf8_range(first, first | mask, sequences);
+                split_utf8_range((first | mask) + 1, last, sequences);
+                return;
+            }
+            if ((last & mask) != mask) {
+                split_utf8_range(first, (last & ~mask) - 1, sequences);
+                split_utf8_range(last & ~mask, last, sequences);
+                return;
+            }
+        }
+    }
+    uint8_t first_bytes[4], last_bytes[4];
+    size_t length = encode_utf8(first, first_bytes);
+    encode_utf8(last, last_bytes);
+    ByteRanges sequence;
+    for (size_t i = 0; i < length; ++i)
+        sequence.emplace_back(first_bytes[i], last_bytes[i]);
+    sequences.push_back(std::move(sequence));
+}
+
+// Thompson NFA
+class NFA {
+public:
+    struct Edge {
+        uint8_t first, last;
+        uint32_t target;
+    };
+
+    struct State {
+        std::vector<Edge> edges;
+        std::vector<uint32_t> epsilons;
+    };
+
+    struct Fragment {
+        uint32_t start, end;
+    };
+
+    std::vector<State> states;
+
+    uint32_t add_state() {
+        OPENVINO_ASSERT(states.size() < MAX_NFA_STATES, "Regex is too large");
+        states.emplace_back();
+        return states.size() - 1;
+    }
+
+    Fragment compile(const std::vector<RegexNode>& nodes, size_t index) {
+        const RegexNode& node = nodes[index];
+        switch (node.type) {
+        case RegexNode::Type::EMPTY: {
+            uint32_t state = add_state();
+            return {state, state};
+        }
+        case RegexNode::Type::CHARS: {
+            Fragment fragment{add_state(), add_state()};
+            std::vector<ByteRanges> sequences;
+            for (const auto& range : node.ranges)
+                split_utf8_range(range.first, range.second, sequences);
+            for (const ByteRanges& sequence : sequences) {
+                uint32_t current = fragment.start;
+                for (size_t i = 0; i + 1 < sequence.size(); ++i) {
+                    uint32_t next = add_state();
+                    states[current].edges.push_back({sequence[i].first, sequence[i].second, next});
+                    current = next;
+                }
+                states[current].edges.push_back({sequence.back().first, sequence.back().second, fragment.end});
+            }
+            return fragment;
+        }
+        case RegexNode::Type::CONCAT: {
+            Fragment fragment = compile(nodes, node.children.front());
+            for (size_t i = 1; i < node.children.size(); ++i) {
+                Fragment next = compile(nodes, node.children[i]);
+                states[fragment.end].epsilons.push_back(next.start);
+                fragment.end = next.end;
+            }
+            return fragment;
+        }
+        case RegexNode::Type::ALTERNATION: {
+            Fragment fragment{add_state(), add_state()};
+            for (size_t child : node.children) {
+                Fragment alternative = compile(nodes, child);
+                states[fragment.start].epsilons.push_back(alternative.start);
+                states[alternative.end].epsilons.push_back(fragment.end);
+            }
+            return fragment;
+        }
+        case RegexNode::Type::REPEAT: {
+            uint32_t start = add_state();
+            Fragment fragment{start, start};
+            for (size_t i = 0; i < node.min_count; ++i) {
+                Fragment copy = compile(nodes, node.children.front());
+                states[fragment.end].epsilons.push_back(copy.start);
+                fragment.end = copy.end;
+            }
+            if (node.max_count == INFINITE_COUNT) {
+                uint32_t loop = add_state();
+                Fragment copy = compile(nodes, node.children.front());
+                states[fragment.end].epsilons.push_back(loop);
+                states[loop].epsilons.push_back(copy.start);
+                states[copy.end].epsilons.push_back(loop);
+                fragment.end = loop;
+            } else {
+                uint32_t end = add_state();
+                for (size_t i = node.min_count; i < node.max_count; ++i) {
+                    Fragment copy = compile(nodes, node.children.front());
+                    states[fragment.end].epsilons.push_back(copy.start);
+                    states[fragment.end].epsilons.push_back(end);
+                    fragment.end = copy.end;
+                }
+                states[fragment.end].epsilons.push_back(end);
+                fragment.end = end;
+            }
+            return fragment;
+        }
+        }
+        OPENVINO_THROW("Unknown regex node");
+    }
+
+    void closure(std::vector<uint32_t>& set) const {
+        std::vector<uint8_t> visited(states.size(), 0);
+        std::vector<uint32_t> stack = set;
+        for (uint32_t state : set)
+            visited[state] = 1;
+        while (!stack.empty()) {
+            uint32_t state = stack.back();
+            stack.pop_back();
+            for (uint32_t next : states[state].epsilons) {
+                if (!visited[next]) {
+                    visited[next] = 1;
+                    set.push_back(next);
+                    stack.push_back(next);
+                }
+            }
+        }
+        std::sort(set.begin(), set.end());
+    }
+};
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+RegexDFA::RegexDFA(const std::string& pattern, size_t max_num_states) {
+    std::vector<RegexNode> nodes;
+    size_t root = RegexParser(pattern, nodes).parse();
+
+    NFA nfa;
+    NFA::Fragment fragment = nfa.compile(nodes, root);
+
+    // subset construction
+    std::map<std::vector<uint32_t>, int32_t> set_to_state;
+    std::vector<std::vector<uint32_t>> state_sets;
+    std::vector<int32_t> transitions;
+    std::vector<uint8_t> accepting;
+
+    auto get_state = [&](std::vector<uint32_t>&& set) -> int32_t {
+        auto it = set_to_state.find(set);
+        if (it != set_to_state.end())
+            return it->second;
+        OPENVINO_ASSERT(state_sets.size() < max_num_states, "Regex '", pattern, "' requires more than ", max_num_states, " automaton states");
+        int32_t state = state_sets.size();
+        accepting.push_back(std::binary_search(set.begin(), set.end(), fragment.end));
+        set_to_state.emplace(set, state);
+        state_sets.push_back(std::move(set));
+        return state;
+    };
+
+    std::vector<uint32_t> initial = {fragment.start};
+    nfa.closure(initial);
+    get_state(std::move(initial));
+
+    for (size_t state = 0; state < state_sets.size(); ++state) {
+        // bytes are grouped into intervals which are covered by the same set of edges
+        std::vector<uint32_t> boundaries = {0, 256};
+        for (uint32_t nfa_state : state_sets[state]) {
+            for (const NFA::Edge& edge : nfa.states[nfa_state].edges) {
+                boundaries.push_back(edge.first);
+                boundaries.push_back(edge.last + 1u);
+            }
+        }
+        std::sort(boundaries.begin(), boundaries.end());
+        boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+        transitions.resize((state + 1) * 256, DEAD_STATE);
+        for (size_t i = 0; i + 1 < boundaries.size(); ++i) {
+            std::vector<uint32_t> targets;
+            for (uint32_t nfa_state : state_sets[state]) {
+                for (const NFA::Edge& edge : nfa.states[nfa_state].edges) {
+                    if (edge.first <= boundaries[i] && boundaries[i] <= edge.last)
+                        targets.push_back(edge.target);
+                }
+            }
+            if (targets.empty())
+                continue;
+            std::sort(targets.begin(), targets.end());
+            targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+            nfa.closure(targets);
+            int32_t target = get_state(std::move(targets));
+            std::fill(transitions.begin() + state * 256 + boundaries[i], transitions.begin() + state * 256 + boundaries[i + 1], target);
+        }
+    }
+
+    // states which can't reach an accepting state are dead
+    const size_t num_states = state_sets.size();
+    std::vector<std::vector<int32_t>> predecessors(num_states);
+    for (size_t state = 0; state < num_states; ++state) {
+        for (size_t byte = 0; byte < 256; ++byte) {
+            int32_t target = transitions[state * 256 + byte];
+            if (target != DEAD_STATE && (predecessors[target].empty() || predecessors[target].back() != static_cast<int32_t>(state)))
+                predecessors[target].push_back(state);
+        }
+    }
+    std::vector<uint8_t> live(num_states, 0);
+    std::vector<int32_t> stack;
+    for (size_t state = 0; state < num_states; ++state) {
+        if (accepting[state]) {
+            live[state] = 1;
+            stack.push_back(state);
+        }
+    }
+    while (!stack.empty()) {
+        int32_t state = stack.back();
+        stack.pop_back();
+        for (int32_t predecessor : predecessors[state]) {
+            if (!live[predecessor]) {
+                live[predecessor] = 1;
+                stack.push_back(predecessor);
+            }
+        }
+    }
+    OPENVINO_ASSERT(live[0], "Regex '", pattern, "' does not match any text");
+
+    std::vector<int32_t> new_index(num_states, DEAD_STATE);
+    for (size_t state = 0, index = 0; state < num_states; ++state) {
+        if (live[state])
+            new_index[state] = index++;
+    }
+    for (size_t state = 0; state < num_states; ++state) {
+        if (!live[state])
+            continue;
+        m_accepting.push_back(accepting[state]);
+        for (size_t byte = 0; byte < 256; ++byte) {
+            int32_t target = transitions[state * 256 + byte];
+            m_transitions.push_back(target == DEAD_STATE ? DEAD_STATE : new_index[target]);
+        }
+    }
+}
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,56 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Deterministic automaton over UTF-8 bytes which accepts texts fully matching a regular expression.
+ *
+ * Supported syntax: literals, escapes (\d \w \s and their negations, \n \t \r \f \v, \xHH, \uHHHH, escaped
+ * metacharacters), ".", character classes with ranges and negation, groups "(...)" and "(?:...)", alternation "|"
+ * and greedy or lazy quantifiers "*", "+", "?", "{n}", "{n,}", "{n,m}". Leading "^" and trailing "$" are accepted
+ * and ignored, as the whole text is always matched. Non-ASCII characters are matched as their UTF-8 byte sequences.
+ *
+ * States which cannot reach an accepting state are merged into DEAD_STATE, so any non-dead state can be completed.
+ */
+class RegexDFA {
+public:
+    static constexpr int32_t DEAD_STATE = -1;
+
+    /**
+     * @brief Compiles a pattern.
+     * @throws Exception if the pattern is malformed, matches nothing or exceeds max_num_states.
+     */
+    explicit RegexDFA(const std::string& pattern, size_t max_num_states = 20000);
+
+    int32_t get_initial_state() const {
+        return 0;
+    }
+
+    int32_t next(int32_t state, uint8_t byte) const {
+        return m_transitions[static_cast<size_t>(state) * 256 + byte];
+    }
+
+    bool is_accepting(int32_t state) const {
+        return m_accepting[state];
+    }
+
+    size_t get_num_states() const {
+        return m_accepting.size();
+    }
+
+private:
+    // 256 transitions per state
+    std::vector<int32_t> m_transitions;
+    std::vector<uint8_t> m_accepting;
+};
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,362 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "structured_output/schema_to_regex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "openvino/core/except.hpp"
+
+namespace {
+
+using ordered_json = nlohmann::ordered_json;
+
+const std::string WHITESPACE = "[ \\t\\n\\r]*";
+const std::string STRING_CHAR = "([^\"\\\\\\x00-\\x1f]|\\\\([\"\\\\/bfnrt]|u[0-9a-fA-F]{4}))";
+const std::string STRING = "\"" + STRING_CHAR + "*\"";
+const std::string INTEGER = "-?(0|[1-9][0-9]*)";
+const std::string NUMBER = INTEGER + "(\\.[0-9]+)?([eE][+-]?[0-9]+)?";
+const std::string BOOLEAN = "(true|false)";
+const std::string NULL_VALUE = "null";
+// nesting depth of objects and arrays without a schema for their content
+constexpr size_t ANY_VALUE_DEPTH = 2;
+constexpr size_t MAX_REF_DEPTH = 32;
+
+std::string escape_regex(const std::string& text) {
+    static const std::string metacharacters = "\\.^$|?*+()[]{}";
+    std::string escaped;
+    for (char c : text) {
+        if (metacharacters.find(c) != std::string::npos)
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+std::string join_alternatives(const std::vector<std::string>& alternatives) {
+    OPENVINO_ASSERT(!alternatives.empty());
+    std::string result = "(";
+    for (size_t i = 0; i < alternatives.size(); ++i)
+        result += (i ? "|" : "") + alternatives[i];
+    return result + ")";
+}
+
+std::string any_value(size_t depth) {
+    std::vector<std::string> alternatives = {STRING, NUMBER, BOOLEAN, NULL_VALUE};
+    if (depth > 0) {
+        std::string inner = any_value(depth - 1);
+        std::string member = STRING + WHITESPACE + ":" + WHITESPACE + inner;
+        alternatives.push_back("\\{" + WHITESPACE + "(" + member + "(" + WHITESPACE + "," + WHITESPACE + member + ")*)?" + WHITESPACE + "\\}");
+        alternatives.push_back("\\[" + WHITESPACE + "(" + inner + "(" + WHITESPACE + "," + WHITESPACE + inner + ")*)?" + WHITESPACE + "\\]");
+    }
+    return join_alternatives(alternatives);
+}
+
+std::string repeat_suffix(const ordered_json& schema, const char* min_key, const char* max_key) {
+    size_t min_count = schema.value(min_key, size_t(0));
+    if (!schema.contains(max_key))
+        return min_count ? "{" + std::to_string(min_count) + ",}" : "*";
+    return "{" + std::to_string(min_count) + "," + std::to_string(schema[max_key].get<size_t>()) + "}";
+}
+
+class JsonSchemaConverter {
+public:
+    explicit JsonSchemaConverter(const ordered_json& root) : m_root(root) {}
+
+    std::string convert(const ordered_json& schema) {
+        if (schema.is_boolean()) {
+            OPENVINO_ASSERT(schema.get<bool>(), "JSON schema 'false' does not match any value");
+            return any_value(ANY_VALUE_DEPTH);
+        }
+        OPENVINO_ASSERT(schema.is_object(), "JSON schema must be an object, got: ", schema.dump());
+
+        if (schema.contains("$ref"))
+            return convert_ref(schema["$ref"].get<std::string>());
+        if (schema.contains("const"))
+            return escape_regex(schema["const"].dump());
+        if (schema.contains("enum")) {
+            std::vector<std::string> alternatives;
+            for (const auto& value : schema["enum"])
+                alternatives.push_back(escape_regex(value.dump()));
+            return join_alternatives(alternatives);
+        }
+        for (const char* key : {"anyOf", "oneOf"}) {
+            if (schema.contains(key)) {
+                std::vector<std::string> alternatives;
+                for (const auto& alternative : schema[key])
+                    alternatives.push_back(convert(alternative));
+                return join_alternatives(alternatives);
+            }
+        }
+        if (schema.contains("allOf")) {
+            OPENVINO_ASSERT(schema["allOf"].size() == 1, "JSON schema 'allOf' is supported only with a single schema");
+            return convert(schema["allOf"][0]);
+        }
+
+        if (!schema.contains("type")) {
+            if (schema.contains("properties"))
+                return convert_type(schema, "object");
+            if (schema.contains("items"))
+                return convert_type(schema, "array");
+            return any_value(ANY_VALUE_DEPTH);
+        }
+        const ordered_json& type = schema["type"];
+        if (type.is_array()) {
+            std::vector<std::string> alternatives;
+            for (const auto& single_type : type)
+                alternatives.push_back(convert_type(schema, single_type.get<std::string>()));
+            return join_alternatives(alternatives);
+        }
+        return convert_type(schema, type.get<std::string>());
+    }
+
+private:
+    const ordered_json& m_root;
+    std::vector<std::string> m_ref_stack;
+
+    std::string convert_ref(const std::string& ref) {
+        OPENVINO_ASSERT(ref.rfind("#", 0) == 0, "Only local JSON schema references are supported, got: ", ref);
+        OPENVINO_ASSERT(std::find(m_ref_stack.begin(), m_ref_stack.end(), ref) == m_ref_stack.end() && m_ref_stack.size() < MAX_REF_DEPTH,
+                        "Recursive JSON schema reference '", ref, "' cannot be represented by a regular language");
+        m_ref_stack.push_back(ref);
+        std::string result = convert(m_root.at(ordered_json::json_pointer(ref.substr(1))));
+        m_ref_stack.pop_back();
+        return result;
+    }
+
+    std::string convert_type(const ordered_json& schema, const std::string& type) {
+        if (type == "string") {
+            if (schema.contains("pattern")) {
+                std::string pattern = schema["pattern"].get<std::string>();
+                // JSON schema patterns are not anchored by default, only explicitly anchored ones are matched as a whole
+                if (!pattern.empty() && pattern.front() == '^')
+                    pattern.erase(0, 1);
+                else
+                    pattern = ".*" + pattern;
+                if (!pattern.empty() && pattern.back() == '$' && (pattern.size() < 2 || pattern[pattern.size() - 2] != '\\'))
+                    pattern.pop_back();
+                else
+                    pattern += ".*";
+                return "\"(" + pattern + ")\"";
+            }
+            if (schema.contains("minLength") || schema.contains("maxLength"))
+                return "\"" + STRING_CHAR + repeat_suffix(schema, "minLength", "maxLength") + "\"";
+            return STRING;
+        }
+        if (type == "integer")
+            return INTEGER;
+        if (type == "number")
+            return NUMBER;
+        if (type == "boolean")
+            return BOOLEAN;
+        if (type == "null")
+            return NULL_VALUE;
+        if (type == "array") {
+            std::string item = schema.contains("items") ? convert(schema["items"]) : any_value(ANY_VALUE_DEPTH - 1);
+            size_t min_items = schema.value("minItems", size_t(0));
+            std::string rest = "(" + WHITESPACE + "," + WHITESPACE + item + ")";
+            if (schema.contains("maxItems")) {
+                size_t max_items = schema["maxItems"].get<size_t>();
+                if (max_items == 0)
+                    return "\\[" + WHITESPACE + "\\]";
+                rest += "{" + std::to_string(min_items ? min_items - 1 : 0) + "," + std::to_string(max_items - 1) + "}";
+            } else {
+                rest += min_items > 1 ? "{" + std::to_string(min_items - 1) + ",}" : "*";
+            }
+            std::string items = item + rest;
+            if (min_items == 0)
+                items = "(" + items + ")?";
+            return "\\[" + WHITESPACE + items + WHITESPACE + "\\]";
+        }
+        if (type == "object") {
+            if (!schema.contains("properties"))
+                return any_value(ANY_VALUE_DEPTH);
+            return convert_object(schema);
+        }
+        OPENVINO_THROW("Unsupported JSON schema type '", type, "'");
+    }
+
+    std::string convert_object(const ordered_json& schema) {
+        std::set<std::string> required;
+        if (schema.contains("required")) {
+            for (const auto& name : schema["required"])
+                required.insert(name.get<std::string>());
+        }
+
+        std::vector<std::string> members;
+        std::vector<bool> is_required;
+        for (const auto& [name, property] : schema["properties"].items()) {
+            members.push_back(escape_regex(ordered_json(name).dump()) + WHITESPACE + ":" + WHITESPACE + convert(property));
+            is_required.push_back(required.count(name) > 0);
+        }
+
+        // with_comma[i] matches members i..n-1 when a member was already generated, i.e. each of them is preceded by a comma,
+        // first[i] matches members i..n-1 when no member was generated yet. Optional members may be omitted.
+        const size_t num_members = members.size();
+        std::vector<std::string> with_comma(num_members + 1), first(num_members + 1);
+        for (size_t i = num_members; i-- > 0;) {
+            std::string separated = WHITESPACE + "," + WHITESPACE + members[i];
+            with_comma[i] = (is_required[i] ? separated : "(" + separated + ")?") + with_comma[i + 1];
+            std::string starting_here = members[i] + with_comma[i + 1];
+            first[i] = is_required[i] ? starting_here : "(" + starting_here + "|" + first[i + 1] + ")";
+        }
+        return "\\{" + WHITESPACE + first[0] + WHITESPACE + "\\}";
+    }
+};
+
+struct GrammarToken {
+    enum class Type { RULE, LITERAL, REGEX } type;
+    std::string text;
+};
+
+class GrammarParser {
+public:
+    explicit GrammarParser(const std::string& grammar) : m_grammar(grammar) {
+        std::vector<GrammarToken> tokens;
+        std::vector<std::string> names;
+        while (next_token(tokens)) {}
+
+        // a rule starts with "name ::="
+        std::string current;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            if (tokens[i].type == GrammarToken::Type::RULE && i + 1 < tokens.size() &&
+                tokens[i + 1].type == GrammarToken::Type::REGEX && tokens[i + 1].text == "::=") {
+                current = tokens[i].text;
+                OPENVINO_ASSERT(m_rules.emplace(current, std::vector<GrammarToken>{}).second, "Grammar rule '", current, "' is defined twice");
+                ++i;
+                continue;
+            }
+            OPENVINO_ASSERT(!current.empty(), "Grammar must start with a rule definition 'name ::= ...'");
+            m_rules[current].push_back(tokens[i]);
+        }
+    }
+
+    std::string to_regex(const std::string& rule) {
+        auto converted = m_converted.find(rule);
+        if (converted != m_converted.end())
+            return converted->second;
+        auto it = m_rules.find(rule);
+        OPENVINO_ASSERT(it != m_rules.end(), "Grammar rule '", rule, "' is not defined");
+        OPENVINO_ASSERT(m_in_progress.insert(rule).second,
+                        "Grammar rule '", rule, "' is recursive and cannot be represented by a regular language");
+        OPENVINO_ASSERT(!it->second.empty(), "Grammar rule '", rule, "' is empty");
+
+        std::string regex;
+        for (const GrammarToken& token : it->second) {
+            if (token.type == GrammarToken::Type::RULE)
+                regex += "(" + to_regex(token.text) + ")";
+            else if (token.type == GrammarToken::Type::LITERAL)
+                regex += escape_regex(token.text);
+            else
+                regex += token.text;
+        }
+        m_in_progress.erase(rule);
+        regex = "(" + regex + ")";
+        m_converted.emplace(rule, regex);
+        return regex;
+    }
+
+private:
+    const std::string& m_grammar;
+    size_t m_pos = 0;
+    std::map<std::string, std::vector<GrammarToken>> m_rules;
+    std::map<std::string, std::string> m_converted;
+    std::set<std::string> m_in_progress;
+
+    static bool is_name_char(char c, bool first) {
+        return std::isalpha(static_cast<unsigned char>(c)) || c == '_' || (!first && (std::isdigit(static_cast<unsigned char>(c)) || c == '-'));
+    }
+
+    bool next_token(std::vector<GrammarToken>& tokens) {
+        while (m_pos < m_grammar.size()) {
+            if (std::isspace(static_cast<unsigned char>(m_grammar[m_pos]))) {
+                ++m_pos;
+            } else if (m_grammar[m_pos] == '#') {
+                m_pos = m_grammar.find('\n', m_pos);
+                if (m_pos == std::string::npos)
+                    m_pos = m_grammar.size();
+            } else {
+                break;
+            }
+        }
+        if (m_pos == m_grammar.size())
+            return false;
+
+        char c = m_grammar[m_pos];
+        if (is_name_char(c, true)) {
+            size_t begin = m_pos;
+            while (m_pos < m_grammar.size() && is_name_char(m_grammar[m_pos], false))
+                ++m_pos;
+            tokens.push_back({GrammarToken::Type::RULE, m_grammar.substr(begin, m_pos - begin)});
+        } else if (m_grammar.compare(m_pos, 3, "::=") == 0) {
+            m_pos += 3;
+            tokens.push_back({GrammarToken::Type::REGEX, "::="});
+        } else if (c == '"') {
+            std::string literal;
+            for (++m_pos; m_pos < m_grammar.size() && m_grammar[m_pos] != '"'; ++m_pos) {
+                if (m_grammar[m_pos] == '\\' && m_pos + 1 < m_grammar.size()) {
+                    char escaped = m_grammar[++m_pos];
+                    literal += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped == 'r' ? '\r' : escaped;
+                } else {
+                    literal += m_grammar[m_pos];
+                }
+            }
+            OPENVINO_ASSERT(m_pos < m_grammar.size(), "Unterminated string literal in grammar");
+            ++m_pos;
+            tokens.push_back({GrammarToken::Type::LITERAL, literal});
+        } else if (c == '[') {
+            // character classes use the regex syntax and are copied as is
+            size_t begin = m_pos++;
+            if (m_pos < m_grammar.size() && m_grammar[m_pos] == '^')
+                ++m_pos;
+            if (m_pos < m_grammar.size() && m_grammar[m_pos] == ']')
+                ++m_pos;
+            for (; m_pos < m_grammar.size() && m_grammar[m_pos] != ']'; ++m_pos) {
+                if (m_grammar[m_pos] == '\\')
+                    ++m_pos;
+            }
+            OPENVINO_ASSERT(m_pos < m_grammar.size(), "Unterminated character class in grammar");
+            ++m_pos;
+            tokens.push_back({GrammarToken::Type::REGEX, m_grammar.substr(begin, m_pos - begin)});
+        } else if (c == '{') {
+            size_t end = m_grammar.find('}', m_pos);
+            OPENVINO_ASSERT(end != std::string::npos, "Unterminated repetition in grammar");
+            tokens.push_back({GrammarToken::Type::REGEX, m_grammar.substr(m_pos, end + 1 - m_pos)});
+            m_pos = end + 1;
+        } else if (std::string("()|*+?.").find(c) != std::string::npos) {
+            ++m_pos;
+            tokens.push_back({GrammarToken::Type::REGEX, std::string(1, c)});
+        } else {
+            OPENVINO_THROW("Unexpected '", c, "' in grammar at position ", m_pos);
+        }
+        return true;
+    }
+};
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+std::string json_schema_to_regex(const std::string& json_schema) {
+    ordered_json schema;
+    try {
+        schema = ordered_json::parse(json_schema);
+    } catch (const ordered_json::exception& error) {
+        OPENVINO_THROW("Failed to parse JSON schema: ", error.what());
+    }
+    return JsonSchemaConverter(schema).convert(schema);
+}
+
+std::string grammar_to_regex(const std::string& grammar) {
+    return GrammarParser(grammar).to_regex("root");
+}
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,34 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string>
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Converts a JSON schema into a regex in RegexDFA syntax matching serialized JSON values which satisfy the schema.
+ *
+ * Supported keywords: type (including a list of types), properties, required, items, minItems, maxItems,
+ * minLength, maxLength, pattern, enum, const, anyOf, oneOf, allOf with a single schema and local $ref to $defs
+ * or definitions. Object properties are generated in the order of declaration, additional properties are not allowed.
+ * Objects and arrays without properties or items schema accept any JSON value nested up to a fixed depth,
+ * as recursive structures cannot be represented by a regular language.
+ * @throws Exception if the schema is not valid JSON or uses recursive references.
+ */
+std::string json_schema_to_regex(const std::string& json_schema);
+
+/**
+ * @brief Converts an EBNF grammar into a regex in RegexDFA syntax.
+ *
+ * Rules are defined as `name ::= expression`, where expression consists of "string literals", [character classes],
+ * references to other rules, groups, alternation "|" and quantifiers "*", "+", "?", "{n,m}". Comments start with '#'.
+ * The text is matched by the "root" rule. Rules are inlined, so the grammar has to be regular.
+ * @throws Exception if the grammar is malformed or recursive.
+ */
+std::string grammar_to_regex(const std::string& grammar);
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,146 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "structured_output/token_automaton.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "structured_output/schema_to_regex.hpp"
+
+namespace ov {
+namespace genai {
+
+DecodedVocab::DecodedVocab(std::vector<std::string> tokens, std::vector<std::string> first_tokens) {
+    OPENVINO_ASSERT(!tokens.empty(), "Vocab must not be empty");
+    OPENVINO_ASSERT(first_tokens.empty() || first_tokens.size() == tokens.size(), "Vocab sizes must match");
+    m_tokens[0] = std::move(tokens);
+    m_tokens[1] = std::move(first_tokens);
+
+    for (size_t kind = 0; kind < 2; ++kind) {
+        const std::vector<std::string>& vocab = m_tokens[kind];
+        if (vocab.empty())
+            continue;
+        std::vector<int64_t>& sorted_ids = m_sorted_ids[kind];
+        sorted_ids.resize(vocab.size());
+        std::iota(sorted_ids.begin(), sorted_ids.end(), 0);
+        std::sort(sorted_ids.begin(), sorted_ids.end(), [&vocab](int64_t lhs, int64_t rhs) { return vocab[lhs] < vocab[rhs]; });
+
+        std::vector<uint32_t>& common_prefix = m_common_prefix[kind];
+        common_prefix.resize(vocab.size(), 0);
+        for (size_t i = 1; i < sorted_ids.size(); ++i) {
+            const std::string& previous = vocab[sorted_ids[i - 1]];
+            const std::string& current = vocab[sorted_ids[i]];
+            size_t length = 0;
+            while (length < previous.size() && length < current.size() && previous[length] == current[length])
+                ++length;
+            common_prefix[i] = length;
+        }
+    }
+}
+
+TokenAutomaton::TokenAutomaton(const std::string& regex, std::shared_ptr<const DecodedVocab> vocab)
+    : m_dfa(regex), m_vocab(std::move(vocab)) {
+    m_initial_state = m_vocab->has_first_tokens() ? static_cast<int32_t>(m_dfa.get_num_states()) : m_dfa.get_initial_state();
+}
+
+int32_t TokenAutomaton::advance(int32_t state, int64_t token_id) const {
+    if (state == DEAD_STATE || token_id < 0 || static_cast<size_t>(token_id) >= m_vocab->size())
+        return DEAD_STATE;
+    const std::string& bytes = m_vocab->get_token(token_id, is_first_token(state));
+    if (bytes.empty())
+        return DEAD_STATE;
+    int32_t dfa_state = to_dfa_state(state);
+    for (size_t i = 0; i < bytes.size() && dfa_state != DEAD_STATE; ++i)
+        dfa_state = m_dfa.next(dfa_state, static_cast<uint8_t>(bytes[i]));
+    return dfa_state;
+}
+
+const TokenAutomaton::Mask& TokenAutomaton::get_allowed_tokens(int32_t state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_masks.find(state);
+    if (it == m_masks.end())
+        it = m_masks.emplace(state, compute_allowed_tokens(state)).first;
+    return it->second;
+}
+
+TokenAutomaton::Mask TokenAutomaton::compute_allowed_tokens(int32_t state) const {
+    const size_t vocab_size = m_vocab->size();
+    Mask mask((vocab_size + 63) / 64, 0);
+    if (state == DEAD_STATE)
+        return mask;
+
+    const size_t kind = is_first_token(state);
+    const std::vector<std::string>& tokens = m_vocab->m_tokens[kind];
+    const std::vector<int64_t>& sorted_ids = m_vocab->m_sorted_ids[kind];
+    const std::vector<uint32_t>& common_prefix = m_vocab->m_common_prefix[kind];
+
+    // dfa_states[i] is a state after the first i bytes of the current token,
+    // they are valid up to num_walked and only the last of them can be dead
+    std::vector<int32_t> dfa_states(1, to_dfa_state(state));
+    size_t num_walked = 0;
+    for (size_t i = 0; i < sorted_ids.size(); ++i) {
+        const int64_t token_id = sorted_ids[i];
+        const std::string& bytes = tokens[token_id];
+        num_walked = std::min<size_t>(num_walked, common_prefix[i]);
+        if (dfa_states.size() < bytes.size() + 1)
+            dfa_states.resize(bytes.size() + 1);
+        while (num_walked < bytes.size() && dfa_states[num_walked] != DEAD_STATE) {
+            dfa_states[num_walked + 1] = m_dfa.next(dfa_states[num_walked], static_cast<uint8_t>(bytes[num_walked]));
+            ++num_walked;
+        }
+        if (!bytes.empty() && num_walked == bytes.size() && dfa_states[num_walked] != DEAD_STATE)
+            mask[token_id / 64] |= uint64_t(1) << (token_id % 64);
+    }
+    return mask;
+}
+
+StructuredOutputCache::StructuredOutputCache(const Tokenizer& tokenizer, size_t capacity)
+    : m_tokenizer(tokenizer), m_capacity(capacity) {}
+
+std::shared_ptr<TokenAutomaton> StructuredOutputCache::get(const StructuredOutputConfig& config) {
+    std::string key, regex;
+    if (config.json_schema.has_value()) {
+        key = "json_schema:" + *config.json_schema;
+    } else if (config.regex.has_value()) {
+        key = "regex:" + *config.regex;
+    } else {
+        OPENVINO_ASSERT(config.grammar.has_value(), "Structured output config must contain json_schema, regex or grammar");
+        key = "grammar:" + *config.grammar;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_automatons.splice(m_automatons.begin(), m_automatons, it->second);
+        return it->second->second;
+    }
+
+    if (!m_vocab) {
+        std::vector<std::string> tokens = m_tokenizer.get_decoded_vocab();
+        std::vector<std::string> first_tokens = m_tokenizer.get_decoded_vocab(true);
+        if (first_tokens == tokens)
+            first_tokens.clear();
+        m_vocab = std::make_shared<DecodedVocab>(std::move(tokens), std::move(first_tokens));
+    }
+
+    if (config.json_schema.has_value()) {
+        regex = json_schema_to_regex(*config.json_schema);
+    } else if (config.regex.has_value()) {
+        regex = *config.regex;
+    } else {
+        regex = grammar_to_regex(*config.grammar);
+    }
+    auto automaton = std::make_shared<TokenAutomaton>(regex, m_vocab);
+
+    m_automatons.emplace_front(key, automaton);
+    m_index[key] = m_automatons.begin();
+    if (m_automatons.size() > m_capacity) {
+        m_index.erase(m_automatons.back().first);
+        m_automatons.pop_back();
+    }
+    return automaton;
+}
+
+}  // namespace genai
+}  // namespace ov
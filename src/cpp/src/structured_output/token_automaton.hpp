@@ -0,0 +1,131 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/genai/generation_config.hpp"
+#include "openvino/genai/tokenizer.hpp"
+#include "structured_output/regex_dfa.hpp"
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Bytes which every token contributes to a decoded text, shared by all automatons built for a tokenizer.
+ */
+class DecodedVocab {
+public:
+    /**
+     * @param tokens bytes of each token in the middle of a text, tokens with empty bytes are never allowed
+     * @param first_tokens bytes of each token at the beginning of a text if they differ, e.g. for tokenizers
+     *        which strip the leading space, otherwise empty
+     */
+    DecodedVocab(std::vector<std::string> tokens, std::vector<std::string> first_tokens = {});
+
+    size_t size() const {
+        return m_tokens[0].size();
+    }
+
+    bool has_first_tokens() const {
+        return !m_tokens[1].empty();
+    }
+
+    const std::string& get_token(int64_t token_id, bool first = false) const {
+        return m_tokens[first][token_id];
+    }
+
+private:
+    friend class TokenAutomaton;
+
+    // [0] middle of a text, [1] beginning of a text
+    std::vector<std::string> m_tokens[2];
+    // token ids sorted by their bytes and the length of a common prefix with the previous token in this order,
+    // so that walking all tokens through an automaton shares work for common prefixes
+    std::vector<int64_t> m_sorted_ids[2];
+    std::vector<uint32_t> m_common_prefix[2];
+};
+
+/**
+ * @brief Token-level automaton which constrains generated text to a regular language.
+ *
+ * A state is a state of the byte-level RegexDFA reached after the decoded text generated so far. A token is allowed
+ * in a state if its bytes lead to a state from which an accepting one is reachable. Allowed tokens of each visited
+ * state are computed once and stored as a bitmask over the vocab, so an automaton can be shared by requests
+ * with the same specification.
+ */
+class TokenAutomaton {
+public:
+    using Mask = std::vector<uint64_t>;
+    static constexpr int32_t DEAD_STATE = RegexDFA::DEAD_STATE;
+
+    TokenAutomaton(const std::string& regex, std::shared_ptr<const DecodedVocab> vocab);
+
+    int32_t get_initial_state() const {
+        return m_initial_state;
+    }
+
+    int32_t advance(int32_t state, int64_t token_id) const;
+
+    bool is_accepting(int32_t state) const {
+        return state != DEAD_STATE && m_dfa.is_accepting(to_dfa_state(state));
+    }
+
+    /**
+     * @brief Returns a bitmask of allowed tokens, bit `i % 64` of word `i / 64` corresponds to token i.
+     */
+    const Mask& get_allowed_tokens(int32_t state);
+
+    size_t get_vocab_size() const {
+        return m_vocab->size();
+    }
+
+private:
+    RegexDFA m_dfa;
+    std::shared_ptr<const DecodedVocab> m_vocab;
+    // if the vocab has separate first tokens, the beginning of a text is an extra state after all DFA states
+    int32_t m_initial_state;
+
+    std::mutex m_mutex;
+    std::unordered_map<int32_t, Mask> m_masks;
+
+    int32_t to_dfa_state(int32_t state) const {
+        return state == m_initial_state ? m_dfa.get_initial_state() : state;
+    }
+
+    bool is_first_token(int32_t state) const {
+        return m_vocab->has_first_tokens() && state == m_initial_state;
+    }
+
+    Mask compute_allowed_tokens(int32_t state) const;
+};
+
+/**
+ * @brief Compiles token automatons for structured output specifications and keeps the recently used ones,
+ * so that requests with the same specification reuse the compiled automaton and its cached bitmasks.
+ */
+class StructuredOutputCache {
+public:
+    explicit StructuredOutputCache(const Tokenizer& tokenizer, size_t capacity = 32);
+
+    std::shared_ptr<TokenAutomaton> get(const StructuredOutputConfig& config);
+
+private:
+    Tokenizer m_tokenizer;
+    size_t m_capacity;
+    std::shared_ptr<const DecodedVocab> m_vocab = nullptr;
+
+    std::mutex m_mutex;
+    // most recently used first
+    std::list<std::pair<std::string, std::shared_ptr<TokenAutomaton>>> m_automatons;
+    std::unordered_map<std::string, decltype(m_automatons)::iterator> m_index;
+};
+
+}  // namespace genai
+}  // namespace ov
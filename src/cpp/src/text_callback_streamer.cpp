@@ -6,12 +6,36 @@
 namespace ov {
 namespace genai {
 
-TextCallbackStreamer::TextCallbackStreamer(const Tokenizer& tokenizer, std::function<bool(std::string)> callback) {
+TextCallbackStreamer::TextCallbackStreamer(const Tokenizer& tokenizer, std::function<bool(std::string)> callback, bool async_detokenization) {
     m_tokenizer = tokenizer;
     on_finalized_subword_callback = callback;
+    m_async_detokenization = async_detokenization;
+    if (m_async_detokenization) {
+        m_detokenization_worker = std::make_unique<WorkerPool>(1);
+    }
 }
 
 bool TextCallbackStreamer::put(int64_t token) {
+    if (!m_async_detokenization) {
+        return on_finalized_subword_callback(get_printable_text(token));
+    }
+
+    if (m_pending_text.valid() && on_finalized_subword_callback(m_pending_text.get())) {
+        return true;
+    }
+    auto text = std::make_shared<std::promise<std::string>>();
+    m_pending_text = text->get_future();
+    m_detokenization_worker->submit([this, token, text] {
+        try {
+            text->set_value(get_printable_text(token));
+        } catch (...) {
+            text->set_exception(std::current_exception());
+        }
+    });
+    return false;
+}
+
+std::string TextCallbackStreamer::get_printable_text(int64_t token) {
     std::stringstream res;
     m_tokens_cache.push_back(token);
     std::string text = m_tokenizer.decode(m_tokens_cache);
@@ -20,13 +44,13 @@ bool TextCallbackStreamer::put(int64_t token) {
         res << std::string_view{text.data() + print_len, text.size() - print_len};
         m_tokens_cache.clear();
         print_len = 0;
-        return on_finalized_subword_callback(res.str());
+        return res.str();
     }
 
     constexpr char replacement[] = "\xef\xbf\xbd";  // MSVC with /utf-8 fails to compile � directly with newline in string literal error.
     if (text.size() >= 3 && text.compare(text.size() - 3, 3, replacement) == 0) {
         // Don't print incomplete text
-        return on_finalized_subword_callback(res.str());
+        return res.str();
     } else if (text.size() > print_len) {
         // It is possible to have a shorter text after adding new token.
         // Print to output only if text length is increaesed.
@@ -34,10 +58,13 @@ bool TextCallbackStreamer::put(int64_t token) {
         print_len = text.size();
     }
 
-    return on_finalized_subword_callback(res.str());
+    return res.str();
 }
 
 void TextCallbackStreamer::end() {
+    if (m_pending_text.valid()) {
+        on_finalized_subword_callback(m_pending_text.get());
+    }
     std::stringstream res;
     std::string text = m_tokenizer.decode(m_tokens_cache);
     if (text.size() <= print_len)
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
+
 #include "openvino/genai/streamer_base.hpp"
 #include "openvino/genai/tokenizer.hpp"
+#include "worker_pool.hpp"
 
 namespace ov {
 namespace genai {
@@ -14,7 +18,13 @@ public:
     bool put(int64_t token) override;
     void end() override;
 
-    TextCallbackStreamer(const Tokenizer& tokenizer, std::function<bool(std::string)> callback);
+    /**
+     * @param async_detokenization if true, put() returns right after scheduling detokenization of the token on a worker thread
+     * owned by the streamer, the callback is called for the text of the token by the next put() or end(), so it's still called
+     * on the caller's thread. As the callback lags by a token, generation is stopped one token later than with synchronous
+     * detokenization, so it's only enabled on request, see ov::genai::async_detokenization.
+     */
+    TextCallbackStreamer(const Tokenizer& tokenizer, std::function<bool(std::string)> callback, bool async_detokenization = false);
 
     std::function<bool(std::string)> on_finalized_subword_callback = [](std::string words)->bool { return false; };
 
@@ -22,6 +32,16 @@ protected:
     Tokenizer m_tokenizer;
     std::vector<int64_t> m_tokens_cache;
     size_t print_len = 0;
+    bool m_async_detokenization = false;
+    // text of the previous token, which is being detokenized
+    std::future<std::string> m_pending_text;
+
+    // returns the text to pass to the callback after the token is added
+    std::string get_printable_text(int64_t token);
+
+private:
+    // single long-lived thread detokenizing tokens in async mode; declared last to be joined first
+    std::unique_ptr<WorkerPool> m_detokenization_worker;
 };
 
 }  // namespace genai
@@ -1,9 +1,18 @@
 // Copyright (C) 2023-2024 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
 #include <jinja2cpp/template.h>
 #include <jinja2cpp/template_env.h>
 #include <jinja2cpp/user_callable.h>
@@ -17,6 +26,7 @@
 #include "make_tokenizer_stateful.hpp"
 #include "tokenizers_path.hpp"
 #include "circular_buffer_queue.hpp"
+#include "vocab_decoder_table.hpp"
 #include "json_utils.hpp"
 #include "utils.hpp"
 
@@ -77,10 +87,11 @@ public:
     ov::CompiledModel m_tokenizer;
     ov::CompiledModel m_detokenizer;
 
-    std::unique_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_tokenizer;
-    std::unique_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_detokenizer;
+    // Compiled models and infer requests are shared by tokenizers loaded from the same path with the same properties
+    std::shared_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_tokenizer;
+    std::shared_ptr<CircularBufferQueue<ov::InferRequest>> m_ireq_queue_detokenizer;
     // To change the adding special tokens mode we use a statefull subgraph, 
-    // this flag holds the current state value of the CompiledModel.
+    // these flags hold the last used values, which are the defaults for the next calls.
     bool m_add_special_tokens = true;
     bool m_skip_special_tokens = true;
     bool m_older_than_24_5 = false;
@@ -94,25 +105,82 @@ public:
     std::string m_eos_token = {};
 
     std::string m_chat_template = {};
+    // the template read from tokenizer_config.json, which is the initial one for tokenizers sharing the models
+    std::string m_default_chat_template = {};
 
-    void set_state_if_necessary(CircularBufferQueueElementGuard<ov::InferRequest>& infer_request_guard, const ov::AnyMap& params) {
+    // Jinja2Cpp template keeps a pointer to its environment, so they are allocated together and never moved
+    struct CompiledChatTemplate {
+        jinja2::TemplateEnv env;
+        jinja2::Template tpl{&env};
+    };
+    // Templates are parsed once: the default one in the constructor and in set_chat_template(),
+    // the one passed to apply_chat_template() is kept until a different one is passed.
+    // nullptr means Jinja2Cpp failed to parse the template, the error is reported when it's applied.
+    std::shared_ptr<CompiledChatTemplate> m_compiled_chat_template = nullptr;
+    mutable std::string m_custom_chat_template = {};
+    mutable std::shared_ptr<CompiledChatTemplate> m_compiled_custom_chat_template = nullptr;
+    // Jinja2Cpp doesn't guarantee that rendering of the same template from multiple threads is safe
+    mutable std::mutex m_chat_template_mutex;
+
+    // Native id-to-bytes table, used instead of the detokenizer model when it reproduces the model's output.
+    std::shared_ptr<VocabDecoderTable> m_vocab_table = nullptr;
+    // If skip_special_tokens can't be changed at runtime, the detokenizer always skips special tokens.
+    bool m_skip_special_tokens_switchable = false;
+
+    size_t m_infer_request_queue_size = 1;
+    // Values of add_special_tokens and skip_special_tokens set to the state of each infer request from the queues,
+    // requests which are not in the map have the default values. Shared together with the queues.
+    struct InferRequestStates {
+        std::unordered_map<const ov::InferRequest*, std::pair<bool, bool>> states;
+        std::mutex mutex;
+    };
+    std::shared_ptr<InferRequestStates> m_infer_request_states = std::make_shared<InferRequestStates>();
+    std::mutex m_special_tokens_flags_mutex;
+
+    // LRU cache of single prompt tokenization results keyed by add_special_tokens flag and the prompt,
+    // the most recently used result is at the front.
+    size_t m_cache_size = 0;
+    std::list<std::pair<std::string, TokenizedInputs>> m_cache;
+    std::unordered_map<std::string, std::list<std::pair<std::string, TokenizedInputs>>::iterator> m_cache_index;
+    TokenizationCacheMetrics m_cache_metrics;
+    float m_cache_misses_duration_ms = 0.0f;
+    mutable std::mutex m_cache_mutex;
+
+    // Returns add_special_tokens and skip_special_tokens requested by params, the values which are not set
+    // default to the last used ones. The returned values become the defaults for the next calls.
+    std::pair<bool, bool> update_special_tokens_flags(const ov::AnyMap& params) {
+        std::lock_guard<std::mutex> flags_lock(m_special_tokens_flags_mutex);
         bool add_special_tokens_flag = m_add_special_tokens;
         bool skip_special_tokens_flag = m_skip_special_tokens;
         ov::genai::utils::read_anymap_param(params, add_special_tokens.name(), add_special_tokens_flag);
         ov::genai::utils::read_anymap_param(params, skip_special_tokens.name(), skip_special_tokens_flag);
-
-        // If user requested add_special_tokens mode different from the current one,
-        // need to set state variable.
-        // If requested mode matches the stored state set, then don't touch states.
-        if (add_special_tokens_flag == m_add_special_tokens && skip_special_tokens_flag == m_skip_special_tokens) {
-            return;
+        if (!m_older_than_24_5) {
+            m_add_special_tokens = add_special_tokens_flag;
+            m_skip_special_tokens = skip_special_tokens_flag;
         }
+        return {add_special_tokens_flag, skip_special_tokens_flag};
+    }
+
+    void set_state_if_necessary(CircularBufferQueueElementGuard<ov::InferRequest>& infer_request_guard, const ov::AnyMap& params) {
+        auto [add_special_tokens_flag, skip_special_tokens_flag] = update_special_tokens_flags(params);
         if (m_older_than_24_5) {
             // Changing add_special_tokens at runtime was introduced in
             // 24.5. Older tokenizers still allow manipulating their
             // state but the effect is incorrect.
             return;
         }
+
+        // If user requested add_special_tokens mode different from the one set to this infer request,
+        // need to set state variable.
+        // If requested mode matches the stored state set, then don't touch states.
+        std::unique_lock<std::mutex> lock(m_infer_request_states->mutex);
+        auto& request_state = m_infer_request_states->states.try_emplace(&infer_request_guard.get(), true, true).first->second;
+        if (request_state == std::make_pair(add_special_tokens_flag, skip_special_tokens_flag)) {
+            return;
+        }
+        request_state = {add_special_tokens_flag, skip_special_tokens_flag};
+        // The infer request is owned by the caller, so its state is set without holding the lock
+        lock.unlock();
         
         // add_special_tokens is managed by Select op with a bool input.
         ov::Tensor add_special_tensor = ov::Tensor(ov::element::boolean, {});
@@ -129,22 +197,27 @@ public:
                 state.set_state(skip_special_tensor);
             }
         }
-        m_add_special_tokens = add_special_tokens_flag;
-        m_skip_special_tokens = skip_special_tokens_flag;
     }
 
     TokenizerImpl() = default;
 
-    TokenizerImpl(std::filesystem::path tokenizer_path, const ov::AnyMap& properties)
-        : m_chat_template{chat_template_from_tokenizer_json_if_exists(tokenizer_path)} {
+    TokenizerImpl(std::filesystem::path tokenizer_path, const ov::AnyMap& tokenizer_properties)
+        : m_chat_template{chat_template_from_tokenizer_json_if_exists(tokenizer_path)},
+          m_default_chat_template{m_chat_template} {
         ov::Core core;
 
+        ov::AnyMap properties = tokenizer_properties;
+        size_t cache_size = 0;
+        ov::genai::utils::read_anymap_param(properties, tokenization_cache_size.name(), cache_size);
+        properties.erase(tokenization_cache_size.name());
+
         OPENVINO_ASSERT(tokenizer_path.extension() != ".xml", "'tokenizer_path' parameter should be a path to a dir not a xml file");
 
         const char* ov_tokenizer_path = getenv(ScopedVar::ENVIRONMENT_VARIABLE_NAME);
         OPENVINO_ASSERT(ov_tokenizer_path, "openvino_tokenizers path is not set");
         core.add_extension(ov_tokenizer_path);
 
+        m_compiled_chat_template = compile_chat_template(m_chat_template);
         read_config(tokenizer_path);
         read_special_tokens_map(tokenizer_path);
 
@@ -168,32 +241,69 @@ public:
             ov::pass::Manager manager_detok;
             manager_detok.register_pass<MakeVocabDecoderSatateful>();
             manager_detok.run_passes(ov_detokenizer);
+            for (const auto& variable : ov_detokenizer->get_variables()) {
+                if (variable->get_info().variable_id == SKIP_SPECIAL_TOKENS_VAR_ID)
+                    m_skip_special_tokens_switchable = !m_older_than_24_5;
+            }
+            m_vocab_table = VocabDecoderTable::from_model(ov_detokenizer);
             m_detokenizer = core.compile_model(ov_detokenizer, device, properties);
         }
 
         const size_t INFER_REQUEST_QUEUE_SIZE = m_tokenizer.get_property(ov::optimal_number_of_infer_requests);
-        m_ireq_queue_tokenizer = std::make_unique<CircularBufferQueue<ov::InferRequest>>(
+        m_infer_request_queue_size = INFER_REQUEST_QUEUE_SIZE;
+        // the queues may outlive this tokenizer, so they keep their own references to the compiled models
+        m_ireq_queue_tokenizer = std::make_shared<CircularBufferQueue<ov::InferRequest>>(
             INFER_REQUEST_QUEUE_SIZE,
-            [this]() -> ov::InferRequest {
-                return std::move(this->m_tokenizer.create_infer_request());
+            [compiled_model = m_tokenizer]() mutable -> ov::InferRequest {
+                return compiled_model.create_infer_request();
             });
         if (m_detokenizer) {
-            m_ireq_queue_detokenizer = std::make_unique<CircularBufferQueue<ov::InferRequest>>(
+            m_ireq_queue_detokenizer = std::make_shared<CircularBufferQueue<ov::InferRequest>>(
                 INFER_REQUEST_QUEUE_SIZE,
-                [this]() -> ov::InferRequest {
-                    return std::move(this->m_detokenizer.create_infer_request());
+                [compiled_model = m_detokenizer]() mutable -> ov::InferRequest {
+                    return compiled_model.create_infer_request();
                 });
         }
 
         // Get special token ids by inference if they are not defined.
         infer_special_tokens_if_necessary();
+        // the validation runs the detokenizer, so it doesn't need a separate warmup
+        const bool is_detokenizer_warmed_up = m_vocab_table && m_vocab_table->get_vocab_size() > 0;
+        validate_vocab_table_if_necessary();
         // Initialize tokenizer's cache to save time later.
         // infer_special_tokens_if_necessary() already could do that
         // but it didn't run decode() for sure.
         // TODO CVS-150630: Empty strings sporadically can fail, therefore use nonempty string for warmup.
         auto tokenized_input = encode("non empty string").input_ids;
-        if (m_detokenizer)
+        if (m_detokenizer && !is_detokenizer_warmed_up)
             decode(tokenized_input);
+        // The cache is enabled after the warmup to count user prompts only
+        m_cache_size = cache_size;
+    }
+
+    // Reuses compiled models and infer requests of a tokenizer loaded with the same path and properties,
+    // while the chat template, special tokens flags and the cache are independent.
+    explicit TokenizerImpl(const TokenizerImpl& loaded)
+        : m_tokenizer{loaded.m_tokenizer},
+          m_detokenizer{loaded.m_detokenizer},
+          m_ireq_queue_tokenizer{loaded.m_ireq_queue_tokenizer},
+          m_ireq_queue_detokenizer{loaded.m_ireq_queue_detokenizer},
+          m_older_than_24_5{loaded.m_older_than_24_5},
+          m_pad_token_id{loaded.m_pad_token_id},
+          m_bos_token_id{loaded.m_bos_token_id},
+          m_eos_token_id{loaded.m_eos_token_id},
+          m_pad_token{loaded.m_pad_token},
+          m_bos_token{loaded.m_bos_token},
+          m_eos_token{loaded.m_eos_token},
+          m_chat_template{loaded.m_default_chat_template},
+          m_default_chat_template{loaded.m_default_chat_template},
+          m_vocab_table{loaded.m_vocab_table},
+          m_skip_special_tokens_switchable{loaded.m_skip_special_tokens_switchable},
+          m_infer_request_queue_size{loaded.m_infer_request_queue_size},
+          m_infer_request_states{loaded.m_infer_request_states},
+          m_cache_size{loaded.m_cache_size} {
+        // compiled templates aren't shared, as rendering of the same template from multiple threads isn't safe
+        m_compiled_chat_template = compile_chat_template(m_chat_template);
     }
 
     // load special tokens ids from config.json
@@ -321,7 +431,106 @@ public:
         get_id_from_str(m_eos_token, m_eos_token_id);
     }
 
+    // Decodes a strided sample of the vocab with both the table and the detokenizer model
+    // and drops the table on any mismatch, so that decode() results don't depend on the path taken.
+    void validate_vocab_table_if_necessary() {
+        if (!m_vocab_table)
+            return;
+        const size_t vocab_size = m_vocab_table->get_vocab_size();
+        if (vocab_size == 0) {
+            m_vocab_table = nullptr;
+            return;
+        }
+
+        constexpr size_t num_samples = 64, sample_len = 8, stride = 7919;
+        ov::Tensor tokens{ov::element::i64, {num_samples, sample_len}};
+        int64_t* tokens_data = tokens.data<int64_t>();
+        for (size_t i = 0; i < tokens.get_size(); ++i)
+            tokens_data[i] = static_cast<int64_t>((i * stride) % vocab_size);
+        // make sure special tokens are covered as well
+        tokens_data[0] = m_bos_token_id >= 0 ? m_bos_token_id : tokens_data[0];
+        tokens_data[sample_len - 1] = m_eos_token_id >= 0 ? m_eos_token_id : tokens_data[sample_len - 1];
+
+        CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_detokenizer.get());
+        infer_request_guard.get().set_input_tensor(tokens);
+        infer_request_guard.get().start_async();
+        infer_request_guard.get().wait();
+        const std::string* expected = infer_request_guard.get().get_output_tensor().data<std::string>();
+
+        std::string actual;
+        for (size_t sample = 0; sample < num_samples; ++sample) {
+            bool decoded = m_vocab_table->decode(tokens_data + sample * sample_len, sample_len,
+                                                 m_skip_special_tokens || !m_skip_special_tokens_switchable, actual);
+            if (decoded && actual != expected[sample]) {
+                m_vocab_table = nullptr;
+                return;
+            }
+        }
+    }
+
+    // Returns false if the tokens have to be decoded by the detokenizer model.
+    bool decode_with_vocab_table(const int64_t* tokens, size_t size, bool skip_special_tokens_flag, std::string& result) const {
+        return m_vocab_table->decode(tokens, size, skip_special_tokens_flag || !m_skip_special_tokens_switchable, result);
+    }
+
+    std::vector<std::string> get_decoded_vocab(bool at_text_start) const {
+        OPENVINO_ASSERT(m_vocab_table, "Token bytes cannot be read from the detokenizer model. "
+                        "The detokenizer must be a VocabDecoder followed by CharsToBytes, ByteFallback or RegexNormalization ops.");
+        std::vector<std::string> vocab(m_vocab_table->get_vocab_size());
+        for (size_t token_id = 0; token_id < vocab.size(); ++token_id) {
+            // tokens which cannot be represented are left empty
+            if (!m_vocab_table->get_token_bytes(token_id, at_text_start, vocab[token_id]))
+                vocab[token_id].clear();
+        }
+        return vocab;
+    }
+
     TokenizedInputs encode(std::string prompt, const ov::AnyMap& tokenization_params = {}) {
+        if (m_cache_size == 0)
+            return infer_encode(std::move(prompt), tokenization_params);
+
+        // add_special_tokens defaults to the last used value, so the key has the effective one,
+        // which is remembered for the next calls on a cache hit as well
+        const bool add_special_tokens_flag = update_special_tokens_flags(tokenization_params).first;
+        std::string key = (add_special_tokens_flag ? '1' : '0') + prompt;
+        {
+            std::lock_guard<std::mutex> lock(m_cache_mutex);
+            auto cached = m_cache_index.find(key);
+            if (cached != m_cache_index.end()) {
+                m_cache.splice(m_cache.begin(), m_cache, cached->second);
+                ++m_cache_metrics.hits;
+                m_cache_metrics.time_saved_ms = m_cache_metrics.hits * m_cache_misses_duration_ms / m_cache_metrics.misses;
+                // callers own returned tensors and are allowed to modify them
+                return get_copied_results(cached->second->second.input_ids, cached->second->second.attention_mask);
+            }
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+        TokenizedInputs result = infer_encode(std::move(prompt), tokenization_params);
+        const float duration_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        ++m_cache_metrics.misses;
+        m_cache_misses_duration_ms += duration_ms;
+        m_cache_metrics.time_saved_ms = m_cache_metrics.hits * m_cache_misses_duration_ms / m_cache_metrics.misses;
+        if (m_cache_index.count(key) == 0) {
+            // the same prompt may be tokenized by another thread meanwhile
+            m_cache.emplace_front(key, get_copied_results(result.input_ids, result.attention_mask));
+            m_cache_index.emplace(std::move(key), m_cache.begin());
+            if (m_cache.size() > m_cache_size) {
+                m_cache_index.erase(m_cache.back().first);
+                m_cache.pop_back();
+            }
+        }
+        return result;
+    }
+
+    TokenizationCacheMetrics get_cache_metrics() const {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        return m_cache_metrics;
+    }
+
+    TokenizedInputs infer_encode(std::string prompt, const ov::AnyMap& tokenization_params) {
         CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_tokenizer.get());
         set_state_if_necessary(infer_request_guard, tokenization_params);
         size_t batch_size = 1;
@@ -352,6 +561,67 @@ public:
         return pad_left(unpadded.input_ids, unpadded.attention_mask);
     }
 
+    BulkTokenizedInputs encode_bulk(const std::vector<std::string>& prompts, size_t batch_size, const ov::AnyMap& tokenization_params) {
+        OPENVINO_ASSERT(batch_size > 0, "batch_size of bulk encoding should be greater than 0");
+        const auto start_time = std::chrono::steady_clock::now();
+
+        // Text length is a cheap estimation of the number of tokens, so batches of texts with similar length have little padding
+        std::vector<size_t> order(prompts.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&prompts](size_t a, size_t b) {
+            return prompts[a].size() > prompts[b].size();
+        });
+
+        BulkTokenizedInputs result;
+        result.input_ids.resize(prompts.size());
+        const size_t num_batches = (prompts.size() + batch_size - 1) / batch_size;
+        std::atomic<size_t> next_batch{0};
+        auto encode_batches = [&]() {
+            std::vector<std::string> batch;
+            for (size_t batch_idx = next_batch++; batch_idx < num_batches; batch_idx = next_batch++) {
+                const size_t begin = batch_idx * batch_size, end = std::min(begin + batch_size, prompts.size());
+                batch.clear();
+                for (size_t i = begin; i < end; ++i)
+                    batch.push_back(prompts[order[i]]);
+
+                CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_tokenizer.get());
+                set_state_if_necessary(infer_request_guard, tokenization_params);
+                infer_request_guard.get().set_input_tensor(ov::Tensor{ov::element::string, {batch.size()}, batch.data()});
+                infer_request_guard.get().start_async();
+                infer_request_guard.get().wait();
+
+                // Padding is dropped by the attention mask, so its side doesn't matter
+                const ov::Tensor input_ids = infer_request_guard.get().get_tensor("input_ids");
+                const ov::Tensor attention_mask = infer_request_guard.get().get_tensor("attention_mask");
+                const size_t sequence_length = input_ids.get_shape()[1];
+                const int64_t* input_ids_data = input_ids.data<int64_t>();
+                const int64_t* attention_mask_data = attention_mask.data<int64_t>();
+                for (size_t row = 0; row < batch.size(); ++row) {
+                    auto& ids = result.input_ids[order[begin + row]];
+                    for (size_t i = row * sequence_length; i < (row + 1) * sequence_length; ++i) {
+                        if (attention_mask_data[i] != 0)
+                            ids.push_back(input_ids_data[i]);
+                    }
+                }
+            }
+        };
+
+        // Each worker takes an infer request from the queue for every batch, so there is no more workers than requests
+        const size_t num_workers = std::min(num_batches, m_infer_request_queue_size);
+        std::vector<std::future<void>> workers;
+        workers.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i)
+            workers.push_back(std::async(std::launch::async, encode_batches));
+        for (auto& worker : workers)
+            worker.get();
+
+        for (const auto& ids : result.input_ids)
+            result.num_tokens += ids.size();
+        const float duration_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+        result.tokens_per_second = duration_s > 0.0f ? result.num_tokens / duration_s : 0.0f;
+        return result;
+    }
+
     TokenizedInputs get_copied_results(ov::Tensor input_ids, ov::Tensor attention_mask) {
         ov::Tensor input_ids_ = ov::Tensor(input_ids.get_element_type(), input_ids.get_shape());
         ov::Tensor attention_mask_ = ov::Tensor(attention_mask.get_element_type(), attention_mask.get_shape());
@@ -364,6 +634,14 @@ public:
     std::string decode(std::vector<int64_t> tokens, const ov::AnyMap& detokenization_params = {}) {
         OPENVINO_ASSERT(m_detokenizer, "Detokenize model has not been provided. Tokenizer::decode is not available");
 
+        if (m_vocab_table) {
+            // skip_special_tokens is remembered for the next calls as on the detokenizer model path
+            const bool skip_special_tokens_flag = update_special_tokens_flags(detokenization_params).second;
+            std::string result;
+            if (decode_with_vocab_table(tokens.data(), tokens.size(), skip_special_tokens_flag, result))
+                return result;
+        }
+
         CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_detokenizer.get());
         set_state_if_necessary(infer_request_guard, detokenization_params);
         size_t batch_size = 1;
@@ -378,6 +656,18 @@ public:
         OPENVINO_ASSERT(tokens.get_element_type() == ov::element::i64, "tokens tensor element type should be an i64");
         OPENVINO_ASSERT(tokens.get_shape().size() == 2, "tokens tensor should of rank 2 with shape [batch_size, seq_len]");
 
+        if (m_vocab_table) {
+            const bool skip_special_tokens_flag = update_special_tokens_flags(detokenization_params).second;
+            const size_t batch_size = tokens.get_shape()[0], seq_len = tokens.get_shape()[1];
+            const int64_t* tokens_data = tokens.data<int64_t>();
+            std::vector<std::string> results(batch_size);
+            size_t decoded = 0;
+            while (decoded < batch_size && decode_with_vocab_table(tokens_data + decoded * seq_len, seq_len, skip_special_tokens_flag, results[decoded]))
+                ++decoded;
+            if (decoded == batch_size)
+                return results;
+        }
+
         CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(this->m_ireq_queue_detokenizer.get());
         set_state_if_necessary(infer_request_guard, detokenization_params);
         infer_request_guard.get().set_input_tensor(tokens);
@@ -392,6 +682,16 @@ public:
     std::vector<std::string> decode(std::vector<std::vector<int64_t>> lines, const ov::AnyMap& detokenization_params = {}) {
         OPENVINO_ASSERT(m_detokenizer, "Detokenize model has not been provided. Tokenizer::decode is not available");
 
+        if (m_vocab_table) {
+            const bool skip_special_tokens_flag = update_special_tokens_flags(detokenization_params).second;
+            std::vector<std::string> results(lines.size());
+            size_t decoded = 0;
+            while (decoded < lines.size() && decode_with_vocab_table(lines[decoded].data(), lines[decoded].size(), skip_special_tokens_flag, results[decoded]))
+                ++decoded;
+            if (decoded == lines.size())
+                return results;
+        }
+
         auto compare_lengths = [](const std::vector<int64_t>& a, const std::vector<int64_t>& b) {
             return a.size() < b.size();
         };
@@ -457,21 +757,35 @@ public:
         return patch_chat_template(res);
     }
 
+    static std::shared_ptr<CompiledChatTemplate> compile_chat_template(const std::string& chat_template) {
+        if (chat_template.empty())
+            return nullptr;
+        auto compiled = std::make_shared<CompiledChatTemplate>();
+        compiled->env.GetSettings().lstripBlocks = true;
+        compiled->env.GetSettings().trimBlocks = true;
+        if (!compiled->tpl.Load(chat_template).has_value())
+            return nullptr;
+        return compiled;
+    }
+
     std::string apply_chat_template(ChatHistory history,
                                     bool add_generation_prompt,
                                     const std::string& chat_template) const {
-        std::string chat_tpl = chat_template.empty() ? m_chat_template : patch_chat_template(chat_template);
-        OPENVINO_ASSERT(!chat_tpl.empty(),
+        std::lock_guard<std::mutex> lock(m_chat_template_mutex);
+        OPENVINO_ASSERT(!chat_template.empty() || !m_chat_template.empty(),
                         "Chat template wasn't found. This may indicate that the model wasn't trained for chat scenario."
                         " Please add 'chat_template' to tokenizer_config.json to use the model in chat scenario."
                         " For more information see the section Troubleshooting in README.md");
-        jinja2::TemplateEnv env;
-        env.GetSettings().lstripBlocks = true;
-        env.GetSettings().trimBlocks = true;
-        jinja2::Template tpl(&env);
-        tpl.Load(chat_tpl);
-        
-        jinja2::UserCallable slice_callable = jinja2::MakeCallable(
+        std::shared_ptr<CompiledChatTemplate> compiled = m_compiled_chat_template;
+        if (!chat_template.empty()) {
+            if (chat_template != m_custom_chat_template) {
+                m_custom_chat_template = chat_template;
+                m_compiled_custom_chat_template = compile_chat_template(patch_chat_template(chat_template));
+            }
+            compiled = m_compiled_custom_chat_template;
+        }
+
+        static const jinja2::UserCallable slice_callable = jinja2::MakeCallable(
             [](const jinja2::GenericList& messages, const size_t& start) {
                 jinja2::ValuesList result;
 
@@ -504,7 +818,8 @@ public:
         };
 
         try {
-            return tpl.RenderAsString(params).value();
+            OPENVINO_ASSERT(compiled, "Failed to parse the chat template");
+            return compiled->tpl.RenderAsString(params).value();
         } catch (const std::exception& error) {
             OPENVINO_THROW("Chat template for the current model is not supported by Jinja2Cpp. "
                            "Please apply template manually to your prompt before calling generate. "
@@ -513,13 +828,62 @@ public:
     }
 
     void set_chat_template(const std::string& chat_template) {
+        std::lock_guard<std::mutex> lock(m_chat_template_mutex);
         m_chat_template = patch_chat_template(chat_template);
+        m_compiled_chat_template = compile_chat_template(m_chat_template);
     }
 };
 
+namespace {
+
+// Returns a key identifying the loaded tokenizer or an empty string if the properties can't be printed
+std::string get_tokenizer_key(const std::filesystem::path& tokenizer_path, const ov::AnyMap& properties) {
+    std::error_code error;
+    std::filesystem::path canonical_path = std::filesystem::weakly_canonical(tokenizer_path, error);
+    std::stringstream key;
+    key << (error ? tokenizer_path : canonical_path).string();
+    try {
+        // ov::AnyMap is ordered, so equal properties give equal keys
+        for (const auto& [name, value] : properties) {
+            key << '\n' << name << '=' << value.as<std::string>();
+        }
+    } catch (const std::exception&) {
+        return {};
+    }
+    return key.str();
+}
+
+}  // namespace
+
 Tokenizer::Tokenizer(const std::filesystem::path& tokenizer_path, const ov::AnyMap& properties) {
+    // Models of tokenizers which are still alive are reused, so pipelines loaded from the same directory
+    // don't read and compile the same tokenizer models again.
+    static std::mutex loaded_tokenizers_mutex;
+    static std::map<std::string, std::weak_ptr<TokenizerImpl>> loaded_tokenizers;
+
+    const std::string key = get_tokenizer_key(tokenizer_path, properties);
+    if (!key.empty()) {
+        std::lock_guard<std::mutex> lock(loaded_tokenizers_mutex);
+        auto loaded = loaded_tokenizers.find(key);
+        if (loaded != loaded_tokenizers.end()) {
+            if (auto loaded_impl = loaded->second.lock()) {
+                m_pimpl = std::make_shared<TokenizerImpl>(*loaded_impl);
+                return;
+            }
+        }
+    }
+
     ScopedVar env_manager(tokenizers_relative_to_genai().string());
     m_pimpl = std::make_shared<TokenizerImpl>(tokenizer_path, properties);
+
+    if (!key.empty()) {
+        std::lock_guard<std::mutex> lock(loaded_tokenizers_mutex);
+        // drop entries of destroyed tokenizers
+        for (auto it = loaded_tokenizers.begin(); it != loaded_tokenizers.end();) {
+            it = it->second.expired() ? loaded_tokenizers.erase(it) : std::next(it);
+        }
+        loaded_tokenizers[key] = m_pimpl;
+    }
 }
 
 TokenizedInputs Tokenizer::encode(const std::string prompt, const ov::AnyMap& tokenization_params) {
@@ -542,6 +906,11 @@ TokenizedInputs Tokenizer::encode(std::initializer_list<std::string>& text, cons
     return encode(std::vector<std::string>(text.begin(), text.end()), tokenization_params);
 }
 
+BulkTokenizedInputs Tokenizer::encode_bulk(const std::vector<std::string>& prompts, size_t batch_size, const ov::AnyMap& tokenization_params) {
+    check_arguments(tokenization_params, {ov::genai::add_special_tokens.name()});
+    return m_pimpl->encode_bulk(prompts, batch_size, tokenization_params);
+}
+
 std::string Tokenizer::decode(std::vector<int64_t> tokens, const ov::AnyMap& detokenization_params) {
     check_arguments(detokenization_params, {ov::genai::skip_special_tokens.name()});
     return m_pimpl->decode(tokens, detokenization_params);
@@ -557,6 +926,14 @@ std::vector<std::string> Tokenizer::decode(std::vector<std::vector<int64_t>> lin
     return m_pimpl->decode(lines, detokenization_params);
 }
 
+std::vector<std::string> Tokenizer::get_decoded_vocab(bool at_text_start) const {
+    return m_pimpl->get_decoded_vocab(at_text_start);
+}
+
+TokenizationCacheMetrics Tokenizer::get_cache_metrics() const {
+    return m_pimpl->get_cache_metrics();
+}
+
 int64_t Tokenizer::get_bos_token_id() const {
     return m_pimpl->m_bos_token_id;
 }
@@ -219,6 +219,25 @@ std::pair<ov::AnyMap, ov::AnyMap> split_core_compile_config(const ov::AnyMap& pr
     return {core_properties, compile_properties};
 };
 
+ov::AnyMap get_tokenizer_properties(const ov::AnyMap& properties) {
+    ov::AnyMap tokenizer_properties;
+    auto cache_dir = properties.find(ov::cache_dir.name());
+    if (cache_dir != properties.end()) {
+        tokenizer_properties[ov::cache_dir.name()] = cache_dir->second;
+    }
+    auto cache_size = properties.find(ov::genai::tokenization_cache_size.name());
+    if (cache_size != properties.end()) {
+        tokenizer_properties[ov::genai::tokenization_cache_size.name()] = cache_size->second;
+    }
+    return tokenizer_properties;
+}
+
+ov::AnyMap remove_tokenizer_only_properties(const ov::AnyMap& properties) {
+    ov::AnyMap model_properties = properties;
+    model_properties.erase(ov::genai::tokenization_cache_size.name());
+    return model_properties;
+}
+
 ov::genai::TokenizedInputs subtract_chat_tokenized_inputs(const ov::genai::TokenizedInputs& minuend, const ov::genai::TokenizedInputs& subtrahend) {
     auto minuend_size = minuend.input_ids.get_size();
     auto subtrahend_size = subtrahend.input_ids.get_size();
@@ -234,6 +253,22 @@ ov::genai::TokenizedInputs subtract_chat_tokenized_inputs(const ov::genai::Token
     return {new_input_ids, new_attention_mask};
 }
 
+ov::genai::TokenizedInputs concatenate_chat_tokenized_inputs(const ov::genai::TokenizedInputs& prefix, const std::vector<int64_t>& tokens) {
+    auto prefix_size = prefix.input_ids ? prefix.input_ids.get_size() : 0;
+    ov::Shape new_shape{1, prefix_size + tokens.size()};
+
+    ov::Tensor new_input_ids(ov::element::i64, new_shape);
+    if (prefix_size > 0) {
+        std::copy_n(prefix.input_ids.data<int64_t>(), prefix_size, new_input_ids.data<int64_t>());
+    }
+    std::copy(tokens.begin(), tokens.end(), new_input_ids.data<int64_t>() + prefix_size);
+
+    ov::Tensor new_attention_mask(ov::element::i64, new_shape);
+    std::fill_n(new_attention_mask.data<int64_t>(), new_shape[1], 1);
+
+    return {new_input_ids, new_attention_mask};
+}
+
 void slice_matmul_statefull_model(std::shared_ptr<ov::Model> model) {
     auto last_node = model->output(0).get_node()->input_value(0).get_node();
     ov::Node* matmul = dynamic_cast<ov::op::v0::MatMul*>(last_node);
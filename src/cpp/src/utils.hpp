@@ -80,8 +80,16 @@ ProcessorConfig from_any_map(
 
 std::pair<ov::AnyMap, ov::AnyMap> split_core_compile_config(const ov::AnyMap& properties);
 
+// Returns the properties of a pipeline which apply to its tokenizer, e.g. ov::cache_dir or ov::genai::tokenization_cache_size
+ov::AnyMap get_tokenizer_properties(const ov::AnyMap& properties);
+
+// Returns the properties of a pipeline without those which apply to its tokenizer only, e.g. ov::genai::tokenization_cache_size
+ov::AnyMap remove_tokenizer_only_properties(const ov::AnyMap& properties);
+
 ov::genai::TokenizedInputs subtract_chat_tokenized_inputs(const ov::genai::TokenizedInputs& minuend, const ov::genai::TokenizedInputs& subtrahend);
 
+ov::genai::TokenizedInputs concatenate_chat_tokenized_inputs(const ov::genai::TokenizedInputs& prefix, const std::vector<int64_t>& tokens);
+
 void slice_matmul_statefull_model(std::shared_ptr<ov::Model> model);
 
 ov::Core singleton_core();
@@ -0,0 +1,313 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cstring>
+#include <optional>
+#include <set>
+
+#include "openvino/op/constant.hpp"
+#include "vocab_decoder_table.hpp"
+
+namespace {
+
+constexpr char SPACE_MARKER[] = "\xe2\x96\x81";  // "▁"
+constexpr size_t SPACE_MARKER_LEN = sizeof(SPACE_MARKER) - 1;
+
+// Inverse of GPT-2 bytes_to_unicode(): printable bytes map onto themselves,
+// the remaining 68 bytes are shifted to code points starting from 256.
+const std::array<int16_t, 256 + 68>& unicode_to_bytes() {
+    static const std::array<int16_t, 256 + 68> table = [] {
+        std::array<int16_t, 256 + 68> res;
+        res.fill(-1);
+        size_t shifted = 0;
+        for (int16_t byte = 0; byte < 256; ++byte) {
+            bool printable = (byte >= 33 && byte <= 126) || (byte >= 161 && byte <= 172) || (byte >= 174);
+            res[printable ? byte : 256 + shifted++] = byte;
+        }
+        return res;
+    }();
+    return table;
+}
+
+// Returns the code point starting at pos and advances pos, std::nullopt for malformed UTF-8.
+std::optional<uint32_t> next_code_point(const std::string& str, size_t& pos) {
+    const auto lead = static_cast<uint8_t>(str[pos]);
+    size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || pos + length > str.size())
+        return std::nullopt;
+
+    uint32_t code_point = length == 1 ? lead : lead & (0xFF >> (length + 1));
+    for (size_t i = 1; i < length; ++i) {
+        const auto cont = static_cast<uint8_t>(str[pos + i]);
+        if ((cont >> 6) != 0x2)
+            return std::nullopt;
+        code_point = (code_point << 6) | (cont & 0x3F);
+    }
+    pos += length;
+    return code_point;
+}
+
+bool is_valid_utf8(const std::string& str) {
+    for (size_t pos = 0; pos < str.size();) {
+        const size_t start = pos;
+        auto code_point = next_code_point(str, pos);
+        if (!code_point.has_value())
+            return false;
+        // reject overlong encodings, surrogates and out of range values
+        const size_t length = pos - start;
+        if ((length == 2 && *code_point < 0x80) || (length == 3 && *code_point < 0x800) ||
+            (length == 4 && *code_point < 0x10000) || *code_point > 0x10FFFF ||
+            (*code_point >= 0xD800 && *code_point <= 0xDFFF))
+            return false;
+    }
+    return true;
+}
+
+std::optional<std::string> chars_to_bytes(const std::string& token) {
+    const auto& table = unicode_to_bytes();
+    std::string res;
+    res.reserve(token.size());
+    for (size_t pos = 0; pos < token.size();) {
+        auto code_point = next_code_point(token, pos);
+        if (!code_point.has_value() || *code_point >= table.size() || table[*code_point] < 0)
+            return std::nullopt;
+        res.push_back(static_cast<char>(table[*code_point]));
+    }
+    return res;
+}
+
+std::string byte_fallback(const std::string& token) {
+    // exactly "<0xAB>"
+    if (token.size() != 6 || token.compare(0, 3, "<0x") != 0 || token.back() != '>')
+        return token;
+    auto hex_digit = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    };
+    int high = hex_digit(token[3]), low = hex_digit(token[4]);
+    if (high < 0 || low < 0)
+        return token;
+    return std::string(1, static_cast<char>(high * 16 + low));
+}
+
+std::shared_ptr<ov::op::v0::Constant> as_constant(const std::shared_ptr<ov::Node>& node) {
+    return std::dynamic_pointer_cast<ov::op::v0::Constant>(node);
+}
+
+// Reads a string constant stored either as ov::element::string or as raw u8 bytes.
+std::optional<std::string> read_string_constant(const std::shared_ptr<ov::Node>& node) {
+    auto constant = as_constant(node);
+    if (!constant)
+        return std::nullopt;
+    if (constant->get_element_type() == ov::element::string) {
+        if (ov::shape_size(constant->get_shape()) != 1)
+            return std::nullopt;
+        return constant->get_data_ptr<std::string>()[0];
+    }
+    if (constant->get_element_type() == ov::element::u8) {
+        auto data = constant->get_data_ptr<char>();
+        return std::string(data, data + ov::shape_size(constant->get_shape()));
+    }
+    return std::nullopt;
+}
+
+// VocabDecoder inputs 1-3 are (begins, ends, chars) either as constants or unpacked from a string constant.
+std::optional<std::vector<std::string>> read_vocab(const std::shared_ptr<ov::Node>& vocab_decoder) {
+    auto begins_node = vocab_decoder->get_input_node_shared_ptr(1);
+    if (std::strcmp(begins_node->get_type_info().name, "StringTensorUnpack") == 0) {
+        auto packed = as_constant(begins_node->get_input_node_shared_ptr(0));
+        if (!packed || packed->get_element_type() != ov::element::string)
+            return std::nullopt;
+        auto data = packed->get_data_ptr<std::string>();
+        return std::vector<std::string>(data, data + ov::shape_size(packed->get_shape()));
+    }
+
+    auto begins = as_constant(begins_node);
+    auto ends = as_constant(vocab_decoder->get_input_node_shared_ptr(2));
+    auto chars = as_constant(vocab_decoder->get_input_node_shared_ptr(3));
+    if (!begins || !ends || !chars || chars->get_element_type() != ov::element::u8)
+        return std::nullopt;
+
+    auto begins_data = begins->cast_vector<int64_t>();
+    auto ends_data = ends->cast_vector<int64_t>();
+    auto chars_data = chars->get_data_ptr<char>();
+    const auto chars_size = static_cast<int64_t>(ov::shape_size(chars->get_shape()));
+    if (begins_data.size() != ends_data.size())
+        return std::nullopt;
+
+    std::vector<std::string> vocab;
+    vocab.reserve(begins_data.size());
+    for (size_t i = 0; i < begins_data.size(); ++i) {
+        if (begins_data[i] < 0 || begins_data[i] > ends_data[i] || ends_data[i] > chars_size)
+            return std::nullopt;
+        vocab.emplace_back(chars_data + begins_data[i], chars_data + ends_data[i]);
+    }
+    return vocab;
+}
+
+// Skip tokens are a constant, possibly sliced by MakeVocabDecoderSatateful.
+std::optional<std::vector<int64_t>> read_skip_tokens(const std::shared_ptr<ov::Node>& vocab_decoder) {
+    if (vocab_decoder->get_input_size() < 5)
+        return std::vector<int64_t>{};
+    auto node = vocab_decoder->get_input_node_shared_ptr(4);
+    if (std::strcmp(node->get_type_info().name, "Slice") == 0)
+        node = node->get_input_node_shared_ptr(0);
+    auto constant = as_constant(node);
+    if (!constant || !constant->get_element_type().is_integral_number())
+        return std::nullopt;
+    return constant->cast_vector<int64_t>();
+}
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+VocabDecoderTable::VocabDecoderTable(const std::vector<std::string>& vocab,
+                                     const std::vector<int64_t>& skip_token_ids,
+                                     const std::vector<TokenOp>& token_ops,
+                                     const std::vector<StringOp>& string_ops)
+    : m_offsets{0}, m_is_skip_token(vocab.size(), 0), m_is_unsupported(vocab.size(), 0), m_string_ops{string_ops} {
+    m_offsets.reserve(vocab.size() + 1);
+    for (size_t token_id = 0; token_id < vocab.size(); ++token_id) {
+        std::string token = vocab[token_id];
+        for (TokenOp op : token_ops) {
+            if (op == TokenOp::BYTE_FALLBACK) {
+                token = byte_fallback(token);
+            } else if (auto bytes = chars_to_bytes(token)) {
+                token = std::move(*bytes);
+            } else {
+                m_is_unsupported[token_id] = 1;
+                token.clear();
+                break;
+            }
+        }
+        m_bytes += token;
+        m_offsets.push_back(m_bytes.size());
+    }
+
+    for (int64_t token_id : skip_token_ids) {
+        if (token_id >= 0 && static_cast<size_t>(token_id) < vocab.size())
+            m_is_skip_token[token_id] = 1;
+    }
+}
+
+std::shared_ptr<VocabDecoderTable> VocabDecoderTable::from_model(const std::shared_ptr<ov::Model>& detokenizer) {
+    // Ops which don't change the decoded text or are consumed while reading the vocab and skip tokens.
+    const std::set<std::string> transparent_ops = {
+        "Parameter", "Result", "Constant", "Convert", "Slice", "Multiply", "ReadValue", "Assign",
+        "StringTensorUnpack", "FuzeRagged", "StringTensorPack"
+    };
+
+    std::shared_ptr<ov::Node> vocab_decoder;
+    std::vector<TokenOp> token_ops;
+    std::vector<StringOp> string_ops;
+    for (const auto& node : detokenizer->get_ordered_ops()) {
+        const std::string type_name = node->get_type_info().name;
+        if (type_name == "VocabDecoder") {
+            if (vocab_decoder)
+                return nullptr;
+            vocab_decoder = node;
+        } else if (type_name == "CharsToBytes") {
+            token_ops.push_back(TokenOp::CHARS_TO_BYTES);
+        } else if (type_name == "ByteFallback") {
+            token_ops.push_back(TokenOp::BYTE_FALLBACK);
+        } else if (type_name == "UTF8Validate") {
+            string_ops.push_back(StringOp::VALIDATE_UTF8);
+        } else if (type_name == "RegexNormalization") {
+            // search and replace patterns are the two last inputs
+            const size_t inputs = node->get_input_size();
+            if (inputs < 2)
+                return nullptr;
+            auto search = read_string_constant(node->get_input_node_shared_ptr(inputs - 2));
+            auto replace = read_string_constant(node->get_input_node_shared_ptr(inputs - 1));
+            if (!search || !replace)
+                return nullptr;
+            if (*search == SPACE_MARKER && *replace == " ") {
+                string_ops.push_back(StringOp::REPLACE_SPACE_MARKER);
+            } else if (*search == "^ " && replace->empty()) {
+                string_ops.push_back(StringOp::STRIP_LEADING_SPACE);
+            } else {
+                return nullptr;
+            }
+        } else if (transparent_ops.count(type_name) == 0) {
+            return nullptr;
+        }
+    }
+    if (!vocab_decoder)
+        return nullptr;
+
+    auto vocab = read_vocab(vocab_decoder);
+    auto skip_tokens = read_skip_tokens(vocab_decoder);
+    if (!vocab || !skip_tokens)
+        return nullptr;
+    return std::make_shared<VocabDecoderTable>(*vocab, *skip_tokens, token_ops, string_ops);
+}
+
+bool VocabDecoderTable::decode(const int64_t* tokens, size_t size, bool skip_special_tokens, std::string& result) const {
+    const size_t vocab_size = get_vocab_size();
+    size_t total_size = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const int64_t token_id = tokens[i];
+        if (token_id < 0 || static_cast<size_t>(token_id) >= vocab_size || m_is_unsupported[token_id])
+            return false;
+        total_size += m_offsets[token_id + 1] - m_offsets[token_id];
+    }
+
+    result.clear();
+    result.reserve(total_size);
+    for (size_t i = 0; i < size; ++i) {
+        const int64_t token_id = tokens[i];
+        if (skip_special_tokens && m_is_skip_token[token_id])
+            continue;
+        result.append(m_bytes, m_offsets[token_id], m_offsets[token_id + 1] - m_offsets[token_id]);
+    }
+
+    for (StringOp op : m_string_ops) {
+        if (op == StringOp::REPLACE_SPACE_MARKER) {
+            size_t write_pos = 0;
+            for (size_t read_pos = 0; read_pos < result.size();) {
+                if (result.compare(read_pos, SPACE_MARKER_LEN, SPACE_MARKER) == 0) {
+                    result[write_pos++] = ' ';
+                    read_pos += SPACE_MARKER_LEN;
+                } else {
+                    result[write_pos++] = result[read_pos++];
+                }
+            }
+            result.resize(write_pos);
+        } else if (op == StringOp::STRIP_LEADING_SPACE) {
+            if (!result.empty() && result.front() == ' ')
+                result.erase(0, 1);
+        } else if (!is_valid_utf8(result)) {
+            // UTF8Validate would replace or drop the invalid bytes, leave it to the model
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VocabDecoderTable::get_token_bytes(int64_t token_id, bool at_text_start, std::string& bytes) const {
+    if (token_id < 0 || static_cast<size_t>(token_id) >= get_vocab_size() || m_is_unsupported[token_id])
+        return false;
+    bytes.clear();
+    if (m_is_skip_token[token_id])
+        return true;
+    bytes.assign(m_bytes, m_offsets[token_id], m_offsets[token_id + 1] - m_offsets[token_id]);
+
+    for (StringOp op : m_string_ops) {
+        if (op == StringOp::REPLACE_SPACE_MARKER) {
+            for (size_t pos = bytes.find(SPACE_MARKER); pos != std::string::npos; pos = bytes.find(SPACE_MARKER, pos + 1))
+                bytes.replace(pos, SPACE_MARKER_LEN, " ");
+        } else if (op == StringOp::STRIP_LEADING_SPACE && at_text_start) {
+            if (!bytes.empty() && bytes.front() == ' ')
+                bytes.erase(0, 1);
+        }
+    }
+    return true;
+}
+
+}  // namespace genai
+}  // namespace ov
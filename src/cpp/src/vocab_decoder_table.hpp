@@ -0,0 +1,80 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "openvino/core/model.hpp"
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Native id-to-bytes table reconstructed from the VocabDecoder subgraph of an openvino_tokenizers detokenizer.
+ *
+ * The detokenizer model is a linear chain: VocabDecoder looks up each id in a constant vocab, token-level ops
+ * (CharsToBytes, ByteFallback) convert the token strings to bytes, FuzeRagged concatenates them and string-level ops
+ * (RegexNormalization, UTF8Validate) post-process the joined text. Token-level ops are folded into the table at load
+ * time, so decoding becomes a lookup plus concatenation followed by a few cheap string-level post-ops.
+ *
+ * Only a known subset of post-ops is supported. decode() reports failure when the result cannot be reproduced
+ * exactly (unknown id, token with chars outside the byte-level alphabet, invalid UTF-8 under UTF8Validate);
+ * callers are expected to fall back to the detokenizer model in this case.
+ */
+class VocabDecoderTable {
+public:
+    enum class TokenOp {
+        CHARS_TO_BYTES,     // GPT-2 byte-level alphabet back to raw bytes
+        BYTE_FALLBACK       // "<0xAB>" tokens to a single raw byte
+    };
+
+    enum class StringOp {
+        REPLACE_SPACE_MARKER,   // SentencePiece "▁" to " "
+        STRIP_LEADING_SPACE,    // "^ " to ""
+        VALIDATE_UTF8           // decode is rejected if the result is not valid UTF-8
+    };
+
+    VocabDecoderTable(const std::vector<std::string>& vocab,
+                      const std::vector<int64_t>& skip_token_ids,
+                      const std::vector<TokenOp>& token_ops,
+                      const std::vector<StringOp>& string_ops);
+
+    /**
+     * @brief Builds a table from a detokenizer model.
+     * @return nullptr if the model contains ops which cannot be reproduced natively.
+     */
+    static std::shared_ptr<VocabDecoderTable> from_model(const std::shared_ptr<ov::Model>& detokenizer);
+
+    /**
+     * @brief Decodes a sequence of ids into the output string.
+     * @return false if the sequence cannot be decoded natively, in that case the result is unspecified.
+     */
+    bool decode(const int64_t* tokens, size_t size, bool skip_special_tokens, std::string& result) const;
+
+    /**
+     * @brief Returns bytes which a token contributes to a decoded text. UTF-8 validation is not applied, as a token may
+     * carry a part of a character. Special tokens which are skipped by the detokenizer have empty bytes.
+     * @param at_text_start whether the token begins the text, e.g. the leading space is stripped in this case
+     * @return false if the token cannot be represented by the table.
+     */
+    bool get_token_bytes(int64_t token_id, bool at_text_start, std::string& bytes) const;
+
+    size_t get_vocab_size() const {
+        return m_offsets.size() - 1;
+    }
+
+private:
+    // All token byte strings are stored contiguously, token i occupies [m_offsets[i], m_offsets[i + 1])
+    std::string m_bytes;
+    std::vector<size_t> m_offsets;
+    std::vector<uint8_t> m_is_skip_token;
+    // Tokens which cannot be represented by the table, e.g. chars outside of the byte-level alphabet
+    std::vector<uint8_t> m_is_unsupported;
+    std::vector<StringOp> m_string_ops;
+};
+
+}  // namespace genai
+}  // namespace ov
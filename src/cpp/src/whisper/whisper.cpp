@@ -283,6 +283,181 @@ void filter_non_segment_metrics(ov::genai::RawPerfMetrics& raw_metrics,
     filter_by_ranges(raw_metrics.m_batch_sizes, offset, ranges);
 }
 
+ov::Tensor encode_batch(ov::InferRequest& request,
+                        const std::vector<std::vector<float>>& mel_data,
+                        const size_t feature_size,
+                        const size_t nb_max_frames,
+                        std::vector<ov::genai::RawPerfMetrics>& raw_metrics) {
+    ov::Tensor input_tensor(ov::element::f32, {mel_data.size(), feature_size, nb_max_frames});
+    float* input_data = input_tensor.data<float>();
+    for (size_t batch = 0; batch < mel_data.size(); ++batch) {
+        OPENVINO_ASSERT(mel_data[batch].size() == feature_size * nb_max_frames,
+                        "Mel spectrogram required size: ",
+                        feature_size,
+                        " * ",
+                        nb_max_frames,
+                        ". Actual size: ",
+                        mel_data[batch].size(),
+                        ".");
+        std::copy(mel_data[batch].begin(), mel_data[batch].end(), input_data + batch * feature_size * nb_max_frames);
+    }
+
+    request.set_tensor("input_features", input_tensor);
+
+    const auto infer_start = std::chrono::steady_clock::now();
+    request.infer();
+    const auto infer_ms = ov::genai::PerfMetrics::get_microsec(std::chrono::steady_clock::now() - infer_start);
+    for (auto& metrics : raw_metrics) {
+        metrics.m_inference_durations[0] += MicroSeconds(infer_ms);
+    }
+
+    // reset input tensor
+    request.set_tensor("input_features", ov::Tensor(ov::element::f32, {0, feature_size, nb_max_frames}));
+
+    return request.get_tensor("last_hidden_state");
+}
+
+// returns init ids of each input, they have the same length, as only the language token can differ
+std::vector<std::vector<int64_t>> prepare_batch_init_ids(ov::Tensor& encoder_hidden_state,
+                                                         ov::InferRequest& decoder,
+                                                         const ov::genai::WhisperGenerationConfig& config,
+                                                         const bool return_timestamps,
+                                                         std::vector<ov::genai::RawPerfMetrics>& raw_metrics) {
+    const size_t batch_size = encoder_hidden_state.get_shape().at(0);
+    std::vector<int64_t> language_token_ids;
+    if (config.is_multilingual && config.language.has_value()) {
+        language_token_ids.assign(batch_size, config.lang_to_id.at(*config.language));
+    } else if (config.is_multilingual) {
+        // the language of each input is detected by a single batched inference
+        std::vector<int64_t> input_ids(batch_size, config.decoder_start_token_id);
+        decoder.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+        decoder.set_tensor("input_ids", ov::Tensor(ov::element::i64, {batch_size, 1}, input_ids.data()));
+
+        const auto infer_start = std::chrono::steady_clock::now();
+        decoder.infer();
+        const auto infer_ms = ov::genai::PerfMetrics::get_microsec(std::chrono::steady_clock::now() - infer_start);
+        for (auto& metrics : raw_metrics) {
+            metrics.m_inference_durations[0] += MicroSeconds(infer_ms);
+        }
+
+        auto output_tensor = decoder.get_tensor("logits");
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            language_token_ids.push_back(ov::genai::utils::argmax(output_tensor, batch));
+        }
+    }
+
+    std::vector<std::vector<int64_t>> init_ids(batch_size);
+    for (size_t batch = 0; batch < batch_size; ++batch) {
+        init_ids[batch] = {config.decoder_start_token_id};
+        if (config.is_multilingual) {
+            const bool is_translation = config.task.has_value() && *config.task == "translate";
+            init_ids[batch].push_back(language_token_ids[batch]);
+            init_ids[batch].push_back(is_translation ? config.translate_token_id : config.transcribe_token_id);
+        }
+        if (!return_timestamps) {
+            init_ids[batch].push_back(config.no_timestamps_token_id);
+        }
+    }
+    return init_ids;
+}
+
+// decodes all inputs of the batch in lock-step: the sequences have the same length, so the past key values
+// of the decoder_with_past model keep the batch layout and the encoder key values are computed once per input
+std::vector<std::vector<int64_t>> full_decode_batch(ov::Tensor& encoder_hidden_state,
+                                                    const ov::genai::WhisperGenerationConfig& config,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    std::vector<std::vector<int64_t>> init_ids,
+                                                    const size_t max_new_tokens,
+                                                    const bool return_timestamps,
+                                                    std::vector<ov::genai::RawPerfMetrics>& raw_metrics) {
+    const size_t batch_size = init_ids.size(), init_ids_len = init_ids.at(0).size();
+    std::vector<std::vector<int64_t>> output_tokens(batch_size);
+    std::vector<bool> finished(batch_size, false);
+    size_t num_finished = 0;
+
+    auto infer = [&](ov::InferRequest& request) {
+        const auto infer_start = std::chrono::steady_clock::now();
+        request.infer();
+        const auto infer_end = std::chrono::steady_clock::now();
+        const auto infer_ms = ov::genai::PerfMetrics::get_microsec(infer_end - infer_start);
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            raw_metrics[batch].m_inference_durations[0] += MicroSeconds(infer_ms);
+            if (!finished[batch]) {
+                raw_metrics[batch].m_token_infer_durations.emplace_back(infer_ms);
+                raw_metrics[batch].m_new_token_times.emplace_back(infer_end);
+                raw_metrics[batch].m_batch_sizes.emplace_back(batch_size);
+            }
+        }
+    };
+
+    auto sample = [&](ov::Tensor& logits, const bool initial_step) {
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            if (finished[batch]) {
+                continue;
+            }
+            if (initial_step) {
+                ov::genai::do_suppress_tokens(logits, batch, config.begin_suppress_tokens);
+            }
+            ov::genai::do_suppress_tokens(logits, batch, config.suppress_tokens);
+            if (return_timestamps) {
+                ov::genai::process_whisper_timestamp_logits(logits, batch, config, output_tokens[batch], initial_step);
+            }
+
+            int64_t output_token = ov::genai::utils::argmax(logits, batch);
+            // the first token is kept even if it's eos, the same way as full_decode() does
+            if (!initial_step && output_token == config.eos_token_id) {
+                finished[batch] = true;
+            } else {
+                output_tokens[batch].push_back(output_token);
+                finished[batch] = output_tokens[batch].size() >= max_new_tokens;
+            }
+            num_finished += finished[batch];
+        }
+    };
+
+    std::vector<int64_t> input_ids;
+    input_ids.reserve(batch_size * init_ids_len);
+    for (const auto& ids : init_ids) {
+        OPENVINO_ASSERT(ids.size() == init_ids_len, "Init ids of batched inputs are expected to have the same length");
+        input_ids.insert(input_ids.end(), ids.begin(), ids.end());
+    }
+    models.decoder.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+    models.decoder.set_tensor("input_ids", ov::Tensor(ov::element::i64, {batch_size, init_ids_len}, input_ids.data()));
+    infer(models.decoder);
+    auto logits = models.decoder.get_tensor("logits");
+    sample(logits, true);
+
+    if (num_finished == batch_size) {
+        return output_tokens;
+    }
+
+    set_past_key_value(models.decoder, models.decoder_with_past);
+    models.decoder_with_past.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+
+    for (size_t i = 0; i < max_new_tokens - 1 && num_finished < batch_size; i++) {
+        // finished sequences are fed with eos, as the batch layout of the past key values can't change
+        input_ids.resize(batch_size);
+        for (size_t batch = 0; batch < batch_size; ++batch) {
+            input_ids[batch] = finished[batch] ? config.eos_token_id : output_tokens[batch].back();
+        }
+        models.decoder_with_past.set_tensor("input_ids", ov::Tensor(ov::element::i64, {batch_size, 1}, input_ids.data()));
+
+        ov::Tensor cache_position_tensor = models.decoder_with_past.get_tensor("cache_position");
+        cache_position_tensor.set_shape({1});
+        cache_position_tensor.data<int64_t>()[0] = init_ids_len + i;
+
+        infer(models.decoder_with_past);
+        logits = models.decoder_with_past.get_tensor("logits");
+        sample(logits, false);
+
+        if (i == 0) {
+            set_past_key_value(models.decoder_with_past, models.decoder_with_past);
+        }
+    }
+
+    return output_tokens;
+}
+
 }  // namespace
 
 namespace ov {
@@ -396,5 +571,76 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
 
     return result;
 }
+
+std::vector<WhisperGenerateResult> whisper_generate(const ov::genai::WhisperGenerationConfig& config,
+                                                    const ov::genai::WhisperConfig& model_config,
+                                                    const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    WhisperFeatureExtractor& feature_extractor) {
+    const size_t batch_size = raw_speech_inputs.size();
+    const size_t max_new_tokens = config.get_max_new_tokens();
+    std::vector<WhisperGenerateResult> results(batch_size);
+    if (batch_size == 0) {
+        return results;
+    }
+
+    std::vector<RawPerfMetrics> raw_metrics(batch_size);
+    std::vector<std::vector<float>> input_features(batch_size);
+    for (size_t batch = 0; batch < batch_size; ++batch) {
+        raw_metrics[batch].m_inference_durations = {{MicroSeconds(0.0f)}};
+        results[batch].perf_metrics.num_input_tokens = 0;
+
+        const auto infer_start = std::chrono::steady_clock::now();
+        auto features = feature_extractor.extract(raw_speech_inputs[batch]);
+        const auto infer_ms = ov::genai::PerfMetrics::get_microsec(std::chrono::steady_clock::now() - infer_start);
+        results[batch].perf_metrics.whisper_raw_metrics.features_extraction_durations.emplace_back(infer_ms);
+
+        OPENVINO_ASSERT(features.n_frames <= feature_extractor.nb_max_frames,
+                        "Batched generation supports short-form audio (<= ",
+                        feature_extractor.chunk_length,
+                        " seconds) only, input ",
+                        batch,
+                        " is longer");
+        input_features[batch] = features.get_data_with_offset(0, feature_extractor.nb_max_frames);
+    }
+
+    ov::Tensor hidden_state_tensor = encode_batch(models.encoder,
+                                                  input_features,
+                                                  feature_extractor.feature_size,
+                                                  feature_extractor.nb_max_frames,
+                                                  raw_metrics);
+
+    const bool return_timestamps = config.return_timestamps;
+    auto init_ids = prepare_batch_init_ids(hidden_state_tensor, models.decoder, config, return_timestamps, raw_metrics);
+    auto output_tokens = full_decode_batch(hidden_state_tensor,
+                                           config,
+                                           models,
+                                           init_ids,
+                                           max_new_tokens,
+                                           return_timestamps,
+                                           raw_metrics);
+
+    models.decoder_with_past.reset_state();
+
+    // 0.02 by default
+    const float time_precision = static_cast<float>(feature_extractor.chunk_length) / model_config.max_source_positions;
+    for (size_t batch = 0; batch < batch_size; ++batch) {
+        WhisperGenerateResult& result = results[batch];
+        result.perf_metrics.raw_metrics = std::move(raw_metrics[batch]);
+        if (return_timestamps) {
+            auto extracted_segments = ov::genai::extract_segments(output_tokens[batch],
+                                                                  config,
+                                                                  feature_extractor.nb_max_frames,
+                                                                  time_precision);
+            filter_non_segment_metrics(result.perf_metrics.raw_metrics, 0, extracted_segments.segment_ranges);
+            result.output_tokens = std::move(extracted_segments.non_timestamp_tokens);
+            result.segments = std::move(extracted_segments.segments);
+        } else {
+            result.output_tokens = std::move(output_tokens[batch]);
+        }
+    }
+
+    return results;
+}
 }  // namespace genai
 }  // namespace ov
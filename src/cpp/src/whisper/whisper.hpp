@@ -33,5 +33,13 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
                                        ov::genai::WhisperFeatureExtractor& feature_extractor,
                                        const std::shared_ptr<ChunkStreamerBase> streamer);
 
+// Transcribes short-form inputs (up to 30 seconds each) at once: the encoder runs on all inputs in one batch
+// and the decoder generates the next token of every input in one batched inference
+std::vector<WhisperGenerateResult> whisper_generate(const ov::genai::WhisperGenerationConfig& config,
+                                                    const ov::genai::WhisperConfig& model_config,
+                                                    const std::vector<ov::genai::RawSpeechInput>& raw_speech_inputs,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    ov::genai::WhisperFeatureExtractor& feature_extractor);
+
 }  // namespace genai
 }  // namespace ov
@@ -94,6 +94,30 @@ public:
                                                            m_models,
                                                            m_feature_extractor,
                                                            streamer_ptr);
+        return decode_result(generate_result, start_time);
+    }
+
+    std::vector<WhisperDecodedResults> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                OptionalWhisperGenerationConfig generation_config) override {
+        auto start_time = std::chrono::steady_clock::now();
+        WhisperGenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
+        config.validate();
+
+        auto generate_results = ov::genai::whisper_generate(config,
+                                                            m_model_config,
+                                                            raw_speech_inputs,
+                                                            m_models,
+                                                            m_feature_extractor);
+        std::vector<WhisperDecodedResults> results;
+        results.reserve(generate_results.size());
+        for (auto& generate_result : generate_results) {
+            results.push_back(decode_result(generate_result, start_time));
+        }
+        return results;
+    }
+
+private:
+    WhisperDecodedResults decode_result(WhisperGenerateResult& generate_result, TimePoint start_time) {
         auto decode_start_time = std::chrono::steady_clock::now();
         WhisperDecodedResults result{std::vector{m_tokenizer.decode(generate_result.output_tokens)}, std::vector{1.f}};
         generate_result.perf_metrics.raw_metrics.detokenization_durations.emplace_back(
@@ -172,6 +196,12 @@ ov::genai::WhisperDecodedResults ov::genai::WhisperPipeline::generate(const RawS
     return m_impl->generate(raw_speech_input, config, get_chunk_streamer_from_map(config_map));
 }
 
+std::vector<ov::genai::WhisperDecodedResults> ov::genai::WhisperPipeline::generate(
+    const std::vector<RawSpeechInput>& raw_speech_inputs,
+    OptionalWhisperGenerationConfig generation_config) {
+    return m_impl->generate(raw_speech_inputs, generation_config);
+}
+
 ov::genai::WhisperGenerationConfig ov::genai::WhisperPipeline::get_generation_config() const {
     return m_impl->m_generation_config;
 }
@@ -32,6 +32,11 @@ public:
                                            OptionalWhisperGenerationConfig generation_config,
                                            ChunkStreamerVariant streamer) = 0;
 
+    virtual std::vector<WhisperDecodedResults> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                        OptionalWhisperGenerationConfig generation_config) {
+        OPENVINO_THROW("Batched generation is not supported by this WhisperPipeline backend");
+    }
+
     virtual ~WhisperPipelineImplBase() = default;
 };
 
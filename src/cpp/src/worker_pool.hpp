@@ -0,0 +1,74 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ov::genai {
+
+// Fixed number of long-lived threads executing submitted tasks in FIFO order.
+// Threads are started by the first submit(), so an unused pool doesn't cost anything.
+// The destructor waits until all submitted tasks are executed.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t num_workers) : m_num_workers(num_workers) {}
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stopped = true;
+        }
+        m_cv.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_tasks.push_back(std::move(task));
+            if (m_workers.empty()) {
+                for (size_t i = 0; i < m_num_workers; ++i) {
+                    m_workers.emplace_back([this] { run(); });
+                }
+            }
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_cv.wait(lock, [this] { return m_stopped || !m_tasks.empty(); });
+                if (m_tasks.empty()) {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    size_t m_num_workers;
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopped = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+}  // namespace ov::genai
@@ -41,11 +41,13 @@ from .py_openvino_genai import (
 # Generation config
 from .py_openvino_genai import (
     GenerationConfig,
-    StopCriteria
+    StopCriteria,
+    StructuredOutputConfig
 )
 
 # Tokenizers
 from .py_openvino_genai import (
+    BulkTokenizedInputs,
     TokenizedInputs,
     Tokenizer
 )
@@ -79,4 +81,7 @@ from .py_openvino_genai import (
     SchedulerConfig,
     CacheEvictionConfig,
     AggregationMode,
+    BatchedStreamerBase,
+    BatchedTextStreamer,
+    StreamedText,
 )
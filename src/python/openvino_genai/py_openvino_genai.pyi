@@ -5,7 +5,7 @@ from __future__ import annotations
 import openvino._pyopenvino
 import os
 import typing
-__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'ImageGenerationConfig', 'LLMPipeline', 'MeanStdPair', 'PerfMetrics', 'PipelineMetrics', 'RawPerfMetrics', 'Scheduler', 'SchedulerConfig', 'StopCriteria', 'StreamerBase', 'Text2ImagePipeline', 'TokenizedInputs', 'Tokenizer', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model']
+__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'BatchedStreamerBase', 'BatchedTextStreamer', 'BulkTokenizedInputs', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'ImageGenerationConfig', 'LLMPipeline', 'MeanStdPair', 'PerfMetrics', 'PipelineMetrics', 'RawPerfMetrics', 'Scheduler', 'SchedulerConfig', 'StopCriteria', 'StreamedText', 'StreamerBase', 'StructuredOutputConfig', 'Text2ImagePipeline', 'TokenizedInputs', 'Tokenizer', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model']
 class Adapter:
     """
     Immutable LoRA Adapter that carries the adaptation matrices and serves as unique adapter identifier.
@@ -38,13 +38,16 @@ class AdapterConfig:
           MODE_STATIC
         
           MODE_FUSE
+        
+          MODE_DYNAMIC_PER_TOKEN
         """
         MODE_AUTO: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_AUTO: 0>
         MODE_DYNAMIC: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_DYNAMIC: 1>
+        MODE_DYNAMIC_PER_TOKEN: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_DYNAMIC_PER_TOKEN: 5>
         MODE_FUSE: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_FUSE: 4>
         MODE_STATIC: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_STATIC: 3>
         MODE_STATIC_RANK: typing.ClassVar[AdapterConfig.Mode]  # value = <Mode.MODE_STATIC_RANK: 2>
-        __members__: typing.ClassVar[dict[str, AdapterConfig.Mode]]  # value = {'MODE_AUTO': <Mode.MODE_AUTO: 0>, 'MODE_DYNAMIC': <Mode.MODE_DYNAMIC: 1>, 'MODE_STATIC_RANK': <Mode.MODE_STATIC_RANK: 2>, 'MODE_STATIC': <Mode.MODE_STATIC: 3>, 'MODE_FUSE': <Mode.MODE_FUSE: 4>}
+        __members__: typing.ClassVar[dict[str, AdapterConfig.Mode]]  # value = {'MODE_AUTO': <Mode.MODE_AUTO: 0>, 'MODE_DYNAMIC': <Mode.MODE_DYNAMIC: 1>, 'MODE_STATIC_RANK': <Mode.MODE_STATIC_RANK: 2>, 'MODE_STATIC': <Mode.MODE_STATIC: 3>, 'MODE_FUSE': <Mode.MODE_FUSE: 4>, 'MODE_DYNAMIC_PER_TOKEN': <Mode.MODE_DYNAMIC_PER_TOKEN: 5>}
         def __eq__(self, other: typing.Any) -> bool:
             ...
         def __getstate__(self) -> int:
@@ -98,10 +101,18 @@ class AdapterConfig:
         ...
     def get_alpha(self, adapter: Adapter) -> float:
         ...
+    def get_cache_size(self) -> int | None:
+        """
+        Returns memory budget in bytes for LoRA state tensors prepared for recently applied adapter sets, None if it's not set.
+        """
     def remove(self, adapter: Adapter) -> AdapterConfig:
         ...
     def set_alpha(self, adapter: Adapter, alpha: float) -> AdapterConfig:
         ...
+    def set_cache_size(self, cache_size: int | None) -> None:
+        """
+        Sets memory budget in bytes for LoRA state tensors prepared for recently applied adapter sets in dynamic modes, so switching back to them doesn't prepare the tensors again. None or 0 (default) keeps the last applied set only.
+        """
 class AggregationMode:
     """
     Represents the mode of per-token score aggregation when determining least important tokens for eviction from cache
@@ -212,6 +223,31 @@ class AutoencoderKL:
         ...
     def reshape(self, batch_size: int, height: int, width: int) -> AutoencoderKL:
         ...
+class BatchedStreamerBase:
+    """
+    Base class for streamers receiving tokens of all requests at once
+    """
+class BatchedTextStreamer(BatchedStreamerBase):
+    """
+    
+        Batched streamer which detokenizes new tokens of all sequences with a single Tokenizer.decode call per step
+        and passes the decoded texts to the callback. Returning True from the callback drops all running requests.
+        Pass an instance to ContinuousBatchingPipeline.set_batched_streamer.
+    
+        :param tokenizer: Tokenizer used for detokenization.
+        :type tokenizer: Tokenizer
+    
+        :param callback: Callable receiving a list of StreamedText once per step.
+        :type callback: Callable[[List[StreamedText]], bool]
+    """
+    def __init__(self, tokenizer: Tokenizer, callback: typing.Callable[[list[StreamedText]], bool]) -> None:
+        ...
+class BulkTokenizedInputs:
+    input_ids: list[list[int]]
+    num_tokens: int
+    tokens_per_second: float
+    def __init__(self) -> None:
+        ...
 class CLIPTextModel:
     """
     CLIPTextModel class.
@@ -372,6 +408,10 @@ class ContinuousBatchingPipeline:
     @typing.overload
     def add_request(self, request_id: int, prompt: str, sampling_params: GenerationConfig) -> GenerationHandle:
         ...
+    def add_session_request(self, request_id: int, session_id: int, message: str, sampling_params: GenerationConfig) -> GenerationHandle:
+        ...
+    def close_chat_session(self, session_id: int) -> None:
+        ...
     @typing.overload
     def generate(self, input_ids: list[openvino._pyopenvino.Tensor], sampling_params: list[GenerationConfig], streamer: typing.Callable[[str], bool] | StreamerBase | None = None) -> list[EncodedGenerationResult]:
         ...
@@ -386,6 +426,10 @@ class ContinuousBatchingPipeline:
         ...
     def has_non_finished_requests(self) -> bool:
         ...
+    def open_chat_session(self, system_message: str = '') -> int:
+        ...
+    def set_batched_streamer(self, streamer: BatchedStreamerBase) -> None:
+        ...
     def step(self) -> None:
         ...
 class CppStdGenerator(Generator):
@@ -436,7 +480,7 @@ class EncodedGenerationResult:
             RUNNING = 0 - Default status for ongoing generation.
             FINISHED = 1 - Status set when generation has been finished.
             IGNORED = 2 - Status set when generation run into out-of-memory condition and could not be continued.
-            DROPPED_BY_PIPELINE = 3 - Currently not used, TODO: implement abort functionality.
+            DROPPED_BY_PIPELINE = 3 - Status set when generation is stopped by the pipeline, e.g. by a batched streamer.
             DROPPED_BY_HANDLE = 4 - Status set when generation handle is dropped.
     
     """
@@ -512,11 +556,15 @@ class GenerationConfig:
         top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
         do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
         repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.    
+    
+        Structured output parameters:
+        structured_output_config: if set, generated text is constrained by a JSON schema, regex or grammar. Not supported for beam search.
     """
     adapters: AdapterConfig | None
     assistant_confidence_threshold: float
     diversity_penalty: float
     do_sample: bool
+    dynamic_num_assistant_tokens: bool
     echo: bool
     eos_token_id: int
     frequency_penalty: float
@@ -524,8 +572,10 @@ class GenerationConfig:
     include_stop_str_in_output: bool
     length_penalty: float
     logprobs: int
+    max_candidate_branches: int
     max_length: int
     max_new_tokens: int
+    max_ngram_size: int
     min_new_tokens: int
     no_repeat_ngram_size: int
     num_assistant_tokens: int
@@ -538,6 +588,7 @@ class GenerationConfig:
     stop_criteria: StopCriteria
     stop_strings: set[str]
     stop_token_ids: set[int]
+    structured_output_config: StructuredOutputConfig | None
     temperature: float
     top_k: int
     top_p: float
@@ -553,6 +604,8 @@ class GenerationConfig:
         ...
     def is_greedy_decoding(self) -> bool:
         ...
+    def is_prompt_lookup(self) -> bool:
+        ...
     def is_speculative_decoding(self) -> bool:
         ...
     def set_eos_token_id(self, tokenizer_eos_token_id: int) -> None:
@@ -631,7 +684,7 @@ class GenerationResult:
             RUNNING = 0 - Default status for ongoing generation.
             FINISHED = 1 - Status set when generation has been finished.
             IGNORED = 2 - Status set when generation run into out-of-memory condition and could not be continued.
-            DROPPED_BY_PIPELINE = 3 - Currently not used, TODO: implement abort functionality.
+            DROPPED_BY_PIPELINE = 3 - Status set when generation is stopped by the pipeline, e.g. by a batched streamer.
             DROPPED_BY_HANDLE = 4 - Status set when generation handle is dropped.
     
     """
@@ -873,6 +926,14 @@ class LLMPipeline:
         ...
     def set_generation_config(self, config: GenerationConfig) -> None:
         ...
+    def load_chat_state(self, path: os.PathLike) -> None:
+        """
+        Restores KV cache and history of a chat saved by save_chat_state and continues the chat.
+        """
+    def save_chat_state(self, path: os.PathLike) -> None:
+        """
+        Saves KV cache and history of the current chat to a file, so the chat can be resumed by load_chat_state.
+        """
     def start_chat(self, system_message: str = '') -> None:
         ...
 class MeanStdPair:
@@ -989,6 +1050,12 @@ class PipelineMetrics:
     
         :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
         :type avg_cache_usage: float
+    
+        :param tokenization_cache_hit_rate: Hit rate of the tokenization cache for prompts added as strings.
+        :type tokenization_cache_hit_rate: float
+    
+        :param tokenization_time_saved: Estimated time in ms saved by the tokenization cache during the lifetime of the pipeline.
+        :type tokenization_time_saved: float
     """
     def __init__(self) -> None:
         ...
@@ -1007,6 +1074,12 @@ class PipelineMetrics:
     @property
     def scheduled_requests(self) -> int:
         ...
+    @property
+    def tokenization_cache_hit_rate(self) -> float:
+        ...
+    @property
+    def tokenization_time_saved(self) -> float:
+        ...
 class RawPerfMetrics:
     """
     
@@ -1139,6 +1212,8 @@ class SchedulerConfig:
             This results in more RAM usage, maximum RAM usage is determined by cache_size or num_kv_blocks parameters.
             When turend off only KV-cache required for batch calculation is kept in memory and
             when a sequence has finished genegartion its cache is released.
+        session_idle_timeout:       KV cache blocks of a chat session which was idle for this number of seconds are released.
+            0 means blocks are kept until they are required by other sequences.
     """
     cache_eviction_config: CacheEvictionConfig
     cache_size: int
@@ -1147,6 +1222,7 @@ class SchedulerConfig:
     max_num_batched_tokens: int
     max_num_seqs: int
     num_kv_blocks: int
+    session_idle_timeout: int
     use_cache_eviction: bool
     def __init__(self) -> None:
         ...
@@ -1199,6 +1275,35 @@ class StopCriteria:
     @property
     def value(self) -> int:
         ...
+class StreamedText:
+    """
+    
+        Text of a sequence decoded since the previous step of ContinuousBatchingPipeline.
+    
+        :param request_id: Id of the request the sequence belongs to.
+        :type request_id: int
+    
+        :param sequence_id: Id of the sequence within the request, the same as the key of GenerationResult outputs.
+        :type sequence_id: int
+    
+        :param text: Newly decoded text, may be empty for a finished sequence.
+        :type text: str
+    
+        :param finished: No more text will be streamed for this sequence.
+        :type finished: bool
+    """
+    @property
+    def finished(self) -> bool:
+        ...
+    @property
+    def request_id(self) -> int:
+        ...
+    @property
+    def sequence_id(self) -> int:
+        ...
+    @property
+    def text(self) -> str:
+        ...
 class StreamerBase:
     """
     
@@ -1214,6 +1319,20 @@ class StreamerBase:
         """
         Put is called every time new token is decoded. Returns a bool flag to indicate whether generation should be stopped, if return true generation stops
         """
+class StructuredOutputConfig:
+    """
+    
+        Structure to constrain generated text. Exactly one of the fields must be set.
+    
+        json_schema: generated text is a JSON value matching the JSON schema.
+        regex:       generated text matches the regular expression as a whole.
+        grammar:     generated text matches the EBNF grammar starting from the 'root' rule, rules must not be recursive.
+    """
+    grammar: str | None
+    json_schema: str | None
+    regex: str | None
+    def __init__(self, json_schema: str | None = None, regex: str | None = None, grammar: str | None = None) -> None:
+        ...
 class Text2ImagePipeline:
     """
     This class is used for generation with text-to-image models.
@@ -1327,6 +1446,11 @@ class Tokenizer:
         """
         Encodes a single prompt into tokenized input.
         """
+    def encode_bulk(self, prompts: list[str], batch_size: int = 64, add_special_tokens: bool = True) -> BulkTokenizedInputs:
+        """
+        Encodes a large number of prompts by length-sorted batches on parallel infer requests.
+                       Returns token ids of every prompt without padding and the number of tokens per second.
+        """
     def get_bos_token(self) -> str:
         ...
     def get_bos_token_id(self) -> int:
@@ -1698,6 +1822,7 @@ class WhisperPipeline:
                     models_path (os.PathLike): Path to the model file.
                     device (str): Device to run the model on (e.g., CPU, GPU).
         """
+    @typing.overload
     def generate(self, raw_speech_input: list[float], generation_config: WhisperGenerationConfig | None = None, streamer: typing.Callable[[str], bool] | ChunkStreamerBase | None = None, **kwargs) -> WhisperDecodedResults:
         """
             High level generate that receives raw speech as a vector of floats and returns decoded output.
@@ -1719,6 +1844,82 @@ class WhisperPipeline:
             :rtype: WhisperDecodedResults
          
          
+            WhisperGenerationConfig
+            :param max_length: the maximum length the generated tokens can have. Corresponds to the length of the input prompt +
+                               `max_new_tokens`. Its effect is overridden by `max_new_tokens`, if also set.
+            :type max_length: int
+        
+            :param max_new_tokens: the maximum numbers of tokens to generate, excluding the number of tokens in the prompt. max_new_tokens has priority over max_length.
+            :type max_new_tokens: int
+        
+            :param eos_token_id: End of stream token id.
+            :type eos_token_id: int
+        
+            Whisper specific parameters:
+        
+            :param decoder_start_token_id: Corresponds to the ”<|startoftranscript|>” token.
+            :type decoder_start_token_id: int
+        
+            :param pad_token_id: Padding token id.
+            :type pad_token_id: int
+        
+            :param translate_token_id: Translate token id.
+            :type translate_token_id: int
+        
+            :param transcribe_token_id: Transcribe token id.
+            :type transcribe_token_id: int
+        
+            :param no_timestamps_token_id: No timestamps token id.
+            :type no_timestamps_token_id: int
+        
+            :param is_multilingual:
+            :type is_multilingual: bool
+        
+            :param begin_suppress_tokens: A list containing tokens that will be suppressed at the beginning of the sampling process.
+            :type begin_suppress_tokens: list[int]
+        
+            :param suppress_tokens: A list containing the non-speech tokens that will be suppressed during generation.
+            :type suppress_tokens: list[int]
+        
+            :param language: Language token to use for generation in the form of <|en|>.
+                             You can find all the possible language tokens in the generation_config.json lang_to_id dictionary.
+            :type language: Optional[str]
+        
+            :param lang_to_id: Language token to token_id map. Initialized from the generation_config.json lang_to_id dictionary.
+            :type lang_to_id: Dict[str, int]
+        
+            :param task: Task to use for generation, either “translate” or “transcribe”
+            :type task: int
+        
+            :param return_timestamps: If `true` the pipeline will return timestamps along the text for *segments* of words in the text.
+                               For instance, if you get
+                               WhisperDecodedResultChunk
+                                   start_ts = 0.5
+                                   end_ts = 1.5
+                                   text = " Hi there!"
+                               then it means the model predicts that the segment "Hi there!" was spoken after `0.5` and before `1.5` seconds.
+                               Note that a segment of text refers to a sequence of one or more words, rather than individual words.
+            :type return_timestamps: bool
+        """
+    @typing.overload
+    def generate(self, raw_speech_inputs: list[list[float]], generation_config: WhisperGenerationConfig | None = None, **kwargs) -> list[WhisperDecodedResults]:
+        """
+            Generates transcriptions of several short-form (<= 30 seconds) audio inputs in a single batch.
+            Streaming is not supported.
+        
+            :param raw_speech_inputs: inputs in the form of list of lists of floats. Required to be normalized to near [-1, 1] range and have 16k Hz sampling rate.
+            :type raw_speech_inputs: List[List[float]]
+        
+            :param generation_config: generation_config applied to all inputs
+            :type generation_config: WhisperGenerationConfig or a Dict
+        
+            :param kwargs: arbitrary keyword arguments with keys corresponding to WhisperGenerationConfig fields.
+            :type : Dict
+        
+            :return: return results in decoded form, one per input
+            :rtype: List[WhisperDecodedResults]
+         
+         
             WhisperGenerationConfig
             :param max_length: the maximum length the generated tokens can have. Corresponds to the length of the input prompt +
                                `max_new_tokens`. Its effect is overridden by `max_new_tokens`, if also set.
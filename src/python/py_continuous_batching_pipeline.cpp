@@ -8,6 +8,7 @@
 #include <pybind11/stl/filesystem.h>
 #include <pybind11/functional.h>
 
+#include "openvino/genai/batched_streamer.hpp"
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "tokenizers_path.hpp"
 
@@ -17,6 +18,8 @@ namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::AggregationMode;
+using ov::genai::BatchedStreamerBase;
+using ov::genai::BatchedTextStreamer;
 using ov::genai::CacheEvictionConfig;
 using ov::genai::ContinuousBatchingPipeline;
 using ov::genai::GenerationResult;
@@ -27,9 +30,38 @@ using ov::genai::GenerationFinishReason;
 using ov::genai::GenerationStatus;
 using ov::genai::SchedulerConfig;
 using ov::genai::PipelineMetrics;
+using ov::genai::StreamedText;
 
 namespace {
 
+auto streamed_text_docstring = R"(
+    Text of a sequence decoded since the previous step of ContinuousBatchingPipeline.
+
+    :param request_id: Id of the request the sequence belongs to.
+    :type request_id: int
+
+    :param sequence_id: Id of the sequence within the request, the same as the key of GenerationResult outputs.
+    :type sequence_id: int
+
+    :param text: Newly decoded text, may be empty for a finished sequence.
+    :type text: str
+
+    :param finished: No more text will be streamed for this sequence.
+    :type finished: bool
+)";
+
+auto batched_text_streamer_docstring = R"(
+    Batched streamer which detokenizes new tokens of all sequences with a single Tokenizer.decode call per step
+    and passes the decoded texts to the callback. Returning True from the callback drops all running requests.
+    Pass an instance to ContinuousBatchingPipeline.set_batched_streamer.
+
+    :param tokenizer: Tokenizer used for detokenization.
+    :type tokenizer: Tokenizer
+
+    :param callback: Callable receiving a list of StreamedText once per step.
+    :type callback: Callable[[List[StreamedText]], bool]
+)";
+
 auto cache_eviction_config_docstring = R"(
     Configuration struct for the cache eviction algorithm.
     :param start_size: Number of tokens in the *beginning* of KV cache that should be retained in the KV cache for this sequence during generation. Must be non-zero and a multiple of the KV cache block size for this pipeline.
@@ -64,6 +96,8 @@ auto scheduler_config_docstring = R"(
         This results in more RAM usage, maximum RAM usage is determined by cache_size or num_kv_blocks parameters.
         When turend off only KV-cache required for batch calculation is kept in memory and
         when a sequence has finished genegartion its cache is released.
+    session_idle_timeout:       KV cache blocks of a chat session which was idle for this number of seconds are released.
+        0 means blocks are kept until they are required by other sequences.
 )";
 
 auto generation_result_docstring = R"(
@@ -78,7 +112,7 @@ auto generation_result_docstring = R"(
         RUNNING = 0 - Default status for ongoing generation.
         FINISHED = 1 - Status set when generation has been finished.
         IGNORED = 2 - Status set when generation run into out-of-memory condition and could not be continued.
-        DROPPED_BY_PIPELINE = 3 - Currently not used, TODO: implement abort functionality.
+        DROPPED_BY_PIPELINE = 3 - Status set when generation is stopped by the pipeline, e.g. by a batched streamer.
         DROPPED_BY_HANDLE = 4 - Status set when generation handle is dropped.
 
 )";
@@ -102,6 +136,12 @@ auto pipeline_metrics_docstring = R"(
 
     :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
     :type avg_cache_usage: float
+
+    :param tokenization_cache_hit_rate: Hit rate of the tokenization cache for prompts added as strings.
+    :type tokenization_cache_hit_rate: float
+
+    :param tokenization_time_saved: Estimated time in ms saved by the tokenization cache during the lifetime of the pipeline.
+    :type tokenization_time_saved: float
 )";
 
 std::ostream& operator << (std::ostream& stream, const GenerationResult& generation_result) {
@@ -200,6 +240,7 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def_readwrite("dynamic_split_fuse", &SchedulerConfig::dynamic_split_fuse)
         .def_readwrite("max_num_seqs", &SchedulerConfig::max_num_seqs)
         .def_readwrite("enable_prefix_caching", &SchedulerConfig::enable_prefix_caching)
+        .def_readwrite("session_idle_timeout", &SchedulerConfig::session_idle_timeout)
         .def_readwrite("use_cache_eviction", &SchedulerConfig::use_cache_eviction)
         .def_readwrite("cache_eviction_config", &SchedulerConfig::cache_eviction_config);
 
@@ -209,7 +250,20 @@ void init_continuous_batching_pipeline(py::module_& m) {
             .def_readonly("scheduled_requests", &PipelineMetrics::scheduled_requests)
             .def_readonly("cache_usage", &PipelineMetrics::cache_usage)
             .def_readonly("avg_cache_usage", &PipelineMetrics::avg_cache_usage)
-            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage);
+            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage)
+            .def_readonly("tokenization_cache_hit_rate", &PipelineMetrics::tokenization_cache_hit_rate)
+            .def_readonly("tokenization_time_saved", &PipelineMetrics::tokenization_time_saved);
+
+    py::class_<StreamedText>(m, "StreamedText", streamed_text_docstring)
+        .def_readonly("request_id", &StreamedText::request_id)
+        .def_readonly("sequence_id", &StreamedText::sequence_id)
+        .def_readonly("text", &StreamedText::text)
+        .def_readonly("finished", &StreamedText::finished);
+
+    py::class_<BatchedStreamerBase, std::shared_ptr<BatchedStreamerBase>>(m, "BatchedStreamerBase", "Base class for streamers receiving tokens of all requests at once");
+
+    py::class_<BatchedTextStreamer, BatchedStreamerBase, std::shared_ptr<BatchedTextStreamer>>(m, "BatchedTextStreamer", batched_text_streamer_docstring)
+        .def(py::init<const ov::genai::Tokenizer&, std::function<bool(const std::vector<StreamedText>&)>>(), py::arg("tokenizer"), py::arg("callback"));
 
     py::class_<ContinuousBatchingPipeline>(m, "ContinuousBatchingPipeline", "This class is used for generation with LLMs with continuous batchig")
         .def(py::init([](const std::string& models_path, const SchedulerConfig& scheduler_config, const std::string& device, const std::map<std::string, py::object>& llm_plugin_config, const std::map<std::string, py::object>& tokenizer_plugin_config) {
@@ -239,6 +293,10 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def("add_request", py::overload_cast<uint64_t, const std::string&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("prompt"), py::arg("sampling_params"))
         .def("step", &ContinuousBatchingPipeline::step)
         .def("has_non_finished_requests", &ContinuousBatchingPipeline::has_non_finished_requests)
+        .def("open_chat_session", &ContinuousBatchingPipeline::open_chat_session, py::arg("system_message") = "")
+        .def("add_session_request", &ContinuousBatchingPipeline::add_session_request, py::arg("request_id"), py::arg("session_id"), py::arg("message"), py::arg("sampling_params"))
+        .def("close_chat_session", &ContinuousBatchingPipeline::close_chat_session, py::arg("session_id"))
+        .def("set_batched_streamer", &ContinuousBatchingPipeline::set_batched_streamer, py::arg("streamer"))
         .def(
             "generate",
             py::overload_cast<const std::vector<ov::Tensor>&, const std::vector<ov::genai::GenerationConfig>&, const ov::genai::StreamerVariant&>(&ContinuousBatchingPipeline::generate),
@@ -15,6 +15,7 @@ namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::StopCriteria;
 using ov::genai::GenerationConfig;
+using ov::genai::StructuredOutputConfig;
 
 namespace {
 
@@ -27,6 +28,14 @@ auto stop_criteria_docstring =  R"(
         "openvino_genai.StopCriteria.NEVER" stops when there cannot be better candidates.
 )";
 
+auto structured_output_config_docstring = R"(
+    Structure to constrain generated text. Exactly one of the fields must be set.
+
+    json_schema: generated text is a JSON value matching the JSON schema.
+    regex:       generated text matches the regular expression as a whole.
+    grammar:     generated text matches the EBNF grammar starting from the 'root' rule, rules must not be recursive.
+)";
+
 } // namespace
 
 char generation_config_docstring[] = R"(
@@ -69,6 +78,9 @@ char generation_config_docstring[] = R"(
     top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
     do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
     repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.    
+
+    Structured output parameters:
+    structured_output_config: if set, generated text is constrained by a JSON schema, regex or grammar. Not supported for beam search.
 )";
 
 void init_generation_config(py::module_& m) {
@@ -78,6 +90,14 @@ void init_generation_config(py::module_& m) {
         .value("HEURISTIC", StopCriteria::HEURISTIC)
         .value("NEVER", StopCriteria::NEVER);
 
+    py::class_<StructuredOutputConfig>(m, "StructuredOutputConfig", structured_output_config_docstring)
+        .def(py::init([](std::optional<std::string> json_schema, std::optional<std::string> regex, std::optional<std::string> grammar) {
+            return StructuredOutputConfig{json_schema, regex, grammar};
+        }), py::arg("json_schema") = std::nullopt, py::arg("regex") = std::nullopt, py::arg("grammar") = std::nullopt)
+        .def_readwrite("json_schema", &StructuredOutputConfig::json_schema)
+        .def_readwrite("regex", &StructuredOutputConfig::regex)
+        .def_readwrite("grammar", &StructuredOutputConfig::grammar);
+
      // Binding for GenerationConfig
     py::class_<GenerationConfig>(m, "GenerationConfig", generation_config_docstring)
         .def(py::init<std::filesystem::path>(), py::arg("json_path"), "path where generation_config.json is stored")
@@ -107,12 +127,17 @@ void init_generation_config(py::module_& m) {
         .def_readwrite("logprobs", &GenerationConfig::logprobs)
         .def_readwrite("assistant_confidence_threshold", &GenerationConfig::assistant_confidence_threshold)
         .def_readwrite("num_assistant_tokens", &GenerationConfig::num_assistant_tokens)
+        .def_readwrite("dynamic_num_assistant_tokens", &GenerationConfig::dynamic_num_assistant_tokens)
+        .def_readwrite("max_ngram_size", &GenerationConfig::max_ngram_size)
+        .def_readwrite("max_candidate_branches", &GenerationConfig::max_candidate_branches)
         .def_readwrite("include_stop_str_in_output", &GenerationConfig::include_stop_str_in_output)
         .def_readwrite("stop_token_ids", &GenerationConfig::stop_token_ids)
         .def_readwrite("adapters", &GenerationConfig::adapters)
+        .def_readwrite("structured_output_config", &GenerationConfig::structured_output_config)
         .def("set_eos_token_id", &GenerationConfig::set_eos_token_id, py::arg("tokenizer_eos_token_id"))
         .def("is_beam_search", &GenerationConfig::is_beam_search)
         .def("is_greedy_decoding", &GenerationConfig::is_greedy_decoding)
         .def("is_speculative_decoding", &GenerationConfig::is_speculative_decoding)
+        .def("is_prompt_lookup", &GenerationConfig::is_prompt_lookup)
         .def("update_generation_config", static_cast<void (GenerationConfig::*)(const ov::AnyMap&)>(&ov::genai::GenerationConfig::update_generation_config), py::arg("config_map"));
    }
@@ -192,6 +192,10 @@ void init_llm_pipeline(py::module_& m) {
         .def("get_tokenizer", &LLMPipeline::get_tokenizer)
         .def("start_chat", &LLMPipeline::start_chat, py::arg("system_message") = "")
         .def("finish_chat", &LLMPipeline::finish_chat)
+        .def("save_chat_state", py::overload_cast<const std::filesystem::path&>(&LLMPipeline::save_chat_state), py::arg("path"),
+            "Saves KV cache and history of the current chat to a file, so the chat can be resumed by load_chat_state.")
+        .def("load_chat_state", py::overload_cast<const std::filesystem::path&>(&LLMPipeline::load_chat_state), py::arg("path"),
+            "Restores KV cache and history of a chat saved by save_chat_state and continues the chat.")
         .def("get_generation_config", &LLMPipeline::get_generation_config, py::return_value_policy::copy)
         .def("set_generation_config", &LLMPipeline::set_generation_config, py::arg("config"));
 
@@ -38,7 +38,8 @@ void init_lora_adapter(py::module_& m) {
         .value("MODE_DYNAMIC", ov::genai::AdapterConfig::Mode::MODE_DYNAMIC)
         .value("MODE_STATIC_RANK", ov::genai::AdapterConfig::Mode::MODE_STATIC_RANK)
         .value("MODE_STATIC", ov::genai::AdapterConfig::Mode::MODE_STATIC)
-        .value("MODE_FUSE", ov::genai::AdapterConfig::Mode::MODE_FUSE);
+        .value("MODE_FUSE", ov::genai::AdapterConfig::Mode::MODE_FUSE)
+        .value("MODE_DYNAMIC_PER_TOKEN", ov::genai::AdapterConfig::Mode::MODE_DYNAMIC_PER_TOKEN);
 
     adapter_config.def(py::init([](
          ov::genai::AdapterConfig::Mode mode) {
@@ -92,4 +93,9 @@ void init_lora_adapter(py::module_& m) {
     adapter_config.def("get_adapters", &ov::genai::AdapterConfig::get_adapters);
     adapter_config.def("add", static_cast<ov::genai::AdapterConfig& (ov::genai::AdapterConfig::*)(const ov::genai::Adapter&, float)>(&ov::genai::AdapterConfig::add), py::arg("adapter"), py::arg("alpha"));
     adapter_config.def("add", static_cast<ov::genai::AdapterConfig& (ov::genai::AdapterConfig::*)(const ov::genai::Adapter&)>(&ov::genai::AdapterConfig::add), py::arg("adapter"));
+    adapter_config.def("get_cache_size", &ov::genai::AdapterConfig::get_cache_size,
+        "Returns memory budget in bytes for LoRA state tensors prepared for recently applied adapter sets, None if it's not set.");
+    adapter_config.def("set_cache_size", &ov::genai::AdapterConfig::set_cache_size, py::arg("cache_size"),
+        "Sets memory budget in bytes for LoRA state tensors prepared for recently applied adapter sets in dynamic modes, "
+        "so switching back to them doesn't prepare the tensors again. None or 0 (default) keeps the last applied set only.");
 }
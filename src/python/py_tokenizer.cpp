@@ -16,6 +16,7 @@
 namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
+using ov::genai::BulkTokenizedInputs;
 using ov::genai::ChatHistory;
 using ov::genai::TokenizedInputs;
 using ov::genai::Tokenizer;
@@ -26,6 +27,12 @@ void init_tokenizer(py::module_& m) {
         .def_readwrite("input_ids", &TokenizedInputs::input_ids)
         .def_readwrite("attention_mask", &TokenizedInputs::attention_mask);
 
+    py::class_<BulkTokenizedInputs>(m, "BulkTokenizedInputs")
+        .def(py::init<>())
+        .def_readwrite("input_ids", &BulkTokenizedInputs::input_ids)
+        .def_readwrite("num_tokens", &BulkTokenizedInputs::num_tokens)
+        .def_readwrite("tokens_per_second", &BulkTokenizedInputs::tokens_per_second);
+
     py::class_<ov::genai::Tokenizer>(m, "Tokenizer",
         R"(openvino_genai.Tokenizer object is used to initialize Tokenizer
            if it's located in a different path than the main model.)")
@@ -61,6 +68,15 @@ void init_tokenizer(py::module_& m) {
             py::arg("prompt"), py::arg("add_special_tokens") = true,
             R"(Encodes a single prompt into tokenized input.)")
 
+        .def("encode_bulk", [](Tokenizer& tok, const std::vector<std::string>& prompts, size_t batch_size, bool add_special_tokens) {
+                ov::AnyMap tokenization_params;
+                tokenization_params[ov::genai::add_special_tokens.name()] = add_special_tokens;
+                return tok.encode_bulk(prompts, batch_size, tokenization_params);
+            },
+            py::arg("prompts"), py::arg("batch_size") = 64, py::arg("add_special_tokens") = true,
+            R"(Encodes a large number of prompts by length-sorted batches on parallel infer requests.
+               Returns token ids of every prompt without padding and the number of tokens per second.)")
+
         .def(
             "decode",
             [](Tokenizer& tok, std::vector<int64_t>& tokens, bool skip_special_tokens) -> py::str {
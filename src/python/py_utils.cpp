@@ -82,7 +82,10 @@ ov::Any py_object_to_any(const py::object& py_obj, std::string property_name) {
         "max_initial_timestamp_index",
         "num_images_per_prompt",
         "num_inference_steps",
-        "max_sequence_length"
+        "max_sequence_length",
+        "tokenization_cache_size",
+        "max_chat_history_tokens",
+        "attention_sink_tokens"
     };
     // These properties should be casted to ov::AnyMap, instead of std::map. 
     std::set<std::string> any_map_properties = {
@@ -269,6 +272,8 @@ ov::Any py_object_to_any(const py::object& py_obj, std::string property_name) {
         return py::cast<ov::genai::SchedulerConfig>(py_obj);
     } else if (py::isinstance<ov::genai::AdapterConfig>(py_obj)) {
         return py::cast<ov::genai::AdapterConfig>(py_obj);
+    } else if (py::isinstance<ov::genai::StructuredOutputConfig>(py_obj)) {
+        return py::cast<ov::genai::StructuredOutputConfig>(py_obj);
     } else if (py::isinstance<ov::genai::GenerationConfig>(py_obj)) {
         return py::cast<ov::genai::GenerationConfig>(py_obj);
     } else if (py::isinstance<ov::genai::ImageGenerationConfig>(py_obj)) {
@@ -56,6 +56,23 @@ auto whisper_generate_docstring = R"(
     :rtype: WhisperDecodedResults
 )";
 
+auto whisper_batched_generate_docstring = R"(
+    Generates transcriptions of several short-form (<= 30 seconds) audio inputs in a single batch.
+    Streaming is not supported.
+
+    :param raw_speech_inputs: inputs in the form of list of lists of floats. Required to be normalized to near [-1, 1] range and have 16k Hz sampling rate.
+    :type raw_speech_inputs: List[List[float]]
+
+    :param generation_config: generation_config applied to all inputs
+    :type generation_config: WhisperGenerationConfig or a Dict
+
+    :param kwargs: arbitrary keyword arguments with keys corresponding to WhisperGenerationConfig fields.
+    :type : Dict
+
+    :return: return results in decoded form, one per input
+    :rtype: List[WhisperDecodedResults]
+)";
+
 auto whisper_decoded_results_docstring = R"(
     Structure to store resulting text outputs and scores.
 
@@ -223,6 +240,17 @@ py::object call_whisper_common_generate(WhisperPipeline& pipe,
     return py::cast(pipe.generate(raw_speech_input, updated_config, streamer));
 }
 
+py::object call_whisper_batched_generate(WhisperPipeline& pipe,
+                                         const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                         const OptionalWhisperGenerationConfig& config,
+                                         const py::kwargs& kwargs) {
+    OptionalWhisperGenerationConfig base_config = config.has_value() ? config : pipe.get_generation_config();
+
+    auto updated_config = update_whisper_config_from_kwargs(base_config, kwargs);
+
+    return py::cast(pipe.generate(raw_speech_inputs, updated_config));
+}
+
 }  // namespace
 
 void init_whisper_pipeline(py::module_& m) {
@@ -345,6 +373,21 @@ void init_whisper_pipeline(py::module_& m) {
             "streamer",
             (whisper_generate_docstring + std::string(" \n ") + whisper_generation_config_docstring).c_str())
 
+        .def(
+            "generate",
+            [](WhisperPipeline& pipe,
+               const std::vector<RawSpeechInput>& raw_speech_inputs,
+               const OptionalWhisperGenerationConfig& generation_config,
+               const py::kwargs& kwargs) -> py::typing::List<ov::genai::WhisperDecodedResults> {
+                return call_whisper_batched_generate(pipe, raw_speech_inputs, generation_config, kwargs);
+            },
+            py::arg("raw_speech_inputs"),
+            "List of lists of floats representing raw speech audio of each input. "
+            "Required to be normalized to near [-1, 1] range and have 16k Hz sampling rate.",
+            py::arg("generation_config") = std::nullopt,
+            "generation_config",
+            (whisper_batched_generate_docstring + std::string(" \n ") + whisper_generation_config_docstring).c_str())
+
         .def("get_tokenizer", &WhisperPipeline::get_tokenizer)
         .def("get_generation_config", &WhisperPipeline::get_generation_config, py::return_value_policy::copy)
         .def("set_generation_config", &WhisperPipeline::set_generation_config, py::arg("config"));
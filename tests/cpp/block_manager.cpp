@@ -108,4 +108,71 @@ TEST(TestBlockManager, CanFreeBlocksFromSequence) {
     size_t seq_id = sequence_group->get_sequences()[0]->get_id();
     bm.free_blocks_from_sequence(seq_id, { {0}, {1}, {2} });
     EXPECT_EQ(bm.num_free_blocks(), 6);
-}
\ No newline at end of file
+}
+
+TEST(TestBlockManager, RestoresPinnedSessionBlocks) {
+    const size_t BLOCK_SIZE = 4;
+    ov::genai::BlockManager bm = ov::genai::BlockManager(8, false, BLOCK_SIZE, 2);
+
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5};
+    ov::genai::SequenceGroup::Ptr first_turn = std::make_shared<ov::genai::SequenceGroup>(
+            0,
+            ov::Tensor(ov::element::i64, {
+                    tokens.size()}, tokens.data()),
+            ov::genai::greedy(),
+            BLOCK_SIZE,
+            false);
+    auto sequence = first_turn->get_not_finished_sequences()[0];
+    bm.allocate(sequence, 3);
+    // prompt and generated tokens occupy 9 slots, so the last block is kept partially filled
+    bm.pin_session(0, sequence->get_id(), {0,1,2,3,4,5,6,7,8});
+    EXPECT_FALSE(bm.has_block_table(sequence->get_id()));
+    EXPECT_TRUE(bm.has_pinned_session(0));
+    EXPECT_EQ(bm.num_free_blocks(), 5);
+
+    // the next turn diverges from the session after 6 tokens
+    std::vector<uint64_t> next_tokens = {0,1,2,3,4,5,10,11,12};
+    ov::genai::SequenceGroup::Ptr second_turn = std::make_shared<ov::genai::SequenceGroup>(
+            1,
+            ov::Tensor(ov::element::i64, {
+                    next_tokens.size()}, next_tokens.data()),
+            ov::genai::greedy(),
+            BLOCK_SIZE,
+            false);
+    bm.restore_session(0, second_turn);
+    EXPECT_FALSE(bm.has_pinned_session(0));
+    auto next_seq_id = second_turn->get_not_finished_sequences()[0]->get_id();
+    EXPECT_EQ(bm.get_block_table(next_seq_id, 0).size(), 2);
+    EXPECT_EQ(bm.get_block_table(next_seq_id, 1).size(), 2);
+    EXPECT_EQ(bm.num_free_blocks(), 6);
+    EXPECT_EQ(second_turn->get_num_processed_tokens(), 6);
+}
+
+TEST(TestBlockManager, ReleasesLeastRecentlyUsedSession) {
+    const size_t BLOCK_SIZE = 2;
+    ov::genai::BlockManager bm = ov::genai::BlockManager(8, false, BLOCK_SIZE);
+
+    std::vector<uint64_t> tokens = {0,1,2,3};
+    for (uint64_t session_id = 0; session_id < 2; ++session_id) {
+        ov::genai::SequenceGroup::Ptr sequence_group = std::make_shared<ov::genai::SequenceGroup>(
+                session_id,
+                ov::Tensor(ov::element::i64, {
+                        tokens.size()}, tokens.data()),
+                ov::genai::greedy(),
+                BLOCK_SIZE,
+                false);
+        auto sequence = sequence_group->get_not_finished_sequences()[0];
+        bm.allocate(sequence, 2);
+        bm.pin_session(session_id, sequence->get_id(), {0,1,2,3});
+    }
+    EXPECT_EQ(bm.num_free_blocks(), 4);
+
+    EXPECT_TRUE(bm.release_lru_session());
+    EXPECT_FALSE(bm.has_pinned_session(0));
+    EXPECT_TRUE(bm.has_pinned_session(1));
+    EXPECT_EQ(bm.num_free_blocks(), 6);
+
+    EXPECT_TRUE(bm.release_lru_session());
+    EXPECT_FALSE(bm.release_lru_session());
+    EXPECT_EQ(bm.num_free_blocks(), 8);
+}
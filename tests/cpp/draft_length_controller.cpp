@@ -0,0 +1,60 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "openvino/core/except.hpp"
+#include "speculative_decoding/draft_length_controller.hpp"
+
+using namespace ov::genai;
+
+TEST(TestDraftLengthController, StartsWithInitialDraftLen) {
+    DraftLengthController controller(8);
+    controller.add_request(0, 5);
+    controller.add_request(1, 20);
+    EXPECT_EQ(controller.get_draft_len(0), 5);
+    EXPECT_EQ(controller.get_draft_len(1), 8);
+    EXPECT_EQ(controller.get_draft_lens(), (std::map<uint64_t, size_t>{{0, 5}, {1, 8}}));
+
+    controller.remove_request(0);
+    EXPECT_FALSE(controller.has_request(0));
+    EXPECT_THROW(controller.get_draft_len(0), ov::Exception);
+}
+
+TEST(TestDraftLengthController, ShrinksOnRejections) {
+    DraftLengthController controller(8);
+    controller.update_durations(0.1f, 1.f);
+    controller.add_request(0, 5);
+    for (size_t i = 0; i < 10; ++i) {
+        controller.update_acceptance(0, controller.get_draft_len(0), 0);
+    }
+    EXPECT_FLOAT_EQ(controller.get_acceptance_probability(0), 0.f);
+    EXPECT_EQ(controller.get_draft_len(0), 1);
+}
+
+TEST(TestDraftLengthController, GrowsOnAcceptances) {
+    DraftLengthController controller(8);
+    controller.update_durations(0.05f, 1.f);
+    controller.add_request(0, 2);
+    for (size_t i = 0; i < 10; ++i) {
+        size_t draft_len = controller.get_draft_len(0);
+        controller.update_acceptance(0, draft_len, draft_len);
+    }
+    EXPECT_FLOAT_EQ(controller.get_acceptance_probability(0), 1.f);
+    EXPECT_EQ(controller.get_draft_len(0), 8);
+}
+
+TEST(TestDraftLengthController, ShorterDraftsForExpensiveDraftModel) {
+    DraftLengthController cheap(16), expensive(16);
+    cheap.update_durations(0.05f, 1.f);
+    expensive.update_durations(0.5f, 1.f);
+    cheap.add_request(0, 4);
+    expensive.add_request(0, 4);
+    // 3 out of 4 tokens are accepted on average
+    for (size_t i = 0; i < 20; ++i) {
+        cheap.update_acceptance(0, 4, 3);
+        expensive.update_acceptance(0, 4, 3);
+    }
+    EXPECT_FLOAT_EQ(cheap.get_acceptance_probability(0), 0.75f);
+    EXPECT_GT(cheap.get_draft_len(0), expensive.get_draft_len(0));
+    EXPECT_EQ(expensive.get_draft_len(0), 1);
+}
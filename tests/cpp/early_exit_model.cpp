@@ -0,0 +1,97 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "openvino/core/except.hpp"
+#include "openvino/op/add.hpp"
+#include "openvino/op/constant.hpp"
+#include "openvino/op/multiply.hpp"
+#include "openvino/op/parameter.hpp"
+#include "openvino/op/result.hpp"
+#include "openvino/runtime/core.hpp"
+#include "speculative_decoding/early_exit_model.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+std::shared_ptr<ov::op::v0::Parameter> make_parameter(const std::string& name) {
+    auto param = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::Shape{1, 2});
+    param->set_friendly_name(name);
+    param->output(0).set_names({name});
+    return param;
+}
+
+// Mimics a decoder transformed for paged attention: every layer has its own KV cache inputs consumed by the
+// "attention" and scores output, attention and MLP outputs are added to hidden states by residual connections.
+// With KV cache inputs filled with ones, every layer multiplies hidden states by 3 and LM head by 2.
+std::shared_ptr<ov::Model> make_decoder_model(size_t num_layers) {
+    auto hidden_states = make_parameter("inputs_embeds");
+    ov::ParameterVector params = {hidden_states};
+    ov::ResultVector scores;
+    ov::Output<ov::Node> layer_output = hidden_states;
+    for (size_t layer = 0; layer < num_layers; ++layer) {
+        auto key_cache = make_parameter("key_cache." + std::to_string(layer));
+        auto value_cache = make_parameter("value_cache." + std::to_string(layer));
+        params.insert(params.end(), {key_cache, value_cache});
+
+        auto attention = std::make_shared<ov::op::v1::Multiply>(std::make_shared<ov::op::v1::Multiply>(layer_output, key_cache), value_cache);
+        attention->output(0).set_names({"scores." + std::to_string(layer)});
+        scores.push_back(std::make_shared<ov::op::v0::Result>(attention));
+        auto attention_residual = std::make_shared<ov::op::v1::Add>(layer_output, attention);
+
+        auto mlp = std::make_shared<ov::op::v1::Multiply>(attention_residual, ov::op::v0::Constant::create(ov::element::f32, {}, {0.5f}));
+        layer_output = std::make_shared<ov::op::v1::Add>(attention_residual, mlp);
+    }
+    auto lm_head = std::make_shared<ov::op::v1::Multiply>(layer_output, ov::op::v0::Constant::create(ov::element::f32, {}, {2.0f}));
+    ov::ResultVector results = {std::make_shared<ov::op::v0::Result>(lm_head)};
+    results.insert(results.end(), scores.begin(), scores.end());
+    return std::make_shared<ov::Model>(results, params);
+}
+
+std::vector<float> infer(const std::shared_ptr<ov::Model>& model) {
+    ov::InferRequest request = ov::Core().compile_model(model, "CPU").create_infer_request();
+    for (const auto& input : request.get_compiled_model().inputs()) {
+        ov::Tensor tensor(ov::element::f32, {1, 2});
+        std::fill_n(tensor.data<float>(), tensor.get_size(), 1.0f);
+        if (input.get_any_name() == "inputs_embeds") {
+            tensor.data<float>()[1] = 2.0f;
+        }
+        request.set_tensor(input, tensor);
+    }
+    request.infer();
+    ov::Tensor logits = request.get_output_tensor(0);
+    return {logits.data<float>(), logits.data<float>() + logits.get_size()};
+}
+
+}  // namespace
+
+TEST(TestEarlyExitModel, KeepsFirstLayers) {
+    auto model = make_decoder_model(4);
+    ASSERT_EQ(get_num_decoder_layers(model), 4);
+    EXPECT_EQ(infer(model), (std::vector<float>{162.0f, 324.0f}));
+
+    auto early_exit_model = get_early_exit_model(model, 2);
+    EXPECT_EQ(get_num_decoder_layers(early_exit_model), 2);
+    // hidden states and KV cache of the kept layers
+    EXPECT_EQ(early_exit_model->get_parameters().size(), 5);
+    // logits and scores of the kept layers
+    EXPECT_EQ(early_exit_model->get_results().size(), 3);
+    EXPECT_EQ(infer(early_exit_model), (std::vector<float>{18.0f, 36.0f}));
+
+    // original model is not modified
+    EXPECT_EQ(get_num_decoder_layers(model), 4);
+    EXPECT_EQ(infer(model), (std::vector<float>{162.0f, 324.0f}));
+}
+
+TEST(TestEarlyExitModel, KeepsAllButLastLayer) {
+    auto early_exit_model = get_early_exit_model(make_decoder_model(3), 2);
+    EXPECT_EQ(get_num_decoder_layers(early_exit_model), 2);
+    EXPECT_EQ(infer(early_exit_model), (std::vector<float>{18.0f, 36.0f}));
+}
+
+TEST(TestEarlyExitModel, ChecksNumLayers) {
+    auto model = make_decoder_model(4);
+    EXPECT_THROW(get_early_exit_model(model, 0), ov::Exception);
+    EXPECT_THROW(get_early_exit_model(model, 4), ov::Exception);
+}
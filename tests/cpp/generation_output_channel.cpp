@@ -0,0 +1,155 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include "generation_output_channel.hpp"
+
+using ov::genai::GenerationOutputChannel;
+using ov::genai::GenerationOutputs;
+using ov::genai::GenerationFinishReason;
+
+TEST(TestGenerationOutputChannel, ReadsPushesInOrder) {
+    GenerationOutputChannel channel;
+    std::vector<int64_t> ids = {1, 2, 3};
+    std::vector<float> log_probs = {-0.1f, -0.2f, -0.3f};
+
+    channel.append(0, ids.data(), log_probs.data(), 2, -0.3f, GenerationFinishReason::NONE);
+    channel.append(1, ids.data() + 2, log_probs.data() + 2, 1, -0.3f, GenerationFinishReason::NONE);
+    channel.commit();
+    channel.push({});
+    EXPECT_FALSE(channel.empty());
+
+    GenerationOutputs outputs = channel.read();
+    ASSERT_EQ(outputs.size(), 2);
+    EXPECT_EQ(outputs[0].generated_ids, std::vector<int64_t>({1, 2}));
+    EXPECT_EQ(outputs[0].generated_log_probs, std::vector<float>({-0.1f, -0.2f}));
+    EXPECT_FLOAT_EQ(outputs[0].score, -0.3f);
+    EXPECT_EQ(outputs[1].generated_ids, std::vector<int64_t>({3}));
+
+    // empty outputs are delivered as well
+    EXPECT_FALSE(channel.empty());
+    EXPECT_TRUE(channel.read().empty());
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST(TestGenerationOutputChannel, BackReturnsLatestPushWithoutPopping) {
+    GenerationOutputChannel channel;
+    for (int64_t token = 0; token < 200; ++token) {
+        float log_prob = -1.0f;
+        channel.append(0, &token, &log_prob, 1, -1.0f * (token + 1), GenerationFinishReason::NONE);
+        channel.commit();
+    }
+
+    GenerationOutputs latest = channel.back();
+    EXPECT_EQ(latest[0].generated_ids, std::vector<int64_t>({199}));
+
+    for (int64_t token = 0; token < 200; ++token) {
+        GenerationOutputs outputs = channel.read();
+        EXPECT_EQ(outputs[0].generated_ids, std::vector<int64_t>({token}));
+    }
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST(TestGenerationOutputChannel, FinalOutputsAreBuiltOnRead) {
+    GenerationOutputChannel channel;
+    size_t num_builds = 0;
+    channel.push_final([&num_builds] {
+        ++num_builds;
+        GenerationOutputs outputs;
+        outputs[0].generated_ids = {4, 5};
+        outputs[0].generated_log_probs = {-0.4f, -0.5f};
+        outputs[0].finish_reason = GenerationFinishReason::STOP;
+        return outputs;
+    });
+    EXPECT_EQ(num_builds, 0);
+
+    EXPECT_EQ(channel.back()[0].generated_ids, std::vector<int64_t>({4, 5}));
+    GenerationOutputs outputs = channel.read();
+    EXPECT_EQ(num_builds, 2);
+    EXPECT_EQ(outputs[0].generated_ids, std::vector<int64_t>({4, 5}));
+    EXPECT_EQ(outputs[0].finish_reason, GenerationFinishReason::STOP);
+}
+
+TEST(TestGenerationOutputChannel, ConsumerReceivesAllTokensFromProducerThread) {
+    GenerationOutputChannel channel;
+    const int64_t num_tokens = 10000;
+
+    std::thread producer([&channel, num_tokens] {
+        for (int64_t token = 0; token < num_tokens; ++token) {
+            float log_prob = 0.0f;
+            channel.append(0, &token, &log_prob, 1, 0.0f, GenerationFinishReason::NONE);
+            channel.commit();
+        }
+    });
+
+    for (int64_t token = 0; token < num_tokens; ++token) {
+        GenerationOutputs outputs = channel.read();
+        ASSERT_EQ(outputs[0].generated_ids.size(), 1);
+        ASSERT_EQ(outputs[0].generated_ids[0], token);
+    }
+    producer.join();
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST(TestGenerationOutputChannel, KeepsUnreadRecordsWhenRingIsFull) {
+    GenerationOutputChannel channel;
+    // the consumer lags behind by more than the initial ring capacity and catches up several times
+    int64_t next_pushed = 0, next_read = 0;
+    for (size_t round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < 1000; ++i, ++next_pushed) {
+            float log_prob = 0.0f;
+            channel.append(0, &next_pushed, &log_prob, 1, 0.0f, GenerationFinishReason::NONE);
+            channel.commit();
+        }
+        EXPECT_EQ(channel.back()[0].generated_ids, std::vector<int64_t>({next_pushed - 1}));
+        for (; next_read < next_pushed; ++next_read) {
+            GenerationOutputs outputs = channel.read();
+            ASSERT_EQ(outputs[0].generated_ids, std::vector<int64_t>({next_read}));
+        }
+        EXPECT_TRUE(channel.empty());
+    }
+}
+
+TEST(TestGenerationOutputChannel, ReadsFromSeveralThreadsAreSerialized) {
+    GenerationOutputChannel channel;
+    const int64_t num_tokens = 10000;
+    const size_t num_consumers = 2;
+
+    std::thread producer([&channel, num_tokens] {
+        for (int64_t token = 0; token < num_tokens; ++token) {
+            float log_prob = 0.0f;
+            channel.append(0, &token, &log_prob, 1, 0.0f, GenerationFinishReason::NONE);
+            channel.commit();
+        }
+    });
+
+    // copies of a handle may be read from different threads, every push is received once
+    std::vector<std::vector<int64_t>> received(num_consumers);
+    std::vector<std::thread> consumers;
+    for (size_t consumer = 0; consumer < num_consumers; ++consumer) {
+        consumers.emplace_back([&channel, &received, consumer, num_tokens, num_consumers] {
+            for (int64_t i = 0; i < num_tokens / static_cast<int64_t>(num_consumers); ++i) {
+                received[consumer].push_back(channel.read()[0].generated_ids.at(0));
+            }
+        });
+    }
+    producer.join();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::vector<int64_t> all_received;
+    for (const auto& tokens : received) {
+        // each consumer gets the tokens in the order they were pushed
+        EXPECT_TRUE(std::is_sorted(tokens.begin(), tokens.end()));
+        all_received.insert(all_received.end(), tokens.begin(), tokens.end());
+    }
+    std::sort(all_received.begin(), all_received.end());
+    std::vector<int64_t> expected(num_tokens);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(all_received, expected);
+    EXPECT_TRUE(channel.empty());
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include "lora_quantization.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+std::vector<float> get_random_weights(size_t size, float min, float max) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> distribution(min, max);
+    std::vector<float> weights(size);
+    for (float& weight : weights) {
+        weight = distribution(rng);
+    }
+    return weights;
+}
+
+// Checks that every weight is restored by decompression (quantized - zero_point) * scale with the rounding error only
+void check_round_trip(const std::vector<float>& weights, const ov::Tensor& quantized, const ov::Tensor& scale,
+                      const std::function<float(size_t)>& get_zero_point, size_t group_size) {
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const size_t group = i / group_size;
+        const float group_scale = get_element(scale, group);
+        const float restored = (get_element(quantized, i) - get_zero_point(group)) * group_scale;
+        EXPECT_LE(std::abs(restored - weights[i]), group_scale / 2 + 1e-6f) << "element " << i;
+    }
+}
+
+}  // namespace
+
+TEST(TestLoRAQuantization, QuantizesWithZeroPointPerGroup) {
+    const size_t num_groups = 3, group_size = 16;
+    std::vector<float> weights = get_random_weights(num_groups * group_size, -0.5f, 2.0f);
+    ov::Tensor quantized(ov::element::u8, {num_groups, group_size});
+    ov::Tensor scale(ov::element::f32, {num_groups, 1});
+    ov::Tensor zero_point(ov::element::u8, {num_groups, 1});
+
+    quantize_weights(weights.data(), quantized, scale, &zero_point, 0.0f);
+
+    for (size_t group = 0; group < num_groups; ++group) {
+        auto [min, max] = std::minmax_element(weights.begin() + group * group_size, weights.begin() + (group + 1) * group_size);
+        const float expected_scale = (*max - *min) / 255.0f;
+        EXPECT_FLOAT_EQ(get_element(scale, group), expected_scale);
+        EXPECT_EQ(get_element(zero_point, group), std::round(-*min / expected_scale));
+    }
+    check_round_trip(weights, quantized, scale, [&zero_point](size_t group) { return get_element(zero_point, group); }, group_size);
+}
+
+TEST(TestLoRAQuantization, QuantizesSymmetricallyAroundFixedZeroPoint) {
+    const size_t num_groups = 4, group_size = 8;
+    std::vector<float> weights = get_random_weights(num_groups * group_size, -1.0f, 1.0f);
+    ov::Tensor quantized(ov::element::u4, {num_groups, group_size});
+    ov::Tensor scale(ov::element::f16, {num_groups, 1});
+
+    const float fixed_zero_point = 8.0f;
+    quantize_weights(weights.data(), quantized, scale, nullptr, fixed_zero_point);
+
+    for (size_t group = 0; group < num_groups; ++group) {
+        auto [min, max] = std::minmax_element(weights.begin() + group * group_size, weights.begin() + (group + 1) * group_size);
+        // u4 range [0, 15] around zero point 8 fits 7 steps up and 8 steps down
+        const float expected_scale = std::max(*max / 7.0f, *min / -8.0f);
+        EXPECT_NEAR(get_element(scale, group), expected_scale, expected_scale * 1e-3f);
+    }
+    check_round_trip(weights, quantized, scale, [fixed_zero_point](size_t) { return fixed_zero_point; }, group_size);
+}
+
+TEST(TestLoRAQuantization, BroadcastsScaleOverLeadingDimensions) {
+    // i8 weights of shape [2, 3] with a scale per column
+    std::vector<float> weights = {-1.0f, 0.5f, 2.0f,
+                                   0.5f, -0.25f, -4.0f};
+    ov::Tensor quantized(ov::element::i8, {2, 3});
+    ov::Tensor scale(ov::element::f32, {3});
+
+    quantize_weights(weights.data(), quantized, scale, nullptr, 0.0f);
+
+    EXPECT_FLOAT_EQ(get_element(scale, 0), 1.0f / 128.0f);
+    EXPECT_FLOAT_EQ(get_element(scale, 1), 0.5f / 127.0f);
+    EXPECT_FLOAT_EQ(get_element(scale, 2), 4.0f / 128.0f);
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const float column_scale = get_element(scale, i % 3);
+        EXPECT_LE(std::abs(get_element(quantized, i) * column_scale - weights[i]), column_scale / 2 + 1e-6f) << "element " << i;
+    }
+}
+
+TEST(TestLoRAQuantization, ThrowsOnNotSupportedType) {
+    std::vector<float> weights(4, 1.0f);
+    ov::Tensor quantized(ov::element::f16, {4});
+    ov::Tensor scale(ov::element::f32, {1});
+    EXPECT_THROW(quantize_weights(weights.data(), quantized, scale, nullptr, 0.0f), ov::Exception);
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <random>
+#include "prompt_lookup/ngram_index.hpp"
+
+using namespace ov::genai;
+
+TEST(TestNgramIndex, ProposesContinuationOfLongestSuffix) {
+    NgramIndex index(3);
+    // "1 2 3" is followed by 4 5, while "2 3" alone is also followed by 9
+    index.append({1, 2, 3, 4, 5, 7, 2, 3, 9, 1, 2, 3});
+    EXPECT_EQ(index.propose(2), std::vector<int64_t>({4, 5}));
+    EXPECT_EQ(index.propose(100), std::vector<int64_t>({4, 5, 7, 2, 3, 9, 1, 2, 3}));
+}
+
+TEST(TestNgramIndex, PrefersLatestOccurrence) {
+    NgramIndex index(2);
+    index.append({5, 1, 5, 2, 5});
+    EXPECT_EQ(index.propose(1), std::vector<int64_t>({2}));
+    index.append(2);
+    // "5 2" occurred once before, so its continuation is proposed
+    EXPECT_EQ(index.propose(3), std::vector<int64_t>({5, 2}));
+}
+
+TEST(TestNgramIndex, ReturnsEmptyWithoutMatch) {
+    NgramIndex index(3);
+    EXPECT_TRUE(index.propose(5).empty());
+    index.append({1, 2, 3});
+    EXPECT_TRUE(index.propose(5).empty());
+    // the suffix must not match itself
+    index.append(4);
+    EXPECT_TRUE(index.propose(5).empty());
+}
+
+TEST(TestNgramIndex, MatchesNaiveSearch) {
+    std::vector<int64_t> tokens;
+    NgramIndex index(3);
+    std::mt19937 rng(7);
+    for (size_t step = 0; step < 500; ++step) {
+        int64_t token_id = rng() % 6;
+        tokens.push_back(token_id);
+        index.append(token_id);
+
+        // the latest earlier occurrence of the longest suffix
+        std::vector<int64_t> expected;
+        for (size_t ngram_size = std::min<size_t>(3, tokens.size() - 1); ngram_size > 0 && expected.empty(); --ngram_size) {
+            for (size_t end = tokens.size() - 1; end >= ngram_size; --end) {
+                if (std::equal(tokens.end() - ngram_size, tokens.end(), tokens.begin() + (end - ngram_size))) {
+                    expected.assign(tokens.begin() + end, tokens.begin() + std::min(end + 4, tokens.size()));
+                    break;
+                }
+            }
+        }
+        ASSERT_EQ(index.propose(4), expected) << step;
+    }
+}
+
+TEST(TestNgramIndex, ProposesDistinctBranches) {
+    NgramIndex index(2);
+    // "1 2" is followed by 3 and by 4, "2" alone is also followed by 5
+    index.append({1, 2, 3, 1, 2, 4, 2, 5, 1, 2});
+    EXPECT_EQ(index.propose_branches(2, 4), (std::vector<std::vector<int64_t>>{{4, 2}, {3, 1}, {5, 1}}));
+    EXPECT_EQ(index.propose_branches(1, 2), (std::vector<std::vector<int64_t>>{{4}, {3}}));
+    // continuations which are equal are proposed once
+    EXPECT_EQ(index.propose_branches(1, 4), (std::vector<std::vector<int64_t>>{{4}, {3}, {5}}));
+    EXPECT_EQ(index.propose_branches(2, 1).front(), index.propose(2));
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "prompt_lookup/continuous_batching_for_prompt_lookup.hpp"
+
+class CBForPromptLookupTest : public testing::Test, public ov::genai::ContinuousBatchingPipeline {
+protected:
+    class PipelineTestInstance : public ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl {
+    public:
+        PipelineTestInstance() {
+            m_sampler = std::make_shared<ov::genai::Sampler>();
+            m_scheduler = std::make_shared<ov::genai::Scheduler>(32);
+        };
+
+        // adds a request with the processed prompt and the generated tokens
+        ov::genai::SequenceGroup::Ptr
+        add_request(uint64_t request_id, std::vector<int64_t> prompt, const std::vector<int64_t>& generated_ids,
+                    const ov::genai::GenerationConfig& sampling_params) {
+            ov::Tensor input_ids(ov::element::i64, ov::Shape{1, prompt.size()}, prompt.data());
+            ov::genai::SequenceGroup::Ptr sequence_group = std::make_shared<ov::genai::SequenceGroup>(request_id, input_ids,
+                                                                                sampling_params,
+                                                                                32,
+                                                                                false);
+            sequence_group->set_sequence_group_ptr(sequence_group);
+            sequence_group->update_processed_tokens_num(prompt.size());
+            for (int64_t token_id : generated_ids) {
+                sequence_group->get_running_sequences().front()->append_token(token_id, 0.0f);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+                m_awaiting_requests.push_back(sequence_group);
+            }
+            pull_awaiting_requests();
+            return sequence_group;
+        };
+    };
+
+    static ov::genai::GenerationConfig get_prompt_lookup_config(size_t num_assistant_tokens, size_t max_new_tokens) {
+        ov::genai::GenerationConfig config = ov::genai::greedy();
+        config.max_ngram_size = 2;
+        config.num_assistant_tokens = num_assistant_tokens;
+        config.max_new_tokens = max_new_tokens;
+        return config;
+    }
+
+    PipelineTestInstance m_pipeline = PipelineTestInstance();
+    // the generated token 3 completes the n-gram "2 3", which is followed by 4 5 1 in the prompt
+    const std::vector<int64_t> m_prompt = {5, 1, 2, 3, 4, 5, 1, 2};
+};
+
+TEST_F(CBForPromptLookupTest, ProposesNumAssistantTokensCandidates) {
+    auto request = m_pipeline.add_request(0, m_prompt, {3}, get_prompt_lookup_config(3, 100));
+    m_pipeline.generate_candidates();
+
+    EXPECT_EQ(request->get_num_tokens_to_validate(), 3);
+    EXPECT_EQ(request->get_running_sequences().front()->get_generated_ids(), std::vector<int64_t>({3, 4, 5, 1}));
+}
+
+TEST_F(CBForPromptLookupTest, ProposesSingleCandidate) {
+    auto request = m_pipeline.add_request(0, m_prompt, {3}, get_prompt_lookup_config(1, 100));
+    m_pipeline.generate_candidates();
+
+    EXPECT_EQ(request->get_num_tokens_to_validate(), 1);
+    EXPECT_EQ(request->get_running_sequences().front()->get_generated_ids(), std::vector<int64_t>({3, 4}));
+}
+
+TEST_F(CBForPromptLookupTest, LimitsCandidatesByMaxNewTokens) {
+    // one of the remaining 3 tokens is generated by the model after the candidates
+    auto request = m_pipeline.add_request(0, m_prompt, {3}, get_prompt_lookup_config(5, 4));
+    m_pipeline.generate_candidates();
+    EXPECT_EQ(request->get_num_tokens_to_validate(), 2);
+
+    auto last_token_request = m_pipeline.add_request(1, m_prompt, {3}, get_prompt_lookup_config(5, 2));
+    m_pipeline.generate_candidates();
+    EXPECT_EQ(last_token_request->get_num_tokens_to_validate(), 0);
+    EXPECT_EQ(last_token_request->get_running_sequences().front()->get_generated_ids(), std::vector<int64_t>({3}));
+}
@@ -121,6 +121,61 @@ TEST(SamplerValidationMode, gen_phase_to_cut_part_seq) {
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
 
+TEST(SamplerValidationMode, gen_phase_keeps_longest_branch) {
+    auto sampling_config = ov::genai::greedy();
+    // create sequence group with prompt [0, 1, 2, 3, 4]
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    auto sequence_group = std::make_shared<SequenceGroup>(0, input_tensor, sampling_config, 32, false);
+    sequence_group->set_sequence_group_ptr(sequence_group);
+    std::vector<SequenceGroup::Ptr> sequence_groups{sequence_group};
+
+    // to emulate processed prompt and add next token [ 0 ]
+    Sequence::Ptr sequence = sequence_group->get_sequences().front();
+    sequence->append_token(0, 1.f);
+    sequence_group->update_processed_tokens_num(5);
+
+    // append candidates [ 1, 2, 2 ] and alternative branch [ 1, 2, 3 ]
+    Sequence::Ptr branch = sequence_group->fork_sequence(sequence);
+    for (int64_t token_id : {1, 2, 2}) {
+        sequence->append_token(token_id, 1.f);
+    }
+    for (int64_t token_id : {1, 2, 3}) {
+        branch->append_token(token_id, 1.f);
+    }
+
+    size_t num_validated_tokens = 3;
+    sequence_group->set_num_validated_tokens(num_validated_tokens);
+    sequence_group->schedule_tokens(sequence_group->get_num_available_tokens_for_batching());
+
+    // create ref tensor : to generate candidates + next token for both branches
+    std::vector<float> logits = {
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+    };
+
+    // shape 2 sequences * 4 tokens + 1 batch + 5 vocab
+    ov::Tensor gen_input_ids(ov::element::f32, ov::Shape{8, 1, 5}, logits.data());
+
+    Sampler sampler;
+    SamplerOutput sampler_output = sampler.sample(sequence_groups, gen_input_ids, true);
+
+    // all candidates of the branch are accepted, so it replaces the sequence
+    ASSERT_EQ(sequence_group->num_total_seqs(), 1);
+    Sequence::Ptr kept = sequence_group->get_sequences().front();
+    ASSERT_EQ(kept->get_id(), branch->get_id());
+    ASSERT_EQ(kept->get_grouped_id(), 0);
+    ASSERT_EQ(kept->get_generated_ids(), TokenIds({0, 1, 2, 3, 4}));
+    ASSERT_EQ(sampler_output.m_dropped_sequences, std::vector<uint64_t>{sequence->get_id()});
+    ASSERT_EQ(sequence_group->get_num_processed_tokens(), 9);
+}
+
 TEST(SamplerValidationMode, gen_phase) {
     auto sampling_config = ov::genai::greedy();
     // create sequence group with prompt [0, 1, 2, 3, 4]
@@ -300,3 +355,40 @@ TEST(SamplerValidationMode, prompt_phase) {
              expected{0, 1, 2, 3};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
+
+TEST(SamplerLogSoftmaxTopK, matches_sorted_log_softmax) {
+    const size_t vocab_size = 1000;
+    std::vector<float> logits(vocab_size);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> distribution(0.0f, 5.0f);
+    for (float& logit : logits)
+        logit = distribution(rng);
+    logits[vocab_size - 1] = 30.0f;  // the maximum is in the last incomplete block
+
+    std::vector<Token> all_tokens = log_softmax(ov::Tensor(ov::element::f32, ov::Shape{1, 1, vocab_size}, logits.data()), 0);
+    std::vector<Token> expected = all_tokens;
+    std::sort(expected.begin(), expected.end(), [](const Token& left, const Token& right) {
+        return left.m_log_prob > right.m_log_prob;
+    });
+
+    float log_norm = 0.0f;
+    std::vector<Token> actual = log_softmax_top_k(logits.data(), vocab_size, 8, log_norm);
+    ASSERT_EQ(actual.size(), 8);
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].m_index, expected[i].m_index);
+        EXPECT_NEAR(actual[i].m_log_prob, expected[i].m_log_prob, 1e-4);
+    }
+    // log probs of tokens outside of top k are restored from the log norm
+    EXPECT_NEAR(logits[17] - log_norm, all_tokens[17].m_log_prob, 1e-4);
+}
+
+TEST(SamplerLogSoftmaxTopK, top_k_exceeds_vocab_size) {
+    std::vector<float> logits = {0.0f, 2.0f, 1.0f};
+    float log_norm = 0.0f;
+    std::vector<Token> actual = log_softmax_top_k(logits.data(), logits.size(), 5, log_norm);
+    ASSERT_EQ(actual.size(), 3);
+    EXPECT_EQ(actual[0].m_index, 1);
+    EXPECT_EQ(actual[1].m_index, 2);
+    EXPECT_EQ(actual[2].m_index, 0);
+    EXPECT_NEAR(log_norm, std::log(std::exp(0.0f) + std::exp(2.0f) + std::exp(1.0f)), 1e-5);
+}
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <string>
+#include "size_bounded_lru_cache.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+using Cache = SizeBoundedLRUCache<std::string, int>;
+
+auto equal_to(const std::string& key) {
+    return [key](const std::string& cached_key) { return cached_key == key; };
+}
+
+}  // namespace
+
+TEST(TestSizeBoundedLRUCache, FindsInsertedItems) {
+    Cache cache;
+    EXPECT_EQ(cache.find_if(equal_to("a")), nullptr);
+    EXPECT_EQ(cache.front(), nullptr);
+
+    cache.insert("a", 1, 10, 100);
+    cache.insert("b", 2, 10, 100);
+    ASSERT_NE(cache.find_if(equal_to("a")), nullptr);
+    EXPECT_EQ(cache.find_if(equal_to("a"))->value, 1);
+    // a hit makes the item the most recently used one
+    EXPECT_EQ(cache.front()->key, "a");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.get_byte_size(), 20);
+}
+
+TEST(TestSizeBoundedLRUCache, EvictsLeastRecentlyUsedItems) {
+    Cache cache;
+    cache.insert("a", 1, 10, 25);
+    cache.insert("b", 2, 10, 25);
+    // "a" is used after "b", so "b" is evicted by "c"
+    cache.find_if(equal_to("a"));
+    cache.insert("c", 3, 10, 25);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.get_byte_size(), 20);
+    EXPECT_EQ(cache.find_if(equal_to("b")), nullptr);
+    EXPECT_NE(cache.find_if(equal_to("a")), nullptr);
+    EXPECT_NE(cache.find_if(equal_to("c")), nullptr);
+}
+
+TEST(TestSizeBoundedLRUCache, KeepsLastInsertedItemWithZeroBudget) {
+    Cache cache;
+    cache.insert("a", 1, 10, 0);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.front()->key, "a");
+
+    cache.insert("b", 2, 10, 0);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.get_byte_size(), 10);
+    EXPECT_EQ(cache.find_if(equal_to("a")), nullptr);
+    EXPECT_EQ(cache.front()->key, "b");
+}
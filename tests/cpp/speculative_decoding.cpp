@@ -11,6 +11,8 @@ protected:
     public:
         PipelineTestInstance() {
             m_sampler = std::make_shared<ov::genai::Sampler>();
+            // awaiting requests are pulled by the scheduler's thread, which restores cached blocks and sessions
+            m_scheduler = std::make_shared<ov::genai::Scheduler>(32);
         };
 
         ov::genai::GenerationHandle
@@ -0,0 +1,145 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "structured_output/regex_dfa.hpp"
+#include "structured_output/schema_to_regex.hpp"
+#include "structured_output/token_automaton.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+bool matches(const RegexDFA& dfa, const std::string& text) {
+    int32_t state = dfa.get_initial_state();
+    for (char c : text) {
+        state = dfa.next(state, static_cast<uint8_t>(c));
+        if (state == RegexDFA::DEAD_STATE)
+            return false;
+    }
+    return dfa.is_accepting(state);
+}
+
+bool is_allowed(const TokenAutomaton::Mask& mask, int64_t token_id) {
+    return (mask[token_id / 64] >> (token_id % 64)) & 1;
+}
+
+}  // namespace
+
+TEST(TestRegexDFA, MatchesWholeText) {
+    RegexDFA dfa("^(ab|c)+[0-9]{2,3}\\.?$");
+    EXPECT_TRUE(matches(dfa, "ab12"));
+    EXPECT_TRUE(matches(dfa, "cab123."));
+    EXPECT_FALSE(matches(dfa, "ab1"));
+    EXPECT_FALSE(matches(dfa, "ab1234"));
+    EXPECT_FALSE(matches(dfa, "12"));
+    EXPECT_FALSE(matches(dfa, "xab12"));
+}
+
+TEST(TestRegexDFA, MatchesCharacterClasses) {
+    RegexDFA dfa("[^a-c\\d][\\w-]*\\s.");
+    EXPECT_TRUE(matches(dfa, "x_-9 z"));
+    EXPECT_TRUE(matches(dfa, "d\t\xd0\xaf"));  // "Я" is a single character
+    EXPECT_FALSE(matches(dfa, "b \n"));
+    EXPECT_FALSE(matches(dfa, "5 z"));
+    EXPECT_FALSE(matches(dfa, "x \n"));
+}
+
+TEST(TestRegexDFA, MatchesNonAsciiRanges) {
+    RegexDFA dfa("[а-я]+");
+    EXPECT_TRUE(matches(dfa, "привет"));
+    EXPECT_FALSE(matches(dfa, "hello"));
+    EXPECT_FALSE(matches(dfa, "\xd0"));
+}
+
+TEST(TestRegexDFA, ThrowsOnInvalidPattern) {
+    EXPECT_THROW(RegexDFA("(ab"), ov::Exception);
+    EXPECT_THROW(RegexDFA("[a-"), ov::Exception);
+    EXPECT_THROW(RegexDFA("a{3,1}"), ov::Exception);
+    EXPECT_THROW(RegexDFA("(?=a)"), ov::Exception);
+}
+
+TEST(TestJsonSchemaToRegex, MatchesValidObjects) {
+    RegexDFA dfa(json_schema_to_regex(R"({
+        "type": "object",
+        "properties": {
+            "name": {"type": "string", "maxLength": 5},
+            "age": {"type": "integer"},
+            "tags": {"type": "array", "items": {"enum": ["a", "b"]}, "maxItems": 2},
+            "ok": {"type": ["boolean", "null"]}
+        },
+        "required": ["name", "age"]
+    })"));
+    EXPECT_TRUE(matches(dfa, R"({"name": "Bob", "age": 42})"));
+    EXPECT_TRUE(matches(dfa, "{\n  \"name\": \"\", \"age\": -1, \"tags\": [\"a\", \"b\"], \"ok\": null\n}"));
+    EXPECT_TRUE(matches(dfa, R"({"name":"x","age":0,"ok":true})"));
+    EXPECT_FALSE(matches(dfa, R"({"name": "Bob"})"));
+    EXPECT_FALSE(matches(dfa, R"({"name": "Robert", "age": 42})"));
+    EXPECT_FALSE(matches(dfa, R"({"name": "Bob", "age": 4.2})"));
+    EXPECT_FALSE(matches(dfa, R"({"name": "Bob", "age": 42, "tags": ["a", "b", "a"]})"));
+    EXPECT_FALSE(matches(dfa, R"({"age": 42, "name": "Bob"})"));
+}
+
+TEST(TestJsonSchemaToRegex, ResolvesReferences) {
+    RegexDFA dfa(json_schema_to_regex(R"({
+        "$defs": {"point": {"type": "object", "properties": {"x": {"type": "number"}}, "required": ["x"]}},
+        "type": "array",
+        "items": {"$ref": "#/$defs/point"},
+        "minItems": 1
+    })"));
+    EXPECT_TRUE(matches(dfa, R"([{"x": 1.5e3}, {"x": 0}])"));
+    EXPECT_FALSE(matches(dfa, "[]"));
+    EXPECT_FALSE(matches(dfa, R"([{"y": 1}])"));
+}
+
+TEST(TestJsonSchemaToRegex, ThrowsOnRecursiveReference) {
+    EXPECT_THROW(json_schema_to_regex(R"({"$defs": {"node": {"type": "array", "items": {"$ref": "#/$defs/node"}}}, "$ref": "#/$defs/node"})"),
+                 ov::Exception);
+}
+
+TEST(TestGrammarToRegex, InlinesRules) {
+    RegexDFA dfa(grammar_to_regex(R"grammar(
+        # a call like move(1, -2)
+        root ::= name "(" args? ")"
+        name ::= [a-z]+
+        args ::= number (", " number)*
+        number ::= "-"? [0-9]+
+    )grammar"));
+    EXPECT_TRUE(matches(dfa, "move(1, -2)"));
+    EXPECT_TRUE(matches(dfa, "stop()"));
+    EXPECT_FALSE(matches(dfa, "move(1,2)"));
+    EXPECT_THROW(grammar_to_regex("root ::= \"(\" root? \")\""), ov::Exception);
+}
+
+TEST(TestTokenAutomaton, MasksTokensByState) {
+    // 0: "{", 1: "}", 2: "{}", 3: " ", 4: "a", 5: special token, 6: " {"
+    auto vocab = std::make_shared<DecodedVocab>(std::vector<std::string>{"{", "}", "{}", " ", "a", "", " {"},
+                                                std::vector<std::string>{"{", "}", "{}", "", "a", "", "{"});
+    TokenAutomaton automaton("\\{a*\\}", vocab);
+
+    int32_t state = automaton.get_initial_state();
+    const TokenAutomaton::Mask& initial = automaton.get_allowed_tokens(state);
+    std::vector<bool> expected_initial = {true, false, true, false, false, false, true};
+    for (int64_t token_id = 0; token_id < 7; ++token_id)
+        EXPECT_EQ(is_allowed(initial, token_id), expected_initial[token_id]) << token_id;
+    EXPECT_FALSE(automaton.is_accepting(state));
+
+    state = automaton.advance(state, 6);
+    const TokenAutomaton::Mask& inner = automaton.get_allowed_tokens(state);
+    std::vector<bool> expected_inner = {false, true, false, false, true, false, false};
+    for (int64_t token_id = 0; token_id < 7; ++token_id)
+        EXPECT_EQ(is_allowed(inner, token_id), expected_inner[token_id]) << token_id;
+
+    state = automaton.advance(automaton.advance(state, 4), 1);
+    EXPECT_TRUE(automaton.is_accepting(state));
+    EXPECT_EQ(automaton.advance(state, 4), TokenAutomaton::DEAD_STATE);
+}
+
+TEST(TestTokenAutomaton, MaskIsCached) {
+    auto vocab = std::make_shared<DecodedVocab>(std::vector<std::string>{"1", "12", "x"});
+    TokenAutomaton automaton("[0-9]+", vocab);
+    const TokenAutomaton::Mask& first = automaton.get_allowed_tokens(automaton.get_initial_state());
+    const TokenAutomaton::Mask& second = automaton.get_allowed_tokens(automaton.get_initial_state());
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first[0], 0b011u);
+}
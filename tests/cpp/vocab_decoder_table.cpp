@@ -0,0 +1,43 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "vocab_decoder_table.hpp"
+
+using ov::genai::VocabDecoderTable;
+using TokenOp = VocabDecoderTable::TokenOp;
+using StringOp = VocabDecoderTable::StringOp;
+
+TEST(TestVocabDecoderTable, byte_level_vocab) {
+    // "Ġ" is the byte-level representation of a space
+    std::vector<std::string> vocab = {"<|endoftext|>", "Hello", "\xc4\xa0world", "!", "\xc5\x82"};
+    VocabDecoderTable table(vocab, {0}, {TokenOp::CHARS_TO_BYTES}, {StringOp::VALIDATE_UTF8});
+
+    std::string result;
+    std::vector<int64_t> tokens = {1, 2, 3, 0};
+    EXPECT_TRUE(table.decode(tokens.data(), tokens.size(), true, result));
+    EXPECT_EQ(result, "Hello world!");
+    EXPECT_TRUE(table.decode(tokens.data(), tokens.size(), false, result));
+    EXPECT_EQ(result, "Hello world!<|endoftext|>");
+
+    // "ł" maps to byte 0xA0 which is not valid UTF-8 on its own
+    std::vector<int64_t> invalid_utf8 = {1, 4};
+    EXPECT_FALSE(table.decode(invalid_utf8.data(), invalid_utf8.size(), true, result));
+
+    std::vector<int64_t> out_of_vocab = {1, 5};
+    EXPECT_FALSE(table.decode(out_of_vocab.data(), out_of_vocab.size(), true, result));
+}
+
+TEST(TestVocabDecoderTable, sentencepiece_vocab) {
+    std::vector<std::string> vocab = {"<unk>", "<s>", "</s>", "\xe2\x96\x81Hello", "<0x0A>", "\xe2\x96\x81world"};
+    VocabDecoderTable table(vocab, {0, 1, 2}, {TokenOp::BYTE_FALLBACK},
+                            {StringOp::REPLACE_SPACE_MARKER, StringOp::STRIP_LEADING_SPACE});
+
+    std::string result;
+    std::vector<int64_t> tokens = {1, 3, 4, 5, 2};
+    EXPECT_TRUE(table.decode(tokens.data(), tokens.size(), true, result));
+    EXPECT_EQ(result, "Hello\n world");
+    EXPECT_TRUE(table.decode(tokens.data(), tokens.size(), false, result));
+    EXPECT_EQ(result, "<s> Hello\n world</s>");
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include "worker_pool.hpp"
+
+using namespace ov::genai;
+
+TEST(TestWorkerPool, RunsTasksInOrderOnSingleWorker) {
+    std::vector<size_t> order;
+    {
+        WorkerPool pool(1);
+        for (size_t i = 0; i < 100; ++i) {
+            pool.submit([&order, i] { order.push_back(i); });
+        }
+    }
+    ASSERT_EQ(order.size(), 100);
+    for (size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(TestWorkerPool, RunsAllTasksBeforeDestruction) {
+    std::atomic<size_t> num_executed{0};
+    {
+        WorkerPool pool(4);
+        for (size_t i = 0; i < 1000; ++i) {
+            pool.submit([&num_executed] { ++num_executed; });
+        }
+    }
+    EXPECT_EQ(num_executed, 1000);
+}
+
+TEST(TestWorkerPool, UnusedPoolIsDestroyed) {
+    WorkerPool pool(4);
+}
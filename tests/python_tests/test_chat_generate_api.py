@@ -133,6 +133,50 @@ def test_chat_compare_statefull_vs_text_history(model_descr, generation_config:
     assert chat_history_ov == chat_history_with_kv_cache
 
 
+# messages are appended to the history as is, so templating of a new message alone gives the same text
+incremental_chat_template = (
+    "{% for message in messages %}<|im_start|>{{ message['role'] }}\n{{ message['content'] }}<|im_end|>\n{% endfor %}"
+    "{% if add_generation_prompt %}<|im_start|>assistant\n{% endif %}"
+)
+# every user message is prefixed by the first one, so a new message can't be templated without the whole history
+non_incremental_chat_template = (
+    "{% for message in messages %}<|im_start|>{{ message['role'] }}\n"
+    "{% if message['role'] == 'user' %}({{ messages[0]['content'] }}) {% endif %}{{ message['content'] }}<|im_end|>\n{% endfor %}"
+    "{% if add_generation_prompt %}<|im_start|>assistant\n{% endif %}"
+)
+
+
+@pytest.mark.parametrize("chat_template", [incremental_chat_template, non_incremental_chat_template])
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_chat_compare_statefull_vs_text_history_with_chat_template(chat_template):
+    # Incremental templates are tokenized by new messages, the rest fall back to re-tokenization of the whole history,
+    # both have to give the same prompt as the text history.
+    generation_config = dict(do_sample=False, max_new_tokens=20)
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'), add_special_tokens=False)
+    pipe_with_kv_cache = ov_genai.LLMPipeline(path, 'CPU', **{"ENABLE_MMAP": False})
+    pipe_with_kv_cache.get_tokenizer().set_chat_template(chat_template)
+    text_history_tokenizer = ov_genai.Tokenizer(path)
+    text_history_tokenizer.set_chat_template(chat_template)
+
+    chat_history_with_kv_cache = []
+    chat_history_ov = []
+    pipe_with_kv_cache.start_chat()
+    for question in quenstions:
+        chat_history_with_kv_cache.append({'role': 'user', 'content': question})
+        answer = pipe_with_kv_cache.generate(question, **generation_config)
+        chat_history_with_kv_cache.append({'role': 'assistant', 'content': answer})
+
+        chat_history_ov.append({'role': 'user', 'content': question})
+        prompt = text_history_tokenizer.apply_chat_template(chat_history_ov, add_generation_prompt=True)
+        answer = pipe.generate(prompt, **generation_config)
+        chat_history_ov.append({'role': 'assistant', 'content': answer})
+    pipe_with_kv_cache.finish_chat()
+
+    assert chat_history_ov == chat_history_with_kv_cache
+
+
 conversation = [
     {'role': 'user', 'content': '1+1='},
     {'role': 'assistant', 'content': '1 + 1 = 2'},
@@ -192,6 +236,114 @@ def test_set_chat_template():
     reference = pipe.generate("a", max_new_tokens=1)
     assert generated == reference
 
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_set_chat_template_is_not_shared_between_tokenizers():
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'))
+    # both tokenizers reuse the same compiled models
+    first = ov_genai.Tokenizer(path)
+    second = ov_genai.Tokenizer(path)
+    history = [{'role': 'user', 'content': 'a'}]
+    reference = second.apply_chat_template(history, add_generation_prompt=True)
+
+    first.set_chat_template("{% for message in messages %}{{ message['content'] }}{% endfor %}")
+    assert first.apply_chat_template(history, add_generation_prompt=True) == 'a'
+    assert second.apply_chat_template(history, add_generation_prompt=True) == reference
+    # a tokenizer loaded later starts with the template from tokenizer_config.json
+    assert ov_genai.Tokenizer(path).apply_chat_template(history, add_generation_prompt=True) == reference
+
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_chat_history_compaction_keeps_kv_cache_bounded(tmp_path):
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'))
+    max_chat_history_tokens = 64
+    pipe = ov_genai.LLMPipeline(path, 'CPU', max_chat_history_tokens=max_chat_history_tokens)
+
+    # Saved chat state is dominated by KV cache, so its size follows KV cache length
+    state_sizes = []
+    pipe.start_chat()
+    for turn in range(16):
+        pipe.generate(quenstions[turn % len(quenstions)], max_new_tokens=10)
+        state_path = tmp_path / f"chat_state_{turn}.bin"
+        pipe.save_chat_state(state_path)
+        state_sizes.append(state_path.stat().st_size)
+    pipe.finish_chat()
+
+    # Without compaction KV cache grows by every turn and exceeds max_chat_history_tokens several times
+    assert max(state_sizes) < 3 * state_sizes[0]
+
+
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_chat_history_compaction_rejects_model_without_rope(tmp_path):
+    import json
+    import shutil
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'))
+    models_path = tmp_path / 'model'
+    shutil.copytree(path, models_path)
+    config = json.loads((models_path / 'config.json').read_text())
+    del config['rope_theta']
+    (models_path / 'config.json').write_text(json.dumps(config))
+
+    # kept keys can't be re-rotated without rotary embedding parameters
+    with pytest.raises(RuntimeError):
+        ov_genai.LLMPipeline(models_path, 'CPU', max_chat_history_tokens=64)
+    ov_genai.LLMPipeline(models_path, 'CPU')
+
+
+@pytest.mark.parametrize("generation_config", configs)
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_chat_state_save_load(tmp_path, generation_config: Dict):
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'))
+    state_path = tmp_path / "chat_state.bin"
+
+    pipe.start_chat()
+    for prompt in quenstions[:2]:
+        pipe.generate(prompt, **generation_config)
+    pipe.save_chat_state(state_path)
+    reference = [pipe.generate(prompt, **generation_config) for prompt in quenstions[2:]]
+    pipe.finish_chat()
+
+    # chat is resumed by a pipeline which hasn't seen its previous turns
+    resumed_pipe = ov_genai.LLMPipeline(path, 'CPU')
+    resumed_pipe.load_chat_state(state_path)
+    answers = [resumed_pipe.generate(prompt, **generation_config) for prompt in quenstions[2:]]
+    resumed_pipe.finish_chat()
+
+    assert answers == reference
+
+
+@pytest.mark.precommit
+@pytest.mark.nightly
+def test_chat_state_load_rejects_invalid_stream(tmp_path):
+    model_descr = get_chat_models_list()[0]
+    model_id, path, tokenizer, model_opt, pipe = read_model((model_descr[0], model_descr[1] / '_test_chat'))
+    state_path = tmp_path / "chat_state.bin"
+
+    state_path.write_bytes(b"NOT_A_CHAT_STATE_FILE")
+    with pytest.raises(RuntimeError, match="Stream doesn't contain chat state"):
+        pipe.load_chat_state(state_path)
+
+    pipe.start_chat()
+    pipe.generate(quenstions[0], max_new_tokens=5)
+    pipe.save_chat_state(state_path)
+    pipe.finish_chat()
+
+    # version follows the null-terminated magic as uint32
+    state = bytearray(state_path.read_bytes())
+    version_offset = len(b"OVGENAI_CHAT_STATE") + 1
+    assert int.from_bytes(state[version_offset:version_offset + 4], "little") == 1
+    state[version_offset:version_offset + 4] = (2).to_bytes(4, "little")
+    state_path.write_bytes(bytes(state))
+    with pytest.raises(RuntimeError, match="Unsupported chat state version 2"):
+        pipe.load_chat_state(state_path)
+
+
 prompts = [
     '1+1=',
     'What is the previous answer?',
@@ -223,6 +223,43 @@ def test_genai_tokenizer_decode(model_descr, encoded_prompt):
         assert decoded_hf == decoded_ov
 
 
+@pytest.mark.parametrize("model_descr", get_models_list())
+@pytest.mark.precommit
+def test_pipeline_with_tokenization_cache(model_descr):
+    model_id, path, tokenizer, model, pipe = read_model(model_descr)
+    prompt = 'table is made of'
+    reference = pipe.generate(prompt, max_new_tokens=10)
+
+    # the property is applied to the tokenizer created by the pipeline rather than passed to the model
+    cached_pipe = ov_genai.LLMPipeline(path, 'CPU', tokenization_cache_size=16)
+    for _ in range(2):
+        assert cached_pipe.generate(prompt, max_new_tokens=10) == reference
+
+
+@pytest.mark.parametrize("model_descr", get_models_list())
+@pytest.mark.precommit
+def test_genai_tokenizer_decode_alternating_vocab_table_and_detokenizer(model_descr):
+    model_id, path, tokenizer, model, pipe = read_model(model_descr)
+    tok = pipe.get_tokenizer()
+    special_token_id = tokenizer.eos_token_id
+    # valid text is decoded by the vocabulary table
+    text_ids = tokenizer.encode("Hello world", add_special_tokens=False) + [special_token_id]
+    # a part of a multi-byte character isn't valid UTF-8, so it's decoded by the detokenizer model
+    partial_ids = tokenizer.encode("\U0002070e", add_special_tokens=False)[:-1] + [special_token_id]
+
+    references = {}
+    for ids in [text_ids, partial_ids]:
+        for skip_special_tokens in [True, False]:
+            references[(tuple(ids), skip_special_tokens)] = tok.decode(ids, skip_special_tokens=skip_special_tokens)
+    assert references[(tuple(text_ids), True)] == tokenizer.decode(text_ids, skip_special_tokens=True)
+
+    # both paths update the remembered skip_special_tokens, so alternating them gives the same results in any order
+    for skip_special_tokens in [False, True, True, False]:
+        for ids in [text_ids, partial_ids, text_ids]:
+            assert tok.decode(ids, skip_special_tokens=skip_special_tokens) == references[(tuple(ids), skip_special_tokens)]
+            assert tok.decode([ids, ids], skip_special_tokens=skip_special_tokens) == [references[(tuple(ids), skip_special_tokens)]] * 2
+
+
 test_configs = [
     dict(max_new_tokens=20),
     dict(max_new_tokens=200, ignore_eos=True),
@@ -5,9 +5,10 @@ import sys
 import pytest
 import shutil
 import sys
+import threading
 from dataclasses import dataclass
 from pathlib import Path
-from openvino_genai import ContinuousBatchingPipeline, GenerationConfig, Tokenizer
+from openvino_genai import BatchedTextStreamer, ContinuousBatchingPipeline, GenerationConfig, Tokenizer
 from typing import List, TypedDict
 
 from common import run_test_pipeline, get_models_list, get_model_and_tokenizer, save_ov_model_from_optimum, \
@@ -398,3 +399,197 @@ def test_post_oom_health(tmp_path, sampling_config):
     output = pipe.generate(["What is OpenVINO?"], generation_configs)
     assert (len(output))
     assert(len(output[0].m_generation_ids))
+
+
+@pytest.mark.precommit
+def test_add_request_concurrently_with_step(tmp_path):
+    generation_config = get_greedy()
+    generation_config.max_new_tokens = 10
+    model_id : str = "facebook/opt-125m"
+    model, hf_tokenizer = get_model_and_tokenizer(model_id, use_optimum=True)
+
+    models_path : Path = tmp_path / model_id
+    save_ov_model_from_optimum(model, hf_tokenizer, models_path)
+
+    prompts = ["What is OpenVINO?", "Tell me something about Canada", "How are you?", "1 2 3 4 5"] * 4
+    pipe = ContinuousBatchingPipeline(models_path.absolute().as_posix(), Tokenizer(models_path.absolute().as_posix()), get_scheduler_config(), "CPU", {})
+    reference_results = pipe.generate(prompts, [generation_config] * len(prompts))
+
+    # prompts are tokenized by the pipeline asynchronously, while step() is called from the main thread
+    handles = [None] * len(prompts)
+    def add_requests(first_request_id, num_threads):
+        for request_id in range(first_request_id, len(prompts), num_threads):
+            handles[request_id] = pipe.add_request(request_id, prompts[request_id], generation_config)
+
+    num_threads = 2
+    threads = [threading.Thread(target=add_requests, args=(thread_id, num_threads)) for thread_id in range(num_threads)]
+    for thread in threads:
+        thread.start()
+    while any(thread.is_alive() for thread in threads) or pipe.has_non_finished_requests():
+        pipe.step()
+    for thread in threads:
+        thread.join()
+
+    tokenizer = pipe.get_tokenizer()
+    for handle, reference_result in zip(handles, reference_results):
+        outputs = handle.read_all()
+        assert len(outputs) == 1
+        assert tokenizer.decode(outputs[0].generated_ids) == reference_result.m_generation_ids[0]
+
+
+@pytest.mark.precommit
+@pytest.mark.parametrize("get_generation_config", [get_greedy, get_beam_search, get_multinomial_temperature_and_num_return_sequence])
+def test_batched_text_streamer(tmp_path, get_generation_config):
+    generation_config = get_generation_config()
+    generation_config.max_new_tokens = 10
+    model_id : str = "facebook/opt-125m"
+    model, hf_tokenizer = get_model_and_tokenizer(model_id, use_optimum=True)
+
+    models_path : Path = tmp_path / model_id
+    save_ov_model_from_optimum(model, hf_tokenizer, models_path)
+
+    prompts = ["What is OpenVINO?", "Tell me something about Canada", "How are you?"]
+    pipe = ContinuousBatchingPipeline(models_path.absolute().as_posix(), Tokenizer(models_path.absolute().as_posix()), get_scheduler_config(), "CPU", {})
+
+    streamed_texts = {}
+    finished_sequences = set()
+    def callback(texts):
+        for streamed in texts:
+            key = (streamed.request_id, streamed.sequence_id)
+            assert key not in finished_sequences
+            streamed_texts[key] = streamed_texts.get(key, "") + streamed.text
+            if streamed.finished:
+                finished_sequences.add(key)
+        return False
+
+    pipe.set_batched_streamer(BatchedTextStreamer(pipe.get_tokenizer(), callback))
+    results = pipe.generate(prompts, [generation_config] * len(prompts))
+
+    assert finished_sequences == set(streamed_texts.keys())
+    for request_id, result in enumerate(results):
+        request_texts = [text for (streamed_request_id, _), text in streamed_texts.items() if streamed_request_id == request_id]
+        assert sorted(request_texts) == sorted(result.m_generation_ids)
+
+
+@pytest.mark.precommit
+@pytest.mark.parametrize("async_detokenization", [False, True])
+def test_streamer_with_async_detokenization(tmp_path, async_detokenization):
+    generation_config = get_greedy()
+    generation_config.max_new_tokens = 10
+    model_id : str = "facebook/opt-125m"
+    model, hf_tokenizer = get_model_and_tokenizer(model_id, use_optimum=True)
+
+    models_path : Path = tmp_path / model_id
+    save_ov_model_from_optimum(model, hf_tokenizer, models_path)
+
+    pipe = ContinuousBatchingPipeline(models_path.absolute().as_posix(), Tokenizer(models_path.absolute().as_posix()), get_scheduler_config(), "CPU",
+                                      {"async_detokenization": async_detokenization})
+    prompts = ["What is OpenVINO?"]
+
+    streamed_text = []
+    def callback(text):
+        streamed_text.append(text)
+        return False
+    results = pipe.generate(prompts, [generation_config], callback)
+    assert "".join(streamed_text) == results[0].m_generation_ids[0]
+
+    num_callback_calls = 0
+    def stop_callback(text):
+        nonlocal num_callback_calls
+        num_callback_calls += 1
+        return True
+    stopped_results = pipe.generate(prompts, [generation_config], stop_callback)
+    stopped_text = stopped_results[0].m_generation_ids[0]
+    assert results[0].m_generation_ids[0].startswith(stopped_text)
+    assert len(stopped_text) < len(results[0].m_generation_ids[0])
+    # the callback isn't called after it requested to stop
+    assert num_callback_calls == 1
+
+
+@pytest.mark.precommit
+def test_chat_session_continues_after_dropped_turn(tmp_path):
+    generation_config = get_greedy()
+    generation_config.max_new_tokens = 10
+    model_id : str = "facebook/opt-125m"
+    model, hf_tokenizer = get_model_and_tokenizer(model_id, use_optimum=True)
+
+    models_path : Path = tmp_path / model_id
+    save_ov_model_from_optimum(model, hf_tokenizer, models_path)
+
+    tokenizer = Tokenizer(models_path.absolute().as_posix())
+    tokenizer.set_chat_template("{% for message in messages %}{{ message['role'] }}: {{ message['content'] }}\n{% endfor %}")
+    pipe = ContinuousBatchingPipeline(models_path.absolute().as_posix(), tokenizer, get_scheduler_config(), "CPU", {})
+
+    def run_turn(request_id, session_id, message):
+        handle = pipe.add_session_request(request_id, session_id, message, generation_config)
+        while pipe.has_non_finished_requests():
+            pipe.step()
+        return handle
+
+    reference_session_id = pipe.open_chat_session()
+    reference_outputs = run_turn(0, reference_session_id, "How are you?").read_all()
+    pipe.close_chat_session(reference_session_id)
+
+    # the batched streamer stops generation in the middle of the first turn
+    from openvino_genai.py_openvino_genai import GenerationStatus
+    pipe.set_batched_streamer(BatchedTextStreamer(pipe.get_tokenizer(), lambda texts: True))
+    session_id = pipe.open_chat_session()
+    dropped_handle = run_turn(1, session_id, "What is OpenVINO?")
+    assert dropped_handle.get_status() == GenerationStatus.DROPPED_BY_PIPELINE
+
+    # the dropped turn is not a part of the session history, so the next turn matches a new session
+    pipe.set_batched_streamer(BatchedTextStreamer(pipe.get_tokenizer(), lambda texts: False))
+    outputs = run_turn(2, session_id, "How are you?").read_all()
+    assert [output.generated_ids for output in outputs] == [output.generated_ids for output in reference_outputs]
+    pipe.close_chat_session(session_id)
+
+
+def save_random_lora_adapter(path: Path, num_layers: int, hidden_size: int, rank: int, seed: int):
+    import torch
+    from safetensors.torch import save_file
+    generator = torch.Generator().manual_seed(seed)
+    tensors = {}
+    for layer in range(num_layers):
+        for projection in ["q_proj", "v_proj"]:
+            name = f"base_model.model.model.decoder.layers.{layer}.self_attn.{projection}"
+            tensors[f"{name}.lora_A.weight"] = torch.randn(rank, hidden_size, generator=generator)
+            tensors[f"{name}.lora_B.weight"] = torch.randn(hidden_size, rank, generator=generator)
+    save_file(tensors, path)
+
+
+@pytest.mark.precommit
+def test_mixed_adapters_batch(tmp_path):
+    from openvino_genai import Adapter, AdapterConfig
+    model_id : str = "facebook/opt-125m"
+    model, hf_tokenizer = get_model_and_tokenizer(model_id, use_optimum=True)
+
+    models_path : Path = tmp_path / model_id
+    save_ov_model_from_optimum(model, hf_tokenizer, models_path)
+
+    adapters = []
+    for seed in range(2):
+        adapter_path = tmp_path / f"adapter_{seed}.safetensors"
+        save_random_lora_adapter(adapter_path, model.config.num_hidden_layers, model.config.hidden_size, rank=4, seed=seed)
+        adapters.append(Adapter(adapter_path))
+
+    generation_configs = []
+    for adapter_config in [None, AdapterConfig(adapters[0]), AdapterConfig(adapters[1]), AdapterConfig(adapters[0], 0.5), AdapterConfig(adapters)]:
+        generation_config = get_greedy()
+        generation_config.max_new_tokens = 10
+        if adapter_config is not None:
+            generation_config.adapters = adapter_config
+        generation_configs.append(generation_config)
+    prompts = ["What is OpenVINO?"] * len(generation_configs)
+
+    pipe = ContinuousBatchingPipeline(models_path.absolute().as_posix(), Tokenizer(models_path.absolute().as_posix()), get_scheduler_config(), "CPU",
+                                      {"adapters": AdapterConfig(adapters, AdapterConfig.Mode.MODE_DYNAMIC_PER_TOKEN)})
+    # every request runs alone, so LoRA states hold its adapters only
+    reference_results = [pipe.generate([prompt], [generation_config])[0] for prompt, generation_config in zip(prompts, generation_configs)]
+    # all requests share the same steps, so every token selects alphas of its request config
+    results = pipe.generate(prompts, generation_configs)
+
+    for result, reference_result in zip(results, reference_results):
+        assert result.m_generation_ids == reference_result.m_generation_ids
+    # adapters and alphas change the output, otherwise the test doesn't check anything
+    reference_texts = [reference_result.m_generation_ids[0] for reference_result in reference_results]
+    assert len(set(reference_texts)) == len(reference_texts)
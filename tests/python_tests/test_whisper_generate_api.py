@@ -597,3 +597,28 @@ def test_perf_metrics(model_descr, test_sample):
     mean_dur, std_dur = perf_metrics.get_features_extraction_duration()
     assert np.allclose(mean_dur, np.mean(raw_dur))
     assert np.allclose(std_dur, np.std(raw_dur))
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_batched_generate_matches_per_sample_generate(model_descr):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+    test_samples = [sample.tolist() for sample in get_samples_from_dataset(language="en", length=3)]
+
+    for return_timestamps in [False, True]:
+        batched_results = pipe.generate(test_samples, return_timestamps=return_timestamps)
+        assert len(batched_results) == len(test_samples)
+
+        for test_sample, batched_result in zip(test_samples, batched_results):
+            expected = pipe.generate(test_sample, return_timestamps=return_timestamps)
+
+            assert batched_result.texts == expected.texts
+            if return_timestamps:
+                assert len(batched_result.chunks) == len(expected.chunks)
+                for batched_chunk, expected_chunk in zip(batched_result.chunks, expected.chunks):
+                    assert batched_chunk.text == expected_chunk.text
+                    assert round(batched_chunk.start_ts, 2) == round(expected_chunk.start_ts, 2)
+                    assert round(batched_chunk.end_ts, 2) == round(expected_chunk.end_ts, 2)
+
+            raw_metrics = batched_result.perf_metrics.raw_metrics
+            assert all(batch_size == len(test_samples) for batch_size in raw_metrics.m_batch_sizes)